@@ -0,0 +1,87 @@
+/* kernel/affinity_bench.c
+ * Polling-loop jitter on a shared vs an isolated CPU (build with
+ * -DRUN_AFFINITY_BENCH). A task pinned to CPU 0 spins on rdtsc for one
+ * second and records every gap between consecutive reads longer than
+ * 1 us (preemption, timer interrupts). First three busy housekeeping
+ * tasks share CPU 0 with it, then they are moved to CPU 1 so CPU 0 runs
+ * the poller alone and its slice tick stops. Only the boot CPU is started
+ * for now, so under -smp the moved tasks simply wait for CPU 1.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+#define NOISE_TASKS 3
+
+static volatile int noise_stop = 0;
+static volatile int noise_started = 0;
+static process_t *noise[NOISE_TASKS];
+
+static void noise_task(void) {
+    noise[__atomic_fetch_add(&noise_started, 1, __ATOMIC_SEQ_CST)] = pm_get_current();
+    while (!noise_stop)
+        asm volatile ("pause");
+}
+
+static void poll_once(const char *name) {
+    uint64_t hz = timer_tsc_hz();
+    uint64_t thresh = timer_ns_to_tsc(1000);
+    uint64_t irq0 = timer_irq_count();
+    uint64_t gaps = 0, stolen = 0, max_gap = 0;
+
+    uint64_t t0 = rdtsc(), prev = t0;
+    while (prev - t0 < hz) {
+        uint64_t now = rdtsc();
+        uint64_t d = now - prev;
+        if (d > thresh) {
+            gaps++;
+            stolen += d;
+            if (d > max_gap) max_gap = d;
+        }
+        prev = now;
+    }
+
+    serial_puts("[affinity_bench] ");
+    serial_puts(name);
+    serial_puts(": gaps_over_1us=");
+    serial_put_dec(gaps);
+    serial_puts(" max_gap_ns=");
+    serial_put_dec(timer_tsc_to_ns(max_gap));
+    serial_puts(" stolen_us=");
+    serial_put_dec(timer_tsc_to_ns(stolen) / 1000);
+    serial_puts(" timer_irqs=");
+    serial_put_dec(timer_irq_count() - irq0);
+    serial_putc('\n');
+}
+
+static void affinity_bench_task(void) {
+    process_t *self = pm_get_current();
+    sched_set_affinity(self, 1ULL << 0);
+    while (noise_started < NOISE_TASKS) scheduler_yield();
+
+    poll_once("shared cpu0");
+
+    for (int i = 0; i < NOISE_TASKS; i++)
+        sched_set_affinity(noise[i], 1ULL << 1);
+    scheduler_yield();
+    poll_once("isolated cpu0");
+
+    /* bring the housekeeping tasks back so they can finish */
+    noise_stop = 1;
+    for (int i = 0; i < NOISE_TASKS; i++)
+        sched_set_affinity(noise[i], 1ULL << 0);
+    serial_puts("[affinity_bench] online cpus mask=0x");
+    serial_put_hex(sched_cpus_online());
+    serial_puts(" done\n");
+}
+
+void affinity_bench(void) {
+    serial_puts("[affinity_bench] creating poller + housekeeping tasks\n");
+    task_create(affinity_bench_task);
+    for (int i = 0; i < NOISE_TASKS; i++)
+        task_create(noise_task);
+}
@@ -0,0 +1,85 @@
+/* kernel/arch/x86/cpu.h - small inline helpers for x86-64 CPU instructions */
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdint.h>
+
+/* Read the time-stamp counter (cycles since reset) */
+static inline uint64_t rdtsc(void) {
+    uint32_t lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/* CPUID leaf/subleaf query */
+static inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t *a,
+                         uint32_t *b, uint32_t *c, uint32_t *d) {
+    asm volatile ("cpuid"
+                  : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d)
+                  : "a"(leaf), "c"(subleaf));
+}
+
+/* Model-specific registers */
+static inline uint64_t rdmsr(uint32_t msr) {
+    uint32_t lo, hi;
+    asm volatile ("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline void wrmsr(uint32_t msr, uint64_t val) {
+    asm volatile ("wrmsr" : : "c"(msr), "a"((uint32_t)val), "d"((uint32_t)(val >> 32)));
+}
+
+/* Control registers */
+static inline uint64_t read_cr0(void) {
+    uint64_t v;
+    asm volatile ("mov %%cr0, %0" : "=r"(v));
+    return v;
+}
+
+static inline void write_cr0(uint64_t v) {
+    asm volatile ("mov %0, %%cr0" : : "r"(v) : "memory");
+}
+
+static inline uint64_t read_cr3(void) {
+    uint64_t v;
+    asm volatile ("mov %%cr3, %0" : "=r"(v));
+    return v;
+}
+
+/* Drop the TLB entry for one page */
+static inline void invlpg(uint64_t vaddr) {
+    asm volatile ("invlpg (%0)" : : "r"(vaddr) : "memory");
+}
+
+static inline uint64_t read_cr4(void) {
+    uint64_t v;
+    asm volatile ("mov %%cr4, %0" : "=r"(v));
+    return v;
+}
+
+static inline void write_cr4(uint64_t v) {
+    asm volatile ("mov %0, %%cr4" : : "r"(v) : "memory");
+}
+
+/* Save RFLAGS and disable interrupts; restore with irq_restore().
+   Host tests run in ring 3 where cli/sti would fault, so they are no-ops. */
+static inline uint64_t irq_save(void) {
+#ifdef HOST_TEST
+    return 0;
+#else
+    uint64_t flags;
+    asm volatile ("pushfq; popq %0; cli" : "=r"(flags) : : "memory");
+    return flags;
+#endif
+}
+
+static inline void irq_restore(uint64_t flags) {
+#ifdef HOST_TEST
+    (void)flags;
+#else
+    if (flags & 0x200) asm volatile ("sti" ::: "memory");
+#endif
+}
+
+#endif
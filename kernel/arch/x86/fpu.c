@@ -0,0 +1,257 @@
+/* kernel/arch/x86/fpu.c - lazy FPU/SSE/AVX context switching
+ *
+ * Vector registers are switched lazily: the scheduler only sets CR0.TS
+ * when the next task is not the one whose state is live in the registers
+ * (fpu_owner). The first FPU/SSE/AVX instruction of any other task raises
+ * #NM; only then is the owner's state saved and the new task's restored.
+ * Tasks that never touch vector registers never get a save area and pay
+ * nothing beyond the CR0 write.
+ */
+#include "fpu.h"
+#include "cpu.h"
+#include "../../drivers/serial.h"
+#include "../../mm/slab.h"
+
+#define CR0_MP   (1ULL << 1)
+#define CR0_EM   (1ULL << 2)
+#define CR0_TS   (1ULL << 3)
+#define CR0_NE   (1ULL << 5)
+#define CR4_OSFXSR     (1ULL << 9)
+#define CR4_OSXMMEXCPT (1ULL << 10)
+#define CR4_OSXSAVE    (1ULL << 18)
+
+/* XCR0 components we enable when present: x87, SSE, AVX, AVX-512 */
+#define XFEATURE_MASK  ((1ULL << 0) | (1ULL << 1) | (1ULL << 2) | \
+                        (1ULL << 5) | (1ULL << 6) | (1ULL << 7))
+#define IA32_XSS 0xDA0
+
+#define FXSAVE_SIZE 512
+#define MXCSR_DEFAULT 0x1F80
+#define FCW_DEFAULT   0x037F
+
+static int save_method = FPU_SAVE_FXSAVE;
+static uint64_t xfeatures = 0;
+static uint32_t state_size = FXSAVE_SIZE;
+static process_t *fpu_owner = NULL;
+static int ts_set = 0;
+static uint64_t traps = 0;
+static int kernel_busy = 0;
+/* Save areas; the object size is fixed by fpu_init before first use */
+static kmem_cache_t fpu_cache = KMEM_CACHE_INIT("fpu", FXSAVE_SIZE, 64);
+
+uint32_t fpu_state_size(void) { return state_size; }
+int fpu_save_method(void) { return save_method; }
+uint64_t fpu_trap_count(void) { return traps; }
+uint64_t fpu_xfeatures(void) { return xfeatures; }
+int fpu_kernel_busy(void) { return kernel_busy; }
+
+static inline void xsetbv(uint32_t reg, uint64_t val) {
+    asm volatile ("xsetbv" : : "c"(reg), "a"((uint32_t)val), "d"((uint32_t)(val >> 32)));
+}
+
+static inline void clts(void) {
+    asm volatile ("clts" ::: "memory");
+    ts_set = 0;
+}
+
+static inline void stts(void) {
+    if (!ts_set) {
+        write_cr0(read_cr0() | CR0_TS);
+        ts_set = 1;
+    }
+}
+
+static void fpu_save(void *area) {
+    uint32_t lo = (uint32_t)xfeatures, hi = (uint32_t)(xfeatures >> 32);
+    switch (save_method) {
+        case FPU_SAVE_XSAVES:
+            asm volatile ("xsaves64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory");
+            break;
+        case FPU_SAVE_XSAVEOPT:
+            asm volatile ("xsaveopt64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory");
+            break;
+        case FPU_SAVE_XSAVE:
+            asm volatile ("xsave64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory");
+            break;
+        default:
+            asm volatile ("fxsave64 (%0)" : : "r"(area) : "memory");
+            break;
+    }
+}
+
+static void fpu_restore(void *area) {
+    uint32_t lo = (uint32_t)xfeatures, hi = (uint32_t)(xfeatures >> 32);
+    switch (save_method) {
+        case FPU_SAVE_XSAVES:
+            asm volatile ("xrstors64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory");
+            break;
+        case FPU_SAVE_XSAVEOPT:
+        case FPU_SAVE_XSAVE:
+            asm volatile ("xrstor64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory");
+            break;
+        default:
+            asm volatile ("fxrstor64 (%0)" : : "r"(area) : "memory");
+            break;
+    }
+}
+
+/* Allocate a 64-byte aligned save area holding the architectural init
+   state (so a new task never sees another task's registers). */
+static void *fpu_alloc_state(void) {
+    uint8_t *area = (uint8_t *)kmem_cache_zalloc(&fpu_cache);
+    if (!area) return NULL;
+
+    *(uint16_t *)(area + 0) = FCW_DEFAULT;
+    *(uint32_t *)(area + 24) = MXCSR_DEFAULT;
+    if (save_method == FPU_SAVE_XSAVES) {
+        /* compacted format: XSTATE_BV = 0 (init), XCOMP_BV = bit 63 | features */
+        *(uint64_t *)(area + 512 + 8) = (1ULL << 63) | xfeatures;
+    }
+    return area;
+}
+
+void fpu_init(void) {
+    uint32_t a, b, c, d;
+    cpuid(1, 0, &a, &b, &c, &d);
+    int has_fxsr = (d >> 24) & 1;
+    int has_xsave = (c >> 26) & 1;
+
+    uint64_t cr0 = read_cr0();
+    cr0 &= ~CR0_EM;
+    cr0 |= CR0_MP | CR0_NE;
+    write_cr0(cr0);
+
+    uint64_t cr4 = read_cr4();
+    if (has_fxsr) cr4 |= CR4_OSFXSR | CR4_OSXMMEXCPT;
+    if (has_xsave) cr4 |= CR4_OSXSAVE;
+    write_cr4(cr4);
+
+    if (has_xsave) {
+        cpuid(0xD, 0, &a, &b, &c, &d);
+        xfeatures = (((uint64_t)d << 32) | a) & XFEATURE_MASK;
+        xsetbv(0, xfeatures);
+
+        /* EBX now reports the standard-format size for the enabled XCR0 */
+        cpuid(0xD, 0, &a, &b, &c, &d);
+        state_size = b;
+        save_method = FPU_SAVE_XSAVE;
+
+        cpuid(0xD, 1, &a, &b, &c, &d);
+        if (a & (1 << 3)) {
+            /* XSAVES: compacted format + init/modified optimizations. We
+               manage no supervisor components, so IA32_XSS stays 0. */
+            wrmsr(IA32_XSS, 0);
+            cpuid(0xD, 1, &a, &b, &c, &d);
+            state_size = b;
+            save_method = FPU_SAVE_XSAVES;
+        } else if (a & (1 << 0)) {
+            save_method = FPU_SAVE_XSAVEOPT;
+        }
+    }
+
+    fpu_cache.obj_size = state_size;
+    asm volatile ("fninit");
+
+    /* Nobody owns the registers yet: trap the first use */
+    ts_set = 0;
+    stts();
+
+    static const char *names[] = { "fxsave", "xsave", "xsaveopt", "xsaves" };
+    serial_puts("[fpu] lazy switching via CR0.TS, ");
+    serial_puts(names[save_method]);
+    serial_puts(" area=");
+    serial_put_dec(state_size);
+    serial_puts(" bytes xcr0=0x");
+    serial_put_hex(xfeatures);
+    serial_putc('\n');
+}
+
+void fpu_switch(process_t *next) {
+    if (next && next == fpu_owner)
+        clts();     /* its registers are still live: no trap needed */
+    else
+        stts();
+}
+
+void fpu_trap(void) {
+    extern process_t *pm_get_current(void);
+    extern void scheduler_yield(void);
+    process_t *cur = pm_get_current();
+
+    clts();
+    traps++;
+
+    if (!cur) {
+        /* FPU use outside any task (the kernel is built with
+           -mgeneral-regs-only, so this should not happen) */
+        serial_puts("[fpu] #NM outside task context\n");
+        return;
+    }
+    if (fpu_owner == cur) return;
+
+    if (fpu_owner && fpu_owner->fpu_state)
+        fpu_save(fpu_owner->fpu_state);
+
+    if (!cur->fpu_state) {
+        cur->fpu_state = fpu_alloc_state();
+        if (!cur->fpu_state) {
+            /* The owner's registers are saved but still live: trap again
+               before anyone reads them, and never resume this task */
+            serial_puts("[fpu] cannot allocate state -> killing\n");
+            fpu_owner = NULL;
+            stts();
+            cur->state = 3;
+            for (;;) scheduler_yield();
+        }
+        clts();     /* zeroing the area may have used fpu_kernel_begin/end */
+    }
+    fpu_restore(cur->fpu_state);
+    fpu_owner = cur;
+}
+
+uint64_t fpu_kernel_begin(void) {
+    uint64_t flags = irq_save();
+    clts();
+    if (fpu_owner && fpu_owner->fpu_state)
+        fpu_save(fpu_owner->fpu_state);
+    fpu_owner = NULL;
+    kernel_busy = 1;
+    return flags;
+}
+
+void fpu_kernel_end(uint64_t flags) {
+    /* the registers hold kernel data now: every task traps on next use */
+    kernel_busy = 0;
+    stts();
+    irq_restore(flags);
+}
+
+void fpu_fork(process_t *child, process_t *parent) {
+    child->fpu_state = NULL;
+    if (!parent || !parent->fpu_state) return;
+
+    uint64_t flags = irq_save();
+    if (fpu_owner == parent) {
+        /* live registers are newer than the parent's area */
+        int was_set = ts_set;
+        clts();
+        fpu_save(parent->fpu_state);
+        if (was_set) stts();
+    }
+    child->fpu_state = fpu_alloc_state();
+    if (child->fpu_state) {
+        uint8_t *dst = (uint8_t *)child->fpu_state;
+        const uint8_t *src = (const uint8_t *)parent->fpu_state;
+        for (uint32_t i = 0; i < state_size; i++) dst[i] = src[i];
+    }
+    irq_restore(flags);
+}
+
+void fpu_release(process_t *p) {
+    if (!p) return;
+    if (fpu_owner == p) fpu_owner = NULL;
+    if (p->fpu_state) {
+        kmem_cache_free(&fpu_cache, p->fpu_state);
+        p->fpu_state = NULL;
+    }
+}
@@ -0,0 +1,51 @@
+/* kernel/arch/x86/fpu.h - lazy FPU/SSE/AVX context switching */
+#ifndef FPU_H
+#define FPU_H
+
+#include <stdint.h>
+#include "../../elf_loader.h"
+
+/* Save/restore instruction chosen at boot */
+#define FPU_SAVE_FXSAVE    0
+#define FPU_SAVE_XSAVE     1
+#define FPU_SAVE_XSAVEOPT  2
+#define FPU_SAVE_XSAVES    3
+
+/* Enable x87/SSE (and XSAVE/AVX/AVX-512 state if present), size the
+   per-task save area and arm CR0.TS so the first FPU use traps. */
+void fpu_init(void);
+
+/* Scheduler hook: called when `next` is about to run (NULL = idle).
+   Leaves the registers alone and only toggles CR0.TS. */
+void fpu_switch(process_t *next);
+
+/* #NM (device-not-available) handler body: save the previous owner's
+   state, allocate/restore the current task's XSAVE area. */
+void fpu_trap(void);
+
+/* Give a forked/cloned task its own copy of the parent's FPU state */
+void fpu_fork(process_t *child, process_t *parent);
+
+/* Drop a dead task's state and return its save area to the cache */
+void fpu_release(process_t *p);
+
+/* Let kernel code (libc.c's vector memcpy/memset) use the vector
+   registers: saves the live owner's state, so its next use traps and
+   restores it, and keeps interrupts off until fpu_kernel_end. Kernel
+   code is built with -mgeneral-regs-only; only inline asm may touch the
+   registers in between. Returns the flags for fpu_kernel_end. */
+uint64_t fpu_kernel_begin(void);
+void fpu_kernel_end(uint64_t flags);
+
+/* Nonzero between fpu_kernel_begin and fpu_kernel_end. Sections do not
+   nest: an exception handler that finds one open (a page fault taken
+   inside a vector copy) must stay on general registers. */
+int fpu_kernel_busy(void);
+
+/* Introspection for benchmarks */
+uint32_t fpu_state_size(void);
+int fpu_save_method(void);
+uint64_t fpu_trap_count(void);
+uint64_t fpu_xfeatures(void);    /* XCR0 value, 0 without XSAVE */
+
+#endif
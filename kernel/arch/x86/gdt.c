@@ -44,6 +44,14 @@ struct tss_entry {
     uint16_t iomap_base;
 } __attribute__((packed));
 
+static struct tss_entry tss = {0};
+
+/* Kernel stack the CPU switches to on an interrupt/exception from ring 3.
+   The scheduler points it at the running user task's own kernel stack. */
+void tss_set_rsp0(uint64_t rsp0) {
+    tss.rsp0 = rsp0;
+}
+
 static void gdt_set_gate(int num, uint64_t base, uint32_t limit, uint8_t access, uint8_t gran) {
     gdt[num].base_low = (base & 0xFFFF);
     gdt[num].base_middle = (base >> 16) & 0xFF;
@@ -63,12 +71,13 @@ void gdt_install(void) {
     gdt_set_gate(0, 0, 0, 0, 0);                /* Null segment */
     gdt_set_gate(1, 0, 0xFFFFFFFF, 0x9A, 0xAF); /* Kernel code segment */
     gdt_set_gate(2, 0, 0xFFFFFFFF, 0x92, 0xAF); /* Kernel data segment */
-    /* User segments (DPL=3) */
-    gdt_set_gate(3, 0, 0xFFFFFFFF, 0xFA, 0xAF); /* User code (RPL=3) */
-    gdt_set_gate(4, 0, 0xFFFFFFFF, 0xF2, 0xAF); /* User data (RPL=3) */
+    /* User segments (DPL=3). SYSRET loads SS from STAR[63:48] + 8 and CS
+       from STAR[63:48] + 16, so user data must sit directly below user
+       code: selectors 0x1B (data) and 0x23 (code). */
+    gdt_set_gate(3, 0, 0xFFFFFFFF, 0xF2, 0xAF); /* User data (RPL=3) */
+    gdt_set_gate(4, 0, 0xFFFFFFFF, 0xFA, 0xAF); /* User code (RPL=3) */
 
     /* Prepare a minimal TSS and install its descriptor in GDT (entries 5 & 6) */
-    static struct tss_entry tss = {0};
     /* Small kernel interrupt stack for privilege transitions (RSP0) */
     static uint8_t kernel_stack[8192];
     uint64_t tss_base = (uint64_t)&tss;
@@ -60,6 +60,18 @@ void idt_install(void) {
     extern void isr_0x20(void);
     idt_set_gate(0x20, (uint64_t)isr_0x20, 0x08, 0x8E, 0);
 
+    /* LAPIC spurious-interrupt vector (see arch/x86/lapic.h) */
+    extern void isr_spurious(void);
+    idt_set_gate(0xFF, (uint64_t)isr_spurious, 0x08, 0x8E, 0);
+
+    /* Register scheduler yield vector (kernel-only, DPL=0) */
+    extern void isr_0x81(void);
+    idt_set_gate(0x81, (uint64_t)isr_0x81, 0x08, 0x8E, 0);
+
+    /* Device-not-available (#NM): lazy FPU switch (see arch/x86/fpu.c) */
+    extern void isr_0x07(void);
+    idt_set_gate(0x07, (uint64_t)isr_0x07, 0x08, 0x8E, 0);
+
     /* Register page fault handler (vector 0x0E) */
     extern void isr_0x0e(void);
     idt_set_gate(0x0e, (uint64_t)isr_0x0e, 0x08, 0x8E, 0);
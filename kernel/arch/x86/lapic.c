@@ -0,0 +1,55 @@
+/* kernel/arch/x86/lapic.c - minimal local APIC driver (xAPIC MMIO mode) */
+#include "lapic.h"
+#include "cpu.h"
+#include "../../drivers/serial.h"
+
+#define IA32_APIC_BASE_MSR  0x1B
+#define APIC_BASE_ENABLE    (1ULL << 11)
+
+static volatile uint32_t *lapic_base = 0;
+
+uint32_t lapic_read(uint32_t reg) {
+    return lapic_base[reg / 4];
+}
+
+void lapic_write(uint32_t reg, uint32_t val) {
+    lapic_base[reg / 4] = val;
+    (void)lapic_base[LAPIC_ID / 4]; /* serialize posted write */
+}
+
+void lapic_eoi(void) {
+    lapic_base[LAPIC_EOI / 4] = 0;
+}
+
+int lapic_present(void) {
+    return lapic_base != 0;
+}
+
+int lapic_init(void) {
+    uint32_t a, b, c, d;
+    cpuid(1, 0, &a, &b, &c, &d);
+    if (!(d & (1 << 9))) {
+        serial_puts("[lapic] not present\n");
+        return -1;
+    }
+
+    uint64_t base = rdmsr(IA32_APIC_BASE_MSR);
+    uint64_t phys = base & 0xFFFFFF000ULL;
+
+    extern int paging_map_mmio(uint64_t phys);
+    if (paging_map_mmio(phys) != 0) {
+        serial_puts("[lapic] cannot map MMIO\n");
+        return -1;
+    }
+    wrmsr(IA32_APIC_BASE_MSR, base | APIC_BASE_ENABLE);
+    lapic_base = (volatile uint32_t *)(uintptr_t)phys;
+
+    /* Software-enable the APIC with the spurious vector, timer masked */
+    lapic_write(LAPIC_SVR, 0x100 | LAPIC_SPURIOUS_VECTOR);
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED);
+
+    serial_puts("[lapic] enabled at 0x");
+    serial_put_hex(phys);
+    serial_putc('\n');
+    return 0;
+}
@@ -0,0 +1,32 @@
+/* kernel/arch/x86/lapic.h - local APIC access (timer, EOI) */
+#ifndef LAPIC_H
+#define LAPIC_H
+
+#include <stdint.h>
+
+/* Local APIC register offsets */
+#define LAPIC_ID          0x020
+#define LAPIC_EOI         0x0B0
+#define LAPIC_SVR         0x0F0
+#define LAPIC_LVT_TIMER   0x320
+#define LAPIC_TIMER_INIT  0x380
+#define LAPIC_TIMER_CUR   0x390
+#define LAPIC_TIMER_DIV   0x3E0
+
+/* LVT timer modes */
+#define LAPIC_TIMER_ONESHOT   (0x0 << 17)
+#define LAPIC_TIMER_PERIODIC  (0x1 << 17)
+#define LAPIC_TIMER_TSC_DL    (0x2 << 17)
+#define LAPIC_LVT_MASKED      (1 << 16)
+
+#define LAPIC_SPURIOUS_VECTOR 0xFF
+
+/* Detect, map and software-enable the local APIC. Returns 0 if usable. */
+int lapic_init(void);
+int lapic_present(void);
+
+uint32_t lapic_read(uint32_t reg);
+void lapic_write(uint32_t reg, uint32_t val);
+void lapic_eoi(void);
+
+#endif
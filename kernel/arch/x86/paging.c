@@ -21,3 +21,32 @@ void paging_enable(void) {
     );
 }
 
+/* Identity-map the 2MB page containing an MMIO physical address (LAPIC,
+   IOAPIC, HPET live above the 1GB that start.S maps). The mapping is
+   uncached and lands in the shared PDPT, so every PML4 cloned from the
+   kernel one sees it too. Returns 0 on success, -1 if out of PD pages. */
+#define MMIO_PD_POOL 4
+static uint64_t mmio_pd[MMIO_PD_POOL][512] PAGE_ALIGN;
+static int mmio_pd_used = 0;
+
+int paging_map_mmio(uint64_t phys) {
+    extern uint64_t pml4[];
+    uint64_t *pdpt = (uint64_t *)(pml4[0] & ~0xFFFULL);
+    uint64_t pdpt_idx = (phys >> 30) & 0x1FF;
+    uint64_t pd_idx = (phys >> 21) & 0x1FF;
+
+    if (phys >> 39) return -1; /* only PML4[0] is populated */
+
+    if (!(pdpt[pdpt_idx] & 1)) {
+        if (mmio_pd_used >= MMIO_PD_POOL) return -1;
+        uint64_t *pd = mmio_pd[mmio_pd_used++];
+        pdpt[pdpt_idx] = (uint64_t)pd | 0x003; /* present + writeable */
+    }
+    if (pdpt[pdpt_idx] & (1ULL << 7)) return 0; /* already a 1GB page */
+
+    uint64_t *pd = (uint64_t *)(pdpt[pdpt_idx] & ~0xFFFULL);
+    /* present + writeable + PWT + PCD + large page */
+    pd[pd_idx] = (phys & ~0x1FFFFFULL) | 0x09B;
+    asm volatile ("invlpg (%0)" : : "r"(phys) : "memory");
+    return 0;
+}
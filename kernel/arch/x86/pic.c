@@ -47,6 +47,17 @@ void pic_set_mask(uint8_t mask) {
     outb(PIC1_DATA, mask);
 }
 
+/* Mask/unmask a single master-PIC line, keeping the others as they are */
+void pic_mask_irq(int irq) {
+    if (irq < 0 || irq >= 8) return;
+    outb(PIC1_DATA, inb(PIC1_DATA) | (uint8_t)(1 << irq));
+}
+
+void pic_unmask_irq(int irq) {
+    if (irq < 0 || irq >= 8) return;
+    outb(PIC1_DATA, inb(PIC1_DATA) & (uint8_t)~(1 << irq));
+}
+
 void pic_send_eoi(int irq) {
     if (irq >= 8) {
         outb(PIC2_CMD, 0x20);
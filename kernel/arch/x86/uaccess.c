@@ -0,0 +1,152 @@
+/* kernel/arch/x86/uaccess.c - user copies with exception-table recovery */
+#include "uaccess.h"
+#include "cpu.h"
+#include "../../drivers/serial.h"
+#include "../../mm/pagetable.h"
+
+#define CR4_SMAP (1ULL << 21)
+
+static int smap, erms, fsrm;
+
+int uaccess_has_smap(void) { return smap; }
+int uaccess_has_erms(void) { return erms; }
+int uaccess_has_fsrm(void) { return fsrm; }
+
+void uaccess_init(void) {
+    uint32_t a, b, c, d;
+    cpuid(0, 0, &a, &b, &c, &d);
+    if (a >= 7) {
+        cpuid(7, 0, &a, &b, &c, &d);
+        smap = (b >> 20) & 1;
+        erms = (b >> 9) & 1;
+        fsrm = (d >> 4) & 1;
+    }
+#ifndef HOST_TEST
+    /* Kernel accesses to user pages outside the STAC/CLAC windows below
+       now fault. The kernel reaches its own data through the
+       supervisor-only identity map, and user frames through their
+       physical addresses (uring rings, COW copies). */
+    if (smap) write_cr4(read_cr4() | CR4_SMAP);
+#endif
+    serial_puts("[uaccess] copy=");
+    serial_puts(erms || fsrm ? "rep movsb" : "rep movsq");
+    serial_puts(fsrm ? " (fsrm)" : erms ? " (erms)" : "");
+    serial_puts(smap ? " stac/clac" : "");
+    serial_putc('\n');
+}
+
+#ifndef HOST_TEST
+/* Bytes at a (up to n) that ring 3 may touch in the loaded address space */
+static uint64_t user_bytes(uint64_t a, uint64_t n) {
+    uint64_t cr3;
+    asm volatile ("mov %%cr3, %0" : "=r"(cr3));
+    return pt_user_bytes((void *)(cr3 & ~0xFFFULL), a, n);
+}
+
+int uaccess_mapped(uint64_t a, uint64_t n) { return user_bytes(a, n) == n; }
+#endif
+
+uint64_t extable_search(uint64_t rip) {
+#ifdef HOST_TEST
+    extern const extable_entry_t __start___ex_table[], __stop___ex_table[];
+#define EXTABLE_START __start___ex_table
+#define EXTABLE_END   __stop___ex_table
+#else
+    extern const extable_entry_t __ex_table_start[], __ex_table_end[];   /* linker.ld */
+#define EXTABLE_START __ex_table_start
+#define EXTABLE_END   __ex_table_end
+#endif
+    for (const extable_entry_t *e = EXTABLE_START; e < EXTABLE_END; e++) {
+        if ((uint64_t)&e->insn + (int64_t)e->insn == rip)
+            return (uint64_t)&e->fixup + (int64_t)e->fixup;
+    }
+    return 0;
+}
+
+/* STAC/CLAC by opcode; they #UD without SMAP, hence the flag */
+static inline void stac(void) {
+    if (smap) asm volatile (".byte 0x0f, 0x01, 0xcb" ::: "memory");
+}
+
+static inline void clac(void) {
+    if (smap) asm volatile (".byte 0x0f, 0x01, 0xca" ::: "memory");
+}
+
+/* Returns bytes left uncopied. RCX holds the remaining count when a
+   string instruction faults, and the fault handler resumes at the fixup
+   with every register as it was at the fault. A qword that straddles
+   the faulting page is redone byte by byte, so the count is exact. */
+static uint64_t uaccess_copy(void *dst, const void *src, uint64_t n) {
+    stac();
+    if (erms || fsrm) {
+        asm volatile ("1: rep movsb\n"
+                      "2:\n"
+                      EXTABLE_ENTRY(1b, 2b)
+                      : "+D"(dst), "+S"(src), "+c"(n) : : "memory");
+    } else {
+        uint64_t tail = n & 7;
+        n >>= 3;
+        asm volatile ("1: rep movsq\n"
+                      "   mov %[tail], %%rcx\n"
+                      "2: rep movsb\n"
+                      "   jmp 3f\n"
+                      "4: lea (%[tail], %%rcx, 8), %%rcx\n"
+                      "5: rep movsb\n"
+                      "3:\n"
+                      EXTABLE_ENTRY(1b, 4b)
+                      EXTABLE_ENTRY(2b, 3b)
+                      EXTABLE_ENTRY(5b, 3b)
+                      : "+D"(dst), "+S"(src), "+c"(n) : [tail] "r"(tail) : "memory");
+    }
+    clac();
+    return n;
+}
+
+uint64_t copy_from_user(void *dst, const void *usrc, uint64_t n) {
+    if (!access_ok(usrc, n)) return n;
+    return uaccess_copy(dst, usrc, n);
+}
+
+uint64_t copy_to_user(void *udst, const void *src, uint64_t n) {
+    if (!access_ok(udst, n)) return n;
+    return uaccess_copy(udst, src, n);
+}
+
+int64_t strncpy_from_user(char *dst, const char *usrc, int64_t n) {
+    if (n <= 0) return 0;
+    uint64_t a = (uint64_t)usrc;
+    if (a < USER_ADDR_MIN || a >= USER_ADDR_MAX) return -1;
+    /* the string may end before the range does: clamp, don't reject */
+    if ((uint64_t)n > USER_ADDR_MAX - a) n = (int64_t)(USER_ADDR_MAX - a);
+    int cut = 0;
+#ifndef HOST_TEST
+    /* the same for the user pages there: a kernel page would not fault */
+    uint64_t reach = user_bytes(a, (uint64_t)n);
+    if (!reach) return -1;
+    if (reach < (uint64_t)n) {
+        n = (int64_t)reach;
+        cut = 1;
+    }
+#endif
+
+    int64_t len;
+    stac();
+    asm volatile ("   xor %[len], %[len]\n"
+                  "1: cmp %[n], %[len]\n"
+                  "   jae 3f\n"
+                  "2: movb (%[src], %[len]), %%al\n"
+                  "   movb %%al, (%[dst], %[len])\n"
+                  "   test %%al, %%al\n"
+                  "   jz 3f\n"
+                  "   inc %[len]\n"
+                  "   jmp 1b\n"
+                  "4: mov $-1, %[len]\n"
+                  "3:\n"
+                  EXTABLE_ENTRY(2b, 4b)
+                  : [len] "=&r"(len)
+                  : [src] "r"(usrc), [dst] "r"(dst), [n] "r"(n)
+                  : "rax", "memory", "cc");
+    clac();
+    if (cut && len == n) return -1;   /* ran into a page user space cannot touch */
+    return len;
+}
@@ -0,0 +1,75 @@
+/* kernel/arch/x86/uaccess.h - checked access to user memory
+ *
+ * Syscalls must not dereference user pointers directly: the pointer may be
+ * unmapped, non-canonical or point at memory the caller may not touch.
+ * These primitives check the range and that the loaded page table gives
+ * ring 3 every page of it (a kernel page would not fault: the kernel may
+ * read it), bracket the access with STAC/CLAC when the CPU has SMAP
+ * (which uaccess_init enables), and copy with string instructions whose faults
+ * are recovered through the exception table: a #PF at a listed
+ * instruction resumes at its fixup instead of killing the task, and the
+ * copy reports how far it got.
+ */
+#ifndef UACCESS_H
+#define UACCESS_H
+
+#include <stdint.h>
+
+/* User pointers live in the canonical lower half above the null page */
+#define USER_ADDR_MIN  0x1000ULL
+#define USER_ADDR_MAX  0x0000800000000000ULL
+
+/* Exception table entry: both fields are offsets from the field itself,
+   so the table needs no relocations */
+typedef struct extable_entry {
+    int32_t insn;
+    int32_t fixup;
+} extable_entry_t;
+
+/* Record "a fault at label `insn` resumes at label `fixup`" */
+#define EXTABLE_ENTRY(insn, fixup)            \
+    ".pushsection __ex_table, \"a\"\n"        \
+    ".balign 4\n"                             \
+    ".long (" #insn ") - .\n"                 \
+    ".long (" #fixup ") - .\n"                \
+    ".popsection\n"
+
+/* Detect SMAP (STAC/CLAC) and ERMS/FSRM (fast rep movsb) */
+void uaccess_init(void);
+
+/* Fixup address for a faulting kernel RIP, 0 if it has none */
+uint64_t extable_search(uint64_t rip);
+
+/* The range lies in the user half; nothing is said about what backs it */
+static inline int user_range_ok(const void *addr, uint64_t n) {
+    uint64_t a = (uint64_t)addr;
+    return a >= USER_ADDR_MIN && a + n >= a && a + n <= USER_ADDR_MAX;
+}
+
+#ifdef HOST_TEST
+/* host tests have no page tables to walk */
+static inline int uaccess_mapped(uint64_t a, uint64_t n) { (void)a; (void)n; return 1; }
+#else
+/* Every page of [a, a+n) is present with U set in the loaded address space */
+int uaccess_mapped(uint64_t a, uint64_t n);
+#endif
+
+static inline int access_ok(const void *addr, uint64_t n) {
+    return user_range_ok(addr, n) && uaccess_mapped((uint64_t)addr, n);
+}
+
+/* Both return the number of bytes NOT copied (0 on success) */
+uint64_t copy_from_user(void *dst, const void *usrc, uint64_t n);
+uint64_t copy_to_user(void *udst, const void *src, uint64_t n);
+
+/* Copy a NUL-terminated user string of at most n bytes. Returns its
+   length without the NUL, n if no NUL was found in the first n bytes
+   (dst is then not terminated), or -1 on a bad address. */
+int64_t strncpy_from_user(char *dst, const char *usrc, int64_t n);
+
+/* What uaccess_init found, for benchmarks */
+int uaccess_has_smap(void);
+int uaccess_has_erms(void);
+int uaccess_has_fsrm(void);
+
+#endif /* UACCESS_H */
@@ -0,0 +1,167 @@
+/* kernel/cow_bench.c
+ * Copy-on-write fault throughput (build with -DRUN_COW_BENCH). The task
+ * maps PAGES shared frames (refcount 2) read-only into its own PML4,
+ * turns on CR0.WP so kernel writes honour the read-only bit, and writes
+ * one word per page: each write is a COW fault resolved by
+ * page_fault_handler through copy_page. Runs once per copy_page method;
+ * "memcpy" is the generic path the handler used before. A second pass
+ * reads every copied page back, which is where cache-bypassing copies
+ * pay. Then times clear_page per method the same way.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "mm/page.h"
+#include "mm/pagetable.h"
+#include "mm/physical_memory.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+extern void *kmalloc(unsigned int size);
+
+#define PAGES    1024                        /* 4 MiB per run */
+#define COW_BASE 0x0000008000000000ULL       /* PML4 slot 1: unused by the kernel */
+#define CR0_WP   (1ULL << 16)
+
+static uint32_t src[PAGES];
+
+static uint64_t page_word(uint32_t page, uint32_t i) {
+    return ((uint64_t)page << 32) | (i * 0x9E3779B9u);
+}
+
+/* map every page read-only onto its shared source frame */
+static int map_shared(void *pml4) {
+    for (uint32_t p = 0; p < PAGES; p++) {
+        if (pt_map_page(pml4, COW_BASE + (uint64_t)p * PAGE_SIZE, src[p], 0x1) < 0)
+            return -1;
+        frame_incref(src[p]);    /* the "other process" keeps its reference */
+    }
+    pt_set_cr3(pml4);            /* drop the writable entries of the last run */
+    return 0;
+}
+
+/* after a run: check the private copies, free them and put the source
+   frames' refcount back to 1 */
+static int unmap_private(void *pml4) {
+    int ok = 1;
+    for (uint32_t p = 0; p < PAGES; p++) {
+        uint64_t va = COW_BASE + (uint64_t)p * PAGE_SIZE;
+        uint64_t *w = (uint64_t *)va;
+        if (w[0] != ~0ULL) ok = 0;
+        for (uint32_t i = 1; i < PAGE_SIZE / 8; i++)
+            if (w[i] != page_word(p, i)) { ok = 0; break; }
+        uint64_t phys = pt_virt_to_phys(pml4, va);
+        if (phys == src[p]) {
+            ok = 0;              /* never copied */
+            frame_decref(src[p]);
+        } else {
+            frame_decref((uint32_t)phys);
+        }
+    }
+    return ok;
+}
+
+static void report(const char *what, const char *name, uint64_t cycles, uint64_t touch, int ok) {
+    uint64_t ns = timer_tsc_to_ns(cycles);
+    serial_puts("[cow_bench] ");
+    serial_puts(what);
+    serial_puts(" method=");
+    serial_puts(name);
+    serial_puts(" pages=");
+    serial_put_dec(PAGES);
+    serial_puts(" cycles_per_page=");
+    serial_put_dec(cycles / PAGES);
+    serial_puts(" pages_per_s=");
+    serial_put_dec(ns ? (uint64_t)PAGES * 1000000000ULL / ns : 0);
+    serial_puts(" read_back_cycles_per_page=");
+    serial_put_dec(touch / PAGES);
+    serial_puts(ok ? "\n" : " MISMATCH\n");
+}
+
+static uint64_t read_back(void) {
+    uint64_t t0 = rdtsc(), sum = 0;
+    for (uint32_t p = 0; p < PAGES; p++) {
+        const uint64_t *w = (const uint64_t *)(COW_BASE + (uint64_t)p * PAGE_SIZE);
+        for (uint32_t i = 0; i < PAGE_SIZE / 8; i++) sum += w[i];
+    }
+    asm volatile ("" : : "r"(sum));
+    return rdtsc() - t0;
+}
+
+static void cow_bench_task(void) {
+    /* private PML4 (page aligned for CR3) sharing the kernel's tables */
+    uint64_t raw = (uint64_t)kmalloc(2 * PAGE_SIZE);
+    if (!raw) {
+        serial_puts("[cow_bench] out of kernel heap\n");
+        return;
+    }
+    void *pml4 = (void *)((raw + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1));
+    copy_page(pml4, pt_get_kernel_pml4());
+
+    for (uint32_t p = 0; p < PAGES; p++) {
+        src[p] = alloc_frame();
+        if (!src[p]) {
+            serial_puts("[cow_bench] out of frames\n");
+            return;
+        }
+        uint64_t *w = (uint64_t *)(uint64_t)src[p];
+        for (uint32_t i = 0; i < PAGE_SIZE / 8; i++) w[i] = page_word(p, i);
+    }
+
+    process_t *cur = pm_get_current();
+    uint64_t *kernel_pt = cur->page_table;
+    cur->page_table = (uint64_t *)pml4;
+    uint64_t cr0 = read_cr0();
+    write_cr0(cr0 | CR0_WP);
+
+    int copy0 = page_copy_method(), clear0 = page_clear_method();
+    serial_puts("[cow_bench] boot choice copy=");
+    serial_puts(page_copy_name(copy0));
+    serial_puts(" clear=");
+    serial_puts(page_clear_name(clear0));
+    serial_putc('\n');
+
+    for (int m = 0; m < PAGE_COPY_METHODS; m++) {
+        if (page_ops_set(m, clear0) < 0) continue;
+        if (map_shared(pml4) < 0) {
+            serial_puts("[cow_bench] cannot map pages\n");
+            break;
+        }
+        uint64_t t0 = rdtsc();
+        for (uint32_t p = 0; p < PAGES; p++)
+            *(volatile uint64_t *)(COW_BASE + (uint64_t)p * PAGE_SIZE) = ~0ULL;
+        uint64_t cycles = rdtsc() - t0;
+        uint64_t touch = read_back();
+        report("cow_fault", page_copy_name(m), cycles, touch, unmap_private(pml4));
+    }
+
+    /* clear_page on the (now unshared) source frames, through their
+       identity mapping */
+    for (int m = 0; m < PAGE_CLEAR_METHODS; m++) {
+        if (page_ops_set(copy0, m) < 0) continue;
+        uint64_t t0 = rdtsc();
+        for (uint32_t p = 0; p < PAGES; p++) clear_page((void *)(uint64_t)src[p]);
+        uint64_t cycles = rdtsc() - t0;
+        uint64_t t1 = rdtsc(), sum = 0;
+        for (uint32_t p = 0; p < PAGES; p++) {
+            const uint64_t *w = (const uint64_t *)(uint64_t)src[p];
+            for (uint32_t i = 0; i < PAGE_SIZE / 8; i++) sum |= w[i];
+        }
+        report("clear", page_clear_name(m), cycles, rdtsc() - t1, sum == 0);
+        for (uint32_t p = 0; p < PAGES; p++) *(uint64_t *)(uint64_t)src[p] = 1;
+    }
+
+    page_ops_set(copy0, clear0);
+    write_cr0(cr0);
+    cur->page_table = kernel_pt;
+    pt_set_cr3(kernel_pt ? (void *)kernel_pt : pt_get_kernel_pml4());
+    for (uint32_t p = 0; p < PAGES; p++) free_frame(src[p]);
+    serial_puts("[cow_bench] done\n");
+}
+
+void cow_bench(void) {
+    serial_puts("[cow_bench] creating benchmark task\n");
+    task_create(cow_bench_task);
+}
@@ -0,0 +1,89 @@
+/* kernel/cr3_bench.c
+ * Same-address-space vs cross-process switch cost (build with
+ * -DRUN_CR3_BENCH). Two tasks ping-pong through scheduler_yield. First
+ * both run on the kernel PML4 (thread-like: no CR3 write), then the pong
+ * task moves to its own PML4 so every switch reloads CR3 and flushes the
+ * TLB. Each side touches a small working set every round so the refill
+ * cost after a flush is part of the measurement.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "arch/x86/cpu.h"
+#include "mm/pagetable.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+#define ROUNDS 10000
+#define WORKSET_PAGES 32
+#define WORKSET_STRIDE (2ULL * 1024 * 1024)   /* one 2MB identity page each */
+#define WORKSET_BASE   (64ULL * 1024 * 1024)
+
+static volatile int turn = 0;     /* 0 = ping's turn, 1 = pong's turn */
+static volatile int cross = 0;    /* pong runs in its own address space */
+static volatile int bench_done = 0;
+
+static void touch_workset(void) {
+    for (int i = 0; i < WORKSET_PAGES; i++)
+        (void)*(volatile uint64_t *)(WORKSET_BASE + i * WORKSET_STRIDE);
+}
+
+static void report(const char *name, uint64_t total, uint64_t loads) {
+    serial_puts("[cr3_bench] ");
+    serial_puts(name);
+    serial_puts(": rounds=");
+    serial_put_dec(ROUNDS);
+    serial_puts(" per_switch_cycles=");
+    serial_put_dec(total / ROUNDS / 2);
+    serial_puts(" cr3_loads=");
+    serial_put_dec(loads);
+    serial_putc('\n');
+}
+
+static uint64_t run_rounds(void) {
+    uint64_t t0 = rdtsc();
+    for (int i = 0; i < ROUNDS; i++) {
+        touch_workset();
+        turn = 1;
+        while (turn != 0) scheduler_yield();
+    }
+    return rdtsc() - t0;
+}
+
+static void ping_task(void) {
+    uint64_t loads0 = sched_cr3_loads();
+    uint64_t total = run_rounds();
+    report("same address space", total, sched_cr3_loads() - loads0);
+
+    cross = 1;
+    turn = 1;                       /* let pong switch page tables */
+    while (turn != 0) scheduler_yield();
+
+    loads0 = sched_cr3_loads();
+    total = run_rounds();
+    report("cross process", total, sched_cr3_loads() - loads0);
+
+    bench_done = 1;
+    serial_puts("[cr3_bench] done\n");
+}
+
+static void pong_task(void) {
+    int moved = 0;
+    while (!bench_done) {
+        while (turn != 1 && !bench_done) scheduler_yield();
+        if (cross && !moved) {
+            /* Private PML4 sharing the kernel's lower tables: same
+               mappings, different CR3 (effective from the next switch) */
+            pm_get_current()->page_table = (uint64_t *)pt_clone_current();
+            moved = 1;
+        }
+        touch_workset();
+        turn = 0;
+    }
+}
+
+void cr3_bench(void) {
+    serial_puts("[cr3_bench] creating ping/pong tasks\n");
+    task_create(ping_task);
+    task_create(pong_task);
+}
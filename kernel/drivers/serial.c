@@ -1,9 +1,51 @@
-/* kernel/drivers/serial.c - minimal serial port init and putchar */
+/* kernel/drivers/serial.c - COM1 console: buffered, interrupt-driven TX
+ *
+ * Writers reserve a span of the TX ring with one CAS on ring_head, copy
+ * their bytes in and return; they never wait for the UART. A slot holds
+ * 0 until its byte is written, so the drain side (tx_fill) stops at the
+ * first unwritten slot and a slow writer cannot expose garbage or lose
+ * the order of an earlier reservation. tx_fill pushes up to a FIFO's
+ * worth of bytes whenever the transmitter is empty; the THRE interrupt
+ * (IRQ4) calls it again as the FIFO drains. A full ring drops the whole
+ * write and counts it.
+ *
+ * Before serial_irq_install, in serial=sync mode and after serial_panic
+ * every byte is polled out directly, as the original driver did.
+ */
 #include <stdint.h>
 #include "serial.h"
+#ifndef HOST_TEST
+#include "../arch/x86/cpu.h"
+#endif
 
 #define SERIAL_PORT 0x3F8
+#define UART_THR    0           /* transmit holding register */
+#define UART_IER    1
+#define UART_IIR    2
+#define UART_LCR    3
+#define UART_MCR    4
+#define UART_LSR    5
+#define IER_THRE    0x02        /* interrupt when the TX FIFO empties */
+#define LSR_THRE    0x20        /* TX FIFO empty */
+#define LSR_TEMT    0x40        /* TX FIFO and shift register empty */
+#define UART_FIFO   16
+#define UART_CLOCK  115200      /* divisor 1 */
+#define SERIAL_IRQ  4
+#define SERIAL_VECTOR 0x24
 
+#define RING_SIZE 32768         /* power of two */
+#define RING_MASK (RING_SIZE - 1)
+
+#ifdef HOST_TEST
+/* tests/serial_test.c plays the UART */
+void uart_outb(uint16_t port, uint8_t val);
+uint8_t uart_inb(uint16_t port);
+static inline void outb(uint16_t port, uint8_t val) { uart_outb(port, val); }
+static inline uint8_t inb(uint16_t port) { return uart_inb(port); }
+static inline uint64_t rdtsc(void) { return 0; }
+static inline uint64_t irq_save(void) { return 0; }
+static inline void irq_restore(uint64_t flags) { (void)flags; }
+#else
 static inline void outb(uint16_t port, uint8_t val) {
     asm volatile ("outb %0, %1" : : "a"(val), "dN"(port));
 }
@@ -13,35 +55,202 @@ static inline uint8_t inb(uint16_t port) {
     asm volatile ("inb %1, %0" : "=a"(val) : "dN"(port));
     return val;
 }
+#endif
 
-void serial_init(void) {
-    outb(SERIAL_PORT + 1, 0x00);    // disable all interrupts
-    outb(SERIAL_PORT + 3, 0x80);    // enable DLAB (set baud rate divisor)
-    outb(SERIAL_PORT + 0, 0x03);    // set divisor to 3 (lo byte) 38400 baud
-    outb(SERIAL_PORT + 1, 0x00);    //                  (hi byte)
-    outb(SERIAL_PORT + 3, 0x03);    // 8 bits, no parity, one stop bit
-    outb(SERIAL_PORT + 2, 0xC7);    // enable FIFO, clear them, with 14-byte threshold
-    outb(SERIAL_PORT + 4, 0x0B);    // IRQs enabled, RTS/DSR set
+static char ring[RING_SIZE];
+static uint32_t ring_head;      /* next byte to reserve */
+static uint32_t ring_tail;      /* next byte to transmit */
+static int tx_lock;             /* one drainer at a time */
+static int tx_idle = 1;         /* no THRE interrupt is coming */
+static int buffered;            /* 0: poll every byte */
+static int force_sync;          /* serial=sync */
+
+static uint64_t stat_bytes, stat_dropped, stat_drops, stat_cycles;
+
+static void poll_putc(char c) {
+    while (!(inb(SERIAL_PORT + UART_LSR) & LSR_THRE)) ;
+    outb(SERIAL_PORT + UART_THR, (uint8_t)c);
 }
 
-void serial_putc(char c) {
+/* Move ready bytes into the UART FIFO if it is empty; never waits */
+static void tx_fill(void) {
+    if (__atomic_exchange_n(&tx_lock, 1, __ATOMIC_ACQUIRE)) return;
     for (;;) {
-        if (inb(SERIAL_PORT + 5) & 0x20) break;
+        uint32_t tail = ring_tail;
+        int sent = 0;
+        if (inb(SERIAL_PORT + UART_LSR) & LSR_THRE) {
+            while (sent < UART_FIFO) {
+                char c = __atomic_load_n(&ring[tail & RING_MASK], __ATOMIC_ACQUIRE);
+                if (!c) break;
+                outb(SERIAL_PORT + UART_THR, (uint8_t)c);
+                __atomic_store_n(&ring[tail & RING_MASK], 0, __ATOMIC_RELAXED);
+                tail++;
+                sent++;
+            }
+            __atomic_store_n(&ring_tail, tail, __ATOMIC_RELEASE);
+            if (!sent) {
+                /* transmitter empty and nothing to send: the next writer
+                   has to start it. Recheck after publishing that, in case
+                   a writer finished in between and saw tx_idle == 0. */
+                __atomic_store_n(&tx_idle, 1, __ATOMIC_SEQ_CST);
+                if (__atomic_load_n(&ring[tail & RING_MASK], __ATOMIC_SEQ_CST)) {
+                    __atomic_store_n(&tx_idle, 0, __ATOMIC_RELAXED);
+                    continue;
+                }
+                break;
+            }
+        }
+        /* bytes in flight (or FIFO still busy): THRE interrupt follows */
+        __atomic_store_n(&tx_idle, 0, __ATOMIC_RELAXED);
+        break;
     }
-    outb(SERIAL_PORT, (uint8_t)c);
+    __atomic_store_n(&tx_lock, 0, __ATOMIC_RELEASE);
+}
+
+/* Append n bytes as one unit, or drop them all if the ring is full */
+void serial_write(const char *s, uint32_t n) {
+    if (!n) return;
+    uint64_t t0 = rdtsc();
+    if (!buffered) {
+        for (uint32_t i = 0; i < n; i++) poll_putc(s[i]);
+        __atomic_fetch_add(&stat_bytes, n, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&stat_cycles, rdtsc() - t0, __ATOMIC_RELAXED);
+        return;
+    }
+
+    uint32_t head = __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+    do {
+        uint32_t tail = __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE);
+        if (n > RING_SIZE - (head - tail)) {
+            __atomic_fetch_add(&stat_dropped, n, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&stat_drops, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&ring_head, &head, head + n, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    /* 0 marks an unwritten slot: a NUL byte goes out as a space */
+    for (uint32_t i = 0; i < n; i++)
+        __atomic_store_n(&ring[(head + i) & RING_MASK], s[i] ? s[i] : ' ', __ATOMIC_RELEASE);
+
+    if (__atomic_load_n(&tx_idle, __ATOMIC_SEQ_CST)) tx_fill();
+    __atomic_fetch_add(&stat_bytes, n, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stat_cycles, rdtsc() - t0, __ATOMIC_RELAXED);
+}
+
+static void program_divisor(uint16_t div) {
+    outb(SERIAL_PORT + UART_LCR, 0x80);        // enable DLAB (set baud rate divisor)
+    outb(SERIAL_PORT + 0, (uint8_t)div);       // divisor lo byte
+    outb(SERIAL_PORT + 1, (uint8_t)(div >> 8)); //          hi byte
+    outb(SERIAL_PORT + UART_LCR, 0x03);        // 8 bits, no parity, one stop bit
+}
+
+void serial_init(void) {
+    outb(SERIAL_PORT + UART_IER, 0x00);    // disable all interrupts
+    program_divisor(UART_CLOCK / SERIAL_BAUD);
+    outb(SERIAL_PORT + UART_IIR, 0xC7);    // enable FIFO, clear them, with 14-byte threshold
+    outb(SERIAL_PORT + UART_MCR, 0x0B);    // IRQs enabled, RTS/DSR set
+}
+
+int serial_set_baud(uint32_t baud) {
+    if (!baud || baud > UART_CLOCK || UART_CLOCK % baud) return -1;
+    uint64_t flags = irq_save();
+    /* let the bytes already in the FIFO leave at the old rate */
+    while (!(inb(SERIAL_PORT + UART_LSR) & LSR_TEMT)) ;
+    program_divisor((uint16_t)(UART_CLOCK / baud));
+    irq_restore(flags);
+    return 0;
+}
+
+void serial_irq_install(void) {
+    if (force_sync) return;
+#ifndef HOST_TEST
+    extern void idt_set_gate(unsigned char num, uint64_t base, uint16_t sel, uint8_t flags, uint8_t ist);
+    extern void isr_0x24(void);
+    extern void pic_unmask_irq(int irq);
+    idt_set_gate(SERIAL_VECTOR, (uint64_t)isr_0x24, 0x08, 0x8E, 0);
+    pic_unmask_irq(SERIAL_IRQ);
+#endif
+    buffered = 1;
+    outb(SERIAL_PORT + UART_IER, IER_THRE);
+}
+
+/* IRQ4: the only source enabled is THRE; reading IIR acknowledges it */
+void serial_irq(void) {
+    (void)inb(SERIAL_PORT + UART_IIR);
+    tx_fill();
+#ifndef HOST_TEST
+    extern void pic_send_eoi(int irq);
+    pic_send_eoi(SERIAL_IRQ);
+#endif
+}
+
+void serial_poll(void) {
+    if (buffered && __atomic_load_n(&ring[ring_tail & RING_MASK], __ATOMIC_RELAXED))
+        tx_fill();
+}
+
+/* Switch to polled output, pushing out what the ring holds first. A
+   writer interrupted mid-copy leaves a hole; everything after it is lost. */
+static void drain_sync(void) {
+    buffered = 0;
+    outb(SERIAL_PORT + UART_IER, 0x00);
+    uint32_t tail = ring_tail;
+    char c;
+    while ((c = ring[tail & RING_MASK]) != 0) {
+        poll_putc(c);
+        ring[tail & RING_MASK] = 0;
+        tail++;
+    }
+    ring_tail = tail;
+    ring_head = tail;
+    tx_lock = 0;
+}
+
+void serial_set_sync(void) {
+    uint64_t flags = irq_save();
+    force_sync = 1;
+    drain_sync();
+    irq_restore(flags);
+}
+
+void serial_panic(void) {
+    (void)irq_save();   /* a panicking CPU does not come back: leave them off */
+    drain_sync();
+}
+
+void serial_putc(char c) {
+    serial_write(&c, 1);
 }
 
 void serial_puts(const char *s) {
     if (!s) return;
-    while (*s) {
-        serial_putc(*s++);
-    }
+    uint32_t n = 0;
+    while (s[n]) n++;
+    serial_write(s, n);
 }
 
 void serial_put_hex(uint64_t value) {
     const char *hex = "0123456789abcdef";
-    for (int i = 60; i >= 0; i -= 4) {
-        serial_putc(hex[(value >> i) & 0xF]);
-    }
+    char buf[16];
+    for (int i = 0; i < 16; i++) buf[i] = hex[(value >> (60 - 4 * i)) & 0xF];
+    serial_write(buf, 16);
+}
+
+void serial_put_dec(uint64_t value) {
+    char buf[20];
+    int n = 20;
+    do {
+        buf[--n] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    serial_write(buf + n, (uint32_t)(20 - n));
 }
 
+void serial_get_stats(serial_stats_t *st) {
+    st->bytes = stat_bytes;
+    st->dropped = stat_dropped;
+    st->drops = stat_drops;
+    st->cycles = stat_cycles;
+    st->buffered = buffered;
+}
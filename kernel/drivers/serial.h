@@ -5,9 +5,39 @@
 #ifndef SERIAL_H
 #define SERIAL_H
 
+#include <stdint.h>
+
+/* Boot rate; serial_set_baud changes it. Must divide 115200. */
+#ifndef SERIAL_BAUD
+#define SERIAL_BAUD 115200
+#endif
+
 void serial_init(void);
 void serial_putc(char c);
 void serial_puts(const char *s);
 void serial_put_hex(uint64_t value);
+void serial_put_dec(uint64_t value);
+void serial_write(const char *s, uint32_t n);   /* n bytes, kept together */
+
+/* Output is polled until serial_irq_install (after the IDT and PIC are
+   set up); from then on writers only append to a TX ring that the THRE
+   interrupt drains, and a full ring drops the write. */
+void serial_irq_install(void);
+void serial_irq(void);          /* IRQ4 handler body */
+void serial_poll(void);         /* drain from elsewhere (timer tick) if stuck */
+int serial_set_baud(uint32_t baud);    /* -1 unless it divides 115200 */
+void serial_set_sync(void);     /* serial=sync: stay polled, for comparison */
+
+/* Flush the ring by polling and stay polled: for paths that halt */
+void serial_panic(void);
+
+typedef struct serial_stats {
+    uint64_t bytes;         /* accepted */
+    uint64_t dropped;       /* bytes lost to a full ring */
+    uint64_t drops;         /* writes lost to a full ring */
+    uint64_t cycles;        /* spent inside serial_put* */
+    int buffered;
+} serial_stats_t;
+void serial_get_stats(serial_stats_t *st);
 
 #endif /* SERIAL_H */
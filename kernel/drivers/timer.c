@@ -1,20 +1,335 @@
-/* kernel/drivers/timer.c - minimal timer setup (PIT) */
+/* kernel/drivers/timer.c - timer subsystem (TSC clock + one-shot events)
+ * The TSC is calibrated against PIT channel 2 and used as the time base.
+ * Events live in a binary min-heap ordered by TSC deadline; the hardware
+ * is programmed for the earliest one using TSC-deadline mode when the CPU
+ * has it, LAPIC one-shot otherwise, and the periodic PIT as last resort.
+ */
 #include <stdint.h>
+#include "timer.h"
+#include "serial.h"
+#include "../klog.h"
+#include "../arch/x86/cpu.h"
+#include "../arch/x86/lapic.h"
+#include "../elf_loader.h"
 
-#define PIT_FREQ 1193180
+#define PIT_FREQ 1193182
 #define IRQ0 0
-#define TIMER_DIVISOR 1000
-/* small outb helper for port I/O */
+#define TIMER_VECTOR 0x20
+#define TIMER_MAX_EVENTS 256
+#define CALIBRATE_MS 10
+#define IA32_TSC_DEADLINE 0x6E0
+
+/* small outb/inb helpers for port I/O */
 static inline void outb(uint16_t port, uint8_t val) {
     asm volatile ("outb %0, %1" : : "a"(val), "dN"(port));
 }
 
+static inline uint8_t inb(uint16_t port) {
+    uint8_t val;
+    asm volatile ("inb %1, %0" : "=a"(val) : "dN"(port));
+    return val;
+}
+
+static int mode = TIMER_MODE_PIT;
+static uint64_t tsc_hz = 0;
+static uint64_t lapic_mult = 0;     /* LAPIC ticks per TSC cycle, 32.32 fixed point */
+
+static timer_event_t *heap[TIMER_MAX_EVENTS];
+static int heap_size = 0;
+
+static timer_event_t slice_event;
+static volatile int slice_expired = 0;
+static int tickless = 1;
+static volatile uint64_t irq_count = 0;
+
+/* ---------------- PIT ---------------- */
+
+static void pit_set_periodic(uint32_t hz) {
+    uint16_t divisor = (uint16_t)(PIT_FREQ / hz);
+    outb(0x43, 0x34);                 /* channel 0, lo/hi, mode 2 (rate generator) */
+    outb(0x40, (uint8_t)(divisor & 0xFF));
+    outb(0x40, (uint8_t)((divisor >> 8) & 0xFF));
+}
+
+static void pit_stop(void) {
+    outb(0x43, 0x30);                 /* channel 0, lo/hi, mode 0, no count loaded */
+}
+
+/* Start a one-shot countdown of `ms` milliseconds on PIT channel 2; its
+   output (port 0x61 bit 5) goes high when it expires. */
+static void pit_ch2_start(uint32_t ms) {
+    uint16_t count = (uint16_t)(PIT_FREQ / 1000 * ms);
+    outb(0x61, (inb(0x61) & ~0x02) | 0x01); /* gate on, speaker off */
+    outb(0x43, 0xB0);                 /* channel 2, lo/hi, mode 0 */
+    outb(0x42, (uint8_t)(count & 0xFF));
+    outb(0x42, (uint8_t)(count >> 8));
+}
+
+static int pit_ch2_expired(void) {
+    return inb(0x61) & 0x20;
+}
+
+/* ---------------- clock ---------------- */
+
+uint64_t timer_tsc_hz(void) { return tsc_hz; }
+int timer_mode(void) { return mode; }
+
+uint64_t timer_ns_to_tsc(uint64_t ns) {
+    return (ns / 1000000000ULL) * tsc_hz + (ns % 1000000000ULL) * tsc_hz / 1000000000ULL;
+}
+
+uint64_t timer_tsc_to_ns(uint64_t tsc) {
+    if (!tsc_hz) return 0;
+    return (tsc / tsc_hz) * 1000000000ULL + (tsc % tsc_hz) * 1000000000ULL / tsc_hz;
+}
+
+uint64_t timer_now_ns(void) {
+    return timer_tsc_to_ns(rdtsc());
+}
+
+/* ---------------- event heap ---------------- */
+
+static void heap_swap(int i, int j) {
+    timer_event_t *t = heap[i];
+    heap[i] = heap[j];
+    heap[j] = t;
+    heap[i]->heap_idx = i;
+    heap[j]->heap_idx = j;
+}
+
+static void heap_up(int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent]->deadline <= heap[i]->deadline) break;
+        heap_swap(i, parent);
+        i = parent;
+    }
+}
+
+static void heap_down(int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < heap_size && heap[l]->deadline < heap[m]->deadline) m = l;
+        if (r < heap_size && heap[r]->deadline < heap[m]->deadline) m = r;
+        if (m == i) break;
+        heap_swap(i, m);
+        i = m;
+    }
+}
+
+static void heap_remove(timer_event_t *ev) {
+    int i = ev->heap_idx;
+    ev->heap_idx = -1;
+    heap_size--;
+    if (i == heap_size) return;
+    heap[i] = heap[heap_size];
+    heap[i]->heap_idx = i;
+    heap_up(i);
+    heap_down(i);
+}
+
+/* Program the hardware for the earliest pending deadline */
+static void timer_program_next(void) {
+    if (mode == TIMER_MODE_PIT) return;
+    if (heap_size == 0) {
+        /* nothing pending: disarm so an idle CPU is not woken up */
+        if (mode == TIMER_MODE_TSC_DEADLINE) wrmsr(IA32_TSC_DEADLINE, 0);
+        else lapic_write(LAPIC_TIMER_INIT, 0);
+        return;
+    }
+    uint64_t deadline = heap[0]->deadline;
+
+    if (mode == TIMER_MODE_TSC_DEADLINE) {
+        wrmsr(IA32_TSC_DEADLINE, deadline);
+        return;
+    }
+
+    /* LAPIC one-shot: convert the TSC delta into LAPIC ticks. Clamp to
+       half a second so the 32.32 multiply cannot overflow; a far-away
+       deadline simply gets re-armed when this shot expires. */
+    uint64_t now = rdtsc();
+    uint64_t delta = deadline > now ? deadline - now : 1;
+    if (delta > tsc_hz / 2) delta = tsc_hz / 2;
+    uint64_t ticks = (delta * lapic_mult) >> 32;
+    if (ticks == 0) ticks = 1;
+    if (ticks > 0xFFFFFFFFULL) ticks = 0xFFFFFFFFULL;
+    lapic_write(LAPIC_TIMER_INIT, (uint32_t)ticks);
+}
+
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    uint64_t flags = irq_save();
+    if (ev->heap_idx >= 0 && ev->heap_idx < heap_size && heap[ev->heap_idx] == ev)
+        heap_remove(ev);
+    if (heap_size >= TIMER_MAX_EVENTS) {
+        ev->heap_idx = -1;
+        irq_restore(flags);
+        return -1;
+    }
+    ev->deadline = deadline;
+    ev->fn = fn;
+    ev->arg = arg;
+    ev->heap_idx = heap_size;
+    heap[heap_size++] = ev;
+    heap_up(ev->heap_idx);
+    if (heap[0] == ev) timer_program_next();
+    irq_restore(flags);
+    return 0;
+}
+
+void timer_cancel(timer_event_t *ev) {
+    uint64_t flags = irq_save();
+    if (ev->heap_idx >= 0 && ev->heap_idx < heap_size && heap[ev->heap_idx] == ev)
+        heap_remove(ev);
+    irq_restore(flags);
+}
+
+void timer_run_expired(uint64_t now) {
+    while (heap_size > 0 && heap[0]->deadline <= now) {
+        timer_event_t *ev = heap[0];
+        heap_remove(ev);
+        ev->fn(ev->arg);    /* may re-arm itself */
+    }
+    timer_program_next();
+}
+
+/* ---------------- scheduler slice + sleep ---------------- */
+
+static void slice_fire(void *arg) {
+    (void)arg;
+    slice_expired = 1;
+    timer_add(&slice_event, rdtsc() + timer_ns_to_tsc(SCHED_SLICE_NS), slice_fire, 0);
+}
+
+int timer_interrupt(void) {
+    irq_count++;
+    if (mode == TIMER_MODE_PIT) {
+        extern void pic_send_eoi(int irq);
+        pic_send_eoi(IRQ0);
+        /* every PIT tick is a slice boundary */
+        slice_expired = 1;
+    } else {
+        lapic_eoi();
+    }
+
+    if (tsc_hz) timer_run_expired(rdtsc());
+    serial_poll();      /* in case a THRE interrupt went missing */
+    klog_poll();
+
+    int expired = slice_expired;
+    slice_expired = 0;
+    return expired;
+}
+
+uint64_t timer_irq_count(void) { return irq_count; }
+int timer_tickless(void) { return tickless; }
+
+void timer_set_tickless(int on) {
+    tickless = on;
+    /* periodic behaviour again: make sure the slice timer is running */
+    if (!on) timer_sched_update(2);
+}
+
+void timer_sched_update(int nr_runnable) {
+    if (!tsc_hz || mode == TIMER_MODE_PIT) return;
+    if (tickless && nr_runnable <= 1) {
+        /* nothing to time-slice against: stop the tick */
+        timer_cancel(&slice_event);
+    } else if (slice_event.heap_idx < 0) {
+        timer_add(&slice_event, rdtsc() + timer_ns_to_tsc(SCHED_SLICE_NS), slice_fire, 0);
+    }
+}
+
+static void sleep_wake(void *arg) {
+    extern void sched_wake(process_t *p);
+    sched_wake((process_t *)arg);
+}
+
+void timer_sleep_ns(uint64_t ns) {
+    extern process_t *pm_get_current(void);
+    extern void scheduler_yield(void);
+    uint64_t deadline = rdtsc() + timer_ns_to_tsc(ns);
+    process_t *cur = pm_get_current();
+
+    if (!cur || !tsc_hz) {
+        /* no task context (early boot) or no clock: spin */
+        while (rdtsc() < deadline)
+            asm volatile ("pause");
+        return;
+    }
+
+    timer_event_t ev;
+    ev.heap_idx = -1;
+    uint64_t flags = irq_save();
+    if (timer_add(&ev, deadline, sleep_wake, cur) != 0) {
+        irq_restore(flags);
+        while (rdtsc() < deadline)
+            asm volatile ("pause");
+        return;
+    }
+    cur->state = 2; /* sleeping */
+    scheduler_yield();
+    timer_cancel(&ev);  /* no-op unless woken early */
+    irq_restore(flags);
+}
+
+/* ---------------- setup ---------------- */
+
+/* Measure TSC (and, if present, LAPIC timer) rates over CALIBRATE_MS of
+   PIT channel 2. */
+static void timer_calibrate(int with_lapic) {
+    if (with_lapic) {
+        lapic_write(LAPIC_TIMER_DIV, 0x3);              /* divide by 16 */
+        lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED | LAPIC_TIMER_ONESHOT);
+    }
+
+    pit_ch2_start(CALIBRATE_MS);
+    if (with_lapic) lapic_write(LAPIC_TIMER_INIT, 0xFFFFFFFF);
+    uint64_t t0 = rdtsc();
+    while (!pit_ch2_expired())
+        ;
+    uint64_t t1 = rdtsc();
+    uint32_t lapic_elapsed = with_lapic ? 0xFFFFFFFF - lapic_read(LAPIC_TIMER_CUR) : 0;
+    if (with_lapic) lapic_write(LAPIC_TIMER_INIT, 0);
+
+    tsc_hz = (t1 - t0) * (1000 / CALIBRATE_MS);
+    if (with_lapic && tsc_hz) {
+        uint64_t lapic_hz = (uint64_t)lapic_elapsed * (1000 / CALIBRATE_MS);
+        lapic_mult = (lapic_hz << 32) / tsc_hz;
+    }
+}
+
 void timer_install(void) {
-    uint16_t divisor = PIT_FREQ / TIMER_DIVISOR;
-    uint8_t l = (uint8_t)(divisor & 0xFF);
-    uint8_t h = (uint8_t)((divisor >> 8) & 0xFF);
+    uint32_t a, b, c, d;
+    cpuid(1, 0, &a, &b, &c, &d);
+    int has_tsc_deadline = (c >> 24) & 1;
+    int has_lapic = lapic_init() == 0;
+
+    timer_calibrate(has_lapic);
+
+    serial_puts("[timer] TSC calibrated: ");
+    serial_put_dec(tsc_hz / 1000);
+    serial_puts(" kHz\n");
+
+    if (has_lapic && tsc_hz && (has_tsc_deadline || lapic_mult)) {
+        extern void pic_mask_irq(int irq);
+        pit_stop();
+        pic_mask_irq(IRQ0);
+        if (has_tsc_deadline) {
+            mode = TIMER_MODE_TSC_DEADLINE;
+            lapic_write(LAPIC_LVT_TIMER, TIMER_VECTOR | LAPIC_TIMER_TSC_DL);
+            serial_puts("[timer] using LAPIC TSC-deadline mode\n");
+        } else {
+            mode = TIMER_MODE_LAPIC_ONESHOT;
+            lapic_write(LAPIC_LVT_TIMER, TIMER_VECTOR | LAPIC_TIMER_ONESHOT);
+            serial_puts("[timer] using LAPIC one-shot mode\n");
+        }
+    } else {
+        mode = TIMER_MODE_PIT;
+        pit_set_periodic(TIMER_HZ);
+        serial_puts("[timer] using PIT periodic fallback\n");
+    }
 
-    outb(0x43, 0x34);
-    outb(0x40, l);
-    outb(0x40, h);
+    slice_event.heap_idx = -1;
+    if (tsc_hz)
+        timer_add(&slice_event, rdtsc() + timer_ns_to_tsc(SCHED_SLICE_NS), slice_fire, 0);
 }
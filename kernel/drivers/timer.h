@@ -0,0 +1,66 @@
+/* kernel/drivers/timer.h
+ * Timer subsystem: calibrated TSC clock plus a one-shot event timer
+ * (TSC-deadline or LAPIC one-shot, PIT periodic as fallback).
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+/* Hardware used to deliver timer events */
+#define TIMER_MODE_PIT          0  /* periodic PIT IRQ0, events checked per tick */
+#define TIMER_MODE_LAPIC_ONESHOT 1 /* LAPIC timer, one-shot count */
+#define TIMER_MODE_TSC_DEADLINE 2  /* LAPIC timer, IA32_TSC_DEADLINE MSR */
+
+/* Scheduler time slice (and the PIT fallback tick rate) */
+#define TIMER_HZ 1000
+#define SCHED_SLICE_NS (1000000000ULL / TIMER_HZ)
+
+/* A pending timeout. Embed one wherever a timeout is needed (on the
+   sleeping task's stack, in a driver struct...) and arm it with timer_add. */
+typedef struct timer_event {
+    uint64_t deadline;               /* absolute TSC value */
+    void (*fn)(void *arg);           /* runs in interrupt context */
+    void *arg;
+    int heap_idx;                    /* position in the timer heap, -1 if idle */
+} timer_event_t;
+
+/* Calibrate the TSC, pick the best event source and start the slice timer */
+void timer_install(void);
+int timer_mode(void);
+
+/* Clock */
+uint64_t timer_tsc_hz(void);
+uint64_t timer_now_ns(void);
+uint64_t timer_ns_to_tsc(uint64_t ns);
+uint64_t timer_tsc_to_ns(uint64_t tsc);
+
+/* Arm (or re-arm) ev to fire at the absolute TSC deadline. Returns 0 on
+   success, -1 if the timer heap is full. */
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg);
+void timer_cancel(timer_event_t *ev);
+
+/* Run every event whose deadline is <= now and reprogram the hardware */
+void timer_run_expired(uint64_t now);
+
+/* Timer interrupt body: acknowledge the interrupt, run expired events.
+   Returns non-zero if the current time slice is over. */
+int timer_interrupt(void);
+
+/* Dynamic ticks: the scheduler reports how many tasks are runnable after
+   every switch/wakeup. With tickless enabled the slice timer only runs when
+   more than one task competes for the CPU; otherwise the hardware is only
+   programmed for real timeouts (sleepers, kernel timers). Needs a one-shot
+   source: the PIT fallback keeps ticking periodically. */
+void timer_sched_update(int nr_runnable);
+void timer_set_tickless(int on);
+int timer_tickless(void);
+
+/* Number of timer interrupts taken since boot */
+uint64_t timer_irq_count(void);
+
+/* Block the current task for at least ns nanoseconds */
+void timer_sleep_ns(uint64_t ns);
+
+#endif /* TIMER_H */
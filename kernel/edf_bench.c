@@ -0,0 +1,94 @@
+/* kernel/edf_bench.c
+ * Deadline class under mixed load (build with -DRUN_EDF_BENCH). Three
+ * periodic tasks (heartbeat, gossip, model tick) burn a fixed amount of
+ * CPU per job inside their reserved runtime while two batch tasks spin in
+ * the fair class. After two seconds each periodic task reports its jobs
+ * and deadline misses; tests/qemu_edf_test.sh expects total_misses=0.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+#define MS 1000000ULL
+#define RUN_NS (2000 * MS)
+
+typedef struct {
+    const char *name;
+    uint64_t runtime, deadline, period, work;   /* ns */
+    uint64_t jobs, misses;
+    volatile int done;
+} edf_job_t;
+
+static edf_job_t jobs[] = {
+    { "heartbeat",  2 * MS, 10 * MS, 10 * MS, 1 * MS, 0, 0, 0 },
+    { "gossip",     3 * MS, 15 * MS, 20 * MS, 2 * MS, 0, 0, 0 },
+    { "model",     10 * MS, 40 * MS, 50 * MS, 7 * MS, 0, 0, 0 },
+};
+#define NJOBS (int)(sizeof(jobs) / sizeof(jobs[0]))
+
+static volatile int next_job = 0;
+static volatile int batch_stop = 0;
+
+static void periodic_task(void) {
+    edf_job_t *j = &jobs[__atomic_fetch_add(&next_job, 1, __ATOMIC_SEQ_CST)];
+    process_t *self = pm_get_current();
+
+    if (sched_setattr(self, j->runtime, j->deadline, j->period) != 0) {
+        serial_puts("[edf_bench] admission refused\n");
+        j->done = 1;
+        return;
+    }
+    uint64_t end = rdtsc() + timer_ns_to_tsc(RUN_NS);
+    uint64_t work = timer_ns_to_tsc(j->work);
+    while (rdtsc() < end) {
+        /* busy for `work` of wall time: at most that much CPU */
+        uint64_t t0 = rdtsc();
+        while (rdtsc() - t0 < work)
+            asm volatile ("pause");
+        sched_dl_yield();
+    }
+    j->jobs = self->dl.jobs;
+    j->misses = self->dl.misses;
+    sched_setattr(self, 0, 0, 0);
+    j->done = 1;
+}
+
+static void batch_task(void) {
+    while (!batch_stop)
+        asm volatile ("pause");
+}
+
+static void edf_bench_task(void) {
+    timer_sleep_ns(RUN_NS + 100 * MS);
+    for (int i = 0; i < NJOBS; i++)
+        while (!jobs[i].done) timer_sleep_ns(10 * MS);
+    batch_stop = 1;
+
+    uint64_t total = 0;
+    for (int i = 0; i < NJOBS; i++) {
+        serial_puts("[edf_bench] ");
+        serial_puts(jobs[i].name);
+        serial_puts(": jobs=");
+        serial_put_dec(jobs[i].jobs);
+        serial_puts(" misses=");
+        serial_put_dec(jobs[i].misses);
+        serial_putc('\n');
+        total += jobs[i].misses;
+    }
+    serial_puts("[edf_bench] total_misses=");
+    serial_put_dec(total);
+    serial_puts("\n[edf_bench] done\n");
+}
+
+void edf_bench(void) {
+    serial_puts("[edf_bench] creating periodic + batch tasks\n");
+    task_create(edf_bench_task);
+    for (int i = 0; i < NJOBS; i++)
+        task_create(periodic_task);
+    task_create(batch_task);
+    task_create(batch_task);
+}
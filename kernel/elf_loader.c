@@ -7,12 +7,26 @@
 #include "mm/pagetable.h"
 #include "drivers/serial.h"
 #include "mm/virtual_memory.h"
+#include "trace.h"
+#include "vdso.h"
+#include "klog.h"
+#include "mm/physical_memory.h"
+#include "mm/page.h"
 
 /* Forward declare kernel functions */
 extern void *kmalloc(unsigned int size);
 extern void *memcpy(void *dst, const void *src, size_t n);
 extern void *memset(void *dst, int c, size_t n);
 
+#ifdef HOST_TEST
+/* host tests back physical frames with host memory */
+extern void *host_phys_to_virt(uint64_t pa);
+#define phys_to_virt(pa) host_phys_to_virt(pa)
+#else
+/* frames lie in the identity-mapped first GiB */
+#define phys_to_virt(pa) ((void *)(uintptr_t)(pa))
+#endif
+
 /* Validate ELF header */
 int elf_validate(const elf64_hdr_t *hdr) {
     if (!hdr) return 0;
@@ -25,19 +39,19 @@ int elf_validate(const elf64_hdr_t *hdr) {
     
     /* Check class (64-bit) */
     if (hdr->e_ident[EI_CLASS] != ELFCLASS64) {
-        serial_puts("[elf] Error: not 64-bit ELF\n");
+        klog_warn("[elf] Error: not 64-bit ELF");
         return 0;
     }
     
     /* Check endianness (little-endian) */
     if (hdr->e_ident[EI_DATA] != ELFDATA2LSB) {
-        serial_puts("[elf] Error: not little-endian\n");
+        klog_warn("[elf] Error: not little-endian");
         return 0;
     }
     
     /* Check type (ET_EXEC for position-independent or ET_DYN for PIE) */
     if (hdr->e_type != ET_EXEC && hdr->e_type != ET_DYN) {
-        serial_puts("[elf] Error: unsupported ELF type\n");
+        klog_warn("[elf] Error: unsupported ELF type %u", hdr->e_type);
         return 0;
     }
     
@@ -47,37 +61,101 @@ int elf_validate(const elf64_hdr_t *hdr) {
 /* Simple process ID allocator */
 /* next_pid no longer used; processes are registered via process_manager */
 
+/* Back [vaddr, vaddr+memsz) with fresh frames in pml4 only and copy the
+ * file part in through their physical addresses; the rest is zero. The
+ * identity map every address space starts from is shared, so writing to
+ * vaddr directly would overwrite the image of whoever is running there.
+ * *mapped_end is the end of the pages mapped so far: segments come in
+ * ascending order, and a page shared with the previous segment is reused.
+ */
+static int elf_map_segment(void *pml4, const uint8_t *src, uint64_t vaddr, uint64_t filesz,
+                           uint64_t memsz, int writable, uint64_t *mapped_end) {
+    uint64_t flags = writable ? 0x7 : 0x5;   /* present, user, W if asked */
+    for (uint64_t page = vaddr & ~0xFFFULL; page < vaddr + memsz; page += PAGE_SIZE) {
+        uint64_t frame;
+        if (page < *mapped_end) {
+            uint64_t *pte = pt_find_pte_for_vaddr(pml4, page);
+            if (!pte) return -1;
+            *pte |= flags;
+            frame = *pte & 0x000FFFFFFFFFF000ULL;
+        } else {
+            frame = alloc_frame();
+            if (!frame) return -1;
+            clear_page(phys_to_virt(frame));
+            if (pt_map_page(pml4, page, frame, flags) < 0) {
+                frame_decref((uint32_t)frame);
+                return -1;
+            }
+            *mapped_end = page + PAGE_SIZE;
+        }
+        /* part of [vaddr, vaddr+filesz) inside this page */
+        uint64_t from = page > vaddr ? page : vaddr;
+        uint64_t to = page + PAGE_SIZE < vaddr + filesz ? page + PAGE_SIZE : vaddr + filesz;
+        if (from < to)
+            memcpy((uint8_t *)phys_to_virt(frame) + (from - page), src + (from - vaddr), to - from);
+    }
+    return 0;
+}
+
+/* Back the user stack [USER_STACK_TOP - USER_STACK_SIZE, USER_STACK_TOP)
+ * with zeroed private frames in pml4. Frames already mapped when this
+ * fails are released with the rest of the address space (pt_destroy).
+ */
+static int elf_map_stack(void *pml4) {
+    for (uint64_t va = USER_STACK_TOP - USER_STACK_SIZE; va < USER_STACK_TOP; va += PAGE_SIZE) {
+        uint64_t frame = alloc_frame();
+        if (!frame) return -1;
+        clear_page(phys_to_virt(frame));
+        if (pt_map_page(pml4, va, frame, 0x7) < 0) {
+            frame_decref((uint32_t)frame);
+            return -1;
+        }
+    }
+    return 0;
+}
+
 /* Load ELF binary into memory */
 process_t *elf_load(const uint8_t *binary_data, size_t size) {
     if (size < sizeof(elf64_hdr_t)) {
-        serial_puts("[elf] Error: binary too small\n");
+        klog_warn("[elf] Error: binary too small (%lu bytes)", size);
         return NULL;
     }
     
     const elf64_hdr_t *elf_hdr = (const elf64_hdr_t *)binary_data;
     
     if (!elf_validate(elf_hdr)) {
-        serial_puts("[elf] Invalid ELF header\n");
+        klog_warn("[elf] Invalid ELF header");
         return NULL;
     }
     
-    serial_puts("[elf] Valid ELF header found\n");
+    klog_debug("[elf] Valid ELF header found");
     
     /* Allocate process control block */
-    process_t *proc = (process_t *)kmalloc(sizeof(process_t));
+    extern process_t *pm_alloc_process(void);
+    extern void pm_free_process(process_t *p);
+    process_t *proc = pm_alloc_process();
     if (!proc) return NULL;
     
-    memset(proc, 0, sizeof(process_t));
     proc->pid = 0; /* will be set by process manager on registration */
     proc->entry_point = elf_hdr->e_entry;
     proc->state = 0; /* new */
+
+    /* Fresh address space: a copy of the kernel PML4 whose segment pages
+       are then replaced by private frames (elf_map_segment) */
+    void *pml4 = pt_clone_current();
+    if (!pml4) {
+        klog_err("[elf] Error: cannot allocate page table");
+        pm_free_process(proc);
+        return NULL;
+    }
+    uint64_t mapped_end = 0;
     
     /* Parse program headers and load LOAD segments */
     uint64_t ph_offset = elf_hdr->e_phoff;
     uint16_t ph_num = elf_hdr->e_phnum;
     uint16_t ph_size = elf_hdr->e_phentsize;
     
-    serial_puts("[elf] Loading segments...\n");
+    klog_debug("[elf] Loading %d program headers", ph_num);
     
     for (int i = 0; i < ph_num; i++) {
         const elf64_phdr_t *phdr = (const elf64_phdr_t *)(binary_data + ph_offset + i * ph_size);
@@ -88,23 +166,20 @@ process_t *elf_load(const uint8_t *binary_data, size_t size) {
             uint64_t filesz = phdr->p_filesz;
             uint64_t offset = phdr->p_offset;
             
-            serial_puts("[elf] Segment: vaddr=0x");
-            serial_put_hex(vaddr);
-            serial_puts(" memsz=0x");
-            serial_put_hex(memsz);
-            serial_putc('\n');
+            klog_debug("[elf] Segment: vaddr=0x%lx memsz=0x%lx", vaddr, memsz);
             
-            /* Copy segment data */
-            if (offset + filesz <= size) {
-                memcpy((void *)vaddr, binary_data + offset, filesz);
-                
-                /* Zero-fill BSS (memsz > filesz) */
-                if (memsz > filesz) {
-                    memset((void *)(vaddr + filesz), 0, memsz - filesz);
-                }
-            } else {
-                serial_puts("[elf] Error: segment exceeds binary\n");
-                /* (no-op for bump allocator, proc stays allocated) */
+            /* Copy segment data; BSS (memsz > filesz) stays zero */
+            if (offset > size || filesz > size - offset || filesz > memsz) {
+                klog_warn("[elf] Error: segment at 0x%lx exceeds binary", vaddr);
+                pt_destroy(pml4);
+                pm_free_process(proc);
+                return NULL;
+            }
+            if (elf_map_segment(pml4, binary_data + offset, vaddr, filesz, memsz,
+                                (phdr->p_flags & ELF_PF_W) != 0, &mapped_end) < 0) {
+                klog_err("[elf] Error: cannot map segment at 0x%lx", vaddr);
+                pt_destroy(pml4);
+                pm_free_process(proc);
                 return NULL;
             }
         }
@@ -115,22 +190,25 @@ process_t *elf_load(const uint8_t *binary_data, size_t size) {
     proc->heap_end = proc->heap_start + 0x1000000;
     
     /* Setup initial stack */
-    proc->stack_top = 0x20000000 - 0x1000;  /* Arbitrary top, growing down */
+    if (elf_map_stack(pml4) < 0) {
+        klog_err("[elf] Error: cannot map user stack");
+        pt_destroy(pml4);
+        pm_free_process(proc);
+        return NULL;
+    }
+    proc->stack_top = USER_STACK_TOP;
     
     /* register process with process manager (takes ownership) */
     extern uint64_t pm_register_process(process_t *proc);
-    /* Create a per-process page table by cloning current kernel PML4 */
-    extern void *pt_clone_for_cow(void *parent_pml4);
-    void *pml4 = pt_clone_for_cow(pt_get_kernel_pml4());
-    proc->page_table = (uint64_t *)pml4;
-
     pm_register_process(proc);
 
-    serial_puts("[elf] Process loaded: pid=");
-    serial_put_hex(proc->pid);
-    serial_puts(" entry=0x");
-    serial_put_hex(proc->entry_point);
-    serial_putc('\n');
+    /* registration resets page_table, hence the order */
+    proc->page_table = (uint64_t *)pml4;
+    proc->flags |= PF_IMAGE;
+    if (vdso_map(pml4) < 0)
+        klog_warn("[elf] Warning: cannot map vDSO");
+
+    klog_info("[elf] Process loaded: pid=%lu entry=0x%lx", proc->pid, proc->entry_point);
     
     return proc;
 }
@@ -141,14 +219,14 @@ process_t *elf_load(const uint8_t *binary_data, size_t size) {
 int elf_exec(process_t *proc, char **argv, char **envp) {
     if (!proc) return -1;
     
-    serial_puts("[elf] Executing process (TODO: jump to ring-3)\n");
+    klog_debug("[elf] Executing process (TODO: jump to ring-3)");
     
-    /* For Phase 1 we'll perform a minimal ring-3 transition using identity
-     * mapped memory: we assume user code and user stack are mapped in the
-     * current address space (this is true for the current identity mapping).
+    /* For Phase 1 we'll perform a minimal ring-3 transition: elf_load
+     * mapped the user code and user stack in proc's own page table, which
+     * is loaded right before dropping to ring 3.
      *
      * Steps:
-     * 1) Allocate a user stack region (virtual_memory_alloc)
+     * 1) Take the user stack elf_load mapped below USER_STACK_TOP
      * 2) Align the stack and prepare initial register frame if needed
      * 3) Push SS, RSP, RFLAGS, CS, RIP and execute iretq to drop to ring-3
      *
@@ -156,21 +234,13 @@ int elf_exec(process_t *proc, char **argv, char **envp) {
      * should create per-process page tables and TSS.
      */
 
-    /* Allocate user stack (64 KB) */
-    uint64_t stack_size = 64 * 1024;
-    uint64_t user_stack = (uint64_t)virtual_memory_alloc(0, stack_size, PROT_READ | PROT_WRITE);
-    if (!user_stack) {
-        serial_puts("[elf] Error: cannot allocate user stack\n");
-        return -1;
-    }
-
     /* Set stack top (grow down) and align to 16 bytes */
-    uint64_t user_sp = (user_stack + stack_size) & ~0xFULL;
+    uint64_t user_sp = USER_STACK_TOP & ~0xFULL;
     proc->stack_top = user_sp;
 
     /* User selectors (as configured in gdt.c): */
-    const uint64_t USER_CS = 0x1B; /* selector for user code (index 3 << 3 | RPL=3) */
-    const uint64_t USER_SS = 0x23; /* selector for user data (index 4 << 3 | RPL=3) */
+    const uint64_t USER_CS = 0x23; /* selector for user code (index 4 << 3 | RPL=3) */
+    const uint64_t USER_SS = 0x1B; /* selector for user data (index 3 << 3 | RPL=3) */
 
     /* Make sure interrupts are disabled while preparing iret frame */
     asm volatile("cli");
@@ -181,7 +251,6 @@ int elf_exec(process_t *proc, char **argv, char **envp) {
     uint64_t rip = proc->entry_point;
 
     /* Switch to the process's page table before entering user-mode */
-    extern void pt_set_cr3(void *p);
     if (proc->page_table) {
         pt_set_cr3((void *)proc->page_table);
     }
@@ -208,11 +277,53 @@ int elf_exec(process_t *proc, char **argv, char **envp) {
     return 0;
 }
 
+/* Spawn: build a new process straight from an ELF image and queue it to
+ * run in ring 3, leaving the caller running. Unlike fork+exec the caller's
+ * page tables are never walked or write-protected, so spawn cost does not
+ * grow with the parent's heap and the parent takes no COW faults afterwards.
+ * The child inherits the parent's open descriptors.
+ */
+process_t *elf_spawn(const uint8_t *binary_data, size_t size, process_t *parent) {
+    process_t *proc = elf_load(binary_data, size);
+    if (!proc) return NULL;
+
+    extern void pm_reap(process_t *p);
+    extern int task_start_user(process_t *proc, uint64_t user_sp);
+
+    if (parent) {
+        proc->cpus_allowed = parent->cpus_allowed;
+        extern void fs_incref(int fd);
+        for (int i = 0; i < 16; ++i) {
+            proc->fds[i] = parent->fds[i];
+            if (proc->fds[i] >= 0) fs_incref(proc->fds[i]);
+        }
+    }
+
+    if (task_start_user(proc, USER_STACK_TOP) < 0) {
+        klog_err("[elf] Error: cannot start spawned process pid=%lu", proc->pid);
+        extern void fs_decref(int fd);
+        for (int i = 0; i < 16; ++i)
+            if (proc->fds[i] >= 0) fs_decref(proc->fds[i]);
+        proc->state = 3;
+        pm_reap(proc);
+        return NULL;
+    }
+    trace_sched(TRACE_FORK, parent ? parent->pid : 0, proc->pid);
+    return proc;
+}
+
+void elf_free_image(void *pml4) {
+    /* segment and stack frames, then the tables */
+    extern void sched_forget_mm(void *pml4);
+    sched_forget_mm(pml4);
+    pt_destroy(pml4);
+}
+
 /* Free process resources */
 void elf_free_process(process_t *proc) {
-    if (!proc) return;
-    
-    /* TODO: Free page tables, heap, stack */
-    /* (no-op for bump allocator) */
+    if (!proc || !(proc->flags & PF_IMAGE)) return;
+    elf_free_image(proc->page_table);
+    proc->page_table = NULL;
+    proc->flags &= ~PF_IMAGE;
 }
 
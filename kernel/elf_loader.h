@@ -8,6 +8,8 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "rcu.h"
+#include "scheduler/deadline.h"
 
 /* ELF Header constants */
 #define EI_MAG0        0
@@ -33,6 +35,13 @@
 #define PT_LOAD        1
 #define PT_DYNAMIC     3
 
+#define ELF_PF_W       0x2  /* p_flags: writable segment */
+
+/* User stack of every loaded image: private frames right below the top
+   of the lower half (PML4 slot 255, above the vDSO) */
+#define USER_STACK_TOP  0x00007FFFFFFFF000ULL
+#define USER_STACK_SIZE (64 * 1024)
+
 /* ELF64 structures */
 typedef struct {
     uint8_t  e_ident[16];
@@ -63,7 +72,7 @@ typedef struct {
 } elf64_phdr_t;
 
 /* Process control block (simplified) */
-typedef struct {
+typedef struct process {
     uint64_t pid;
     uint64_t entry_point;      /* Entry point (e_entry) */
     uint64_t heap_start;
@@ -76,8 +85,33 @@ typedef struct {
     int      state;            /* 0=new, 1=running, 2=sleeping, 3=dead */
     int      fork_ret;         /* if non-zero, indicates value to return from fork in child */
     int      exit_code;        /* exit status for process */
+    uint64_t cpu_tsc;          /* CPU time consumed, in TSC cycles */
+    void    *fpu_state;        /* XSAVE/FXSAVE area, allocated on first FPU use */
+    uint64_t kstack_top;       /* TSS.RSP0 while running (ring-3 tasks), 0 = kernel task */
+    int      flags;            /* PF_* ownership/lifetime flags */
+    int      on_rq;            /* linked on the scheduler's run list */
+    struct process *run_next;  /* scheduler run list (circular) */
+    struct process *run_prev;
+    struct process *pm_next;   /* process registry (process_manager.c) */
+    struct process *pm_prev;
+    rcu_head_t rcu;            /* deferred PCB free after pm_reap */
+    struct mm *mm;             /* shared address space (threads), NULL until first clone(CLONE_VM) */
+    uint64_t tgid;             /* thread group (pid of the first thread), 0 = own pid */
+    uint64_t fs_base;          /* TLS bases loaded on switch */
+    uint64_t gs_base;
+    uint64_t cpus_allowed;     /* affinity, bit n = CPU n (0 = default mask when queued) */
+    int      cpu;              /* CPU it is queued on, -1 = no allowed CPU online */
+    sched_dl_t dl;             /* deadline class state (scheduler/deadline.h) */
+    int      gang;             /* co-scheduling group id, 0 = none */
+    struct uring *uring;       /* batched syscall rings (uring.h), NULL = none */
 } process_t;
 
+/* process_t.flags */
+#define PF_SLAB     0x1        /* PCB came from the process cache (pm_alloc_process) */
+#define PF_KSTACK   0x2        /* stack_base came from the scheduler's kernel stack cache */
+#define PF_AUTOREAP 0x4        /* nobody waits for it: reap as soon as it dies */
+#define PF_IMAGE    0x8        /* page_table holds its own frame references (elf_load, fork) */
+
 /* Validate ELF header */
 int elf_validate(const elf64_hdr_t *hdr);
 
@@ -91,7 +125,20 @@ process_t *elf_load(const uint8_t *binary_data, size_t size);
  */
 int elf_exec(process_t *proc, char **argv, char **envp);
 
-/* Free process resources */
+/* Create a new process from an ELF image and queue it to run in ring 3
+ * (posix_spawn-style: no fork, no COW of the caller's address space).
+ * The child inherits parent's descriptors and CPU affinity; parent may
+ * be NULL.
+ * Returns the child (wait for it with sys_wait) or NULL.
+ */
+process_t *elf_spawn(const uint8_t *binary_data, size_t size, process_t *parent);
+
+/* Release the address space of a process that owns it (PF_IMAGE: built
+   by elf_load or fork) at pm_reap */
 void elf_free_process(process_t *proc);
 
+/* Tear down a private address space: its user frames, tables and PML4.
+   Used by elf_free_process and by the last mm_put of a thread group. */
+void elf_free_image(void *pml4);
+
 #endif /* ELF_LOADER_H */
@@ -0,0 +1,89 @@
+/* kernel/fpu_bench.c
+ * Context-switch cost with lazy FPU switching (build with -DRUN_FPU_BENCH).
+ * Two tasks ping-pong through scheduler_yield as in yield_bench. In the
+ * integer phase neither touches vector registers, so a switch only costs
+ * the CR0.TS toggle. In the vector phase both tasks use AVX (SSE if AVX
+ * is not enabled) every round, so each switch also pays the #NM trap and
+ * an XSAVE/XRSTOR of the full area.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "arch/x86/cpu.h"
+#include "arch/x86/fpu.h"
+#include "scheduler/preemptive.h"
+
+#define ROUNDS 10000
+
+static volatile int turn = 0;     /* 0 = ping's turn, 1 = pong's turn */
+static volatile int use_vec = 0;
+static volatile int bench_done = 0;
+static int have_avx = 0;
+
+/* Dirty the vector state the way a user task would. The kernel is built
+   with -mgeneral-regs-only, hence inline asm. */
+static inline void touch_vec(void) {
+    if (have_avx)
+        asm volatile ("vpaddq %%ymm1, %%ymm0, %%ymm0" ::: "memory");
+    else
+        asm volatile ("paddq %%xmm1, %%xmm0" ::: "memory");
+}
+
+static void report(const char *name, uint64_t total, uint64_t traps) {
+    serial_puts("[fpu_bench] ");
+    serial_puts(name);
+    serial_puts(": rounds=");
+    serial_put_dec(ROUNDS);
+    serial_puts(" per_switch_cycles=");
+    serial_put_dec(total / ROUNDS / 2);
+    serial_puts(" nm_traps=");
+    serial_put_dec(traps);
+    serial_putc('\n');
+}
+
+static uint64_t run_rounds(void) {
+    uint64_t t0 = rdtsc();
+    for (int i = 0; i < ROUNDS; i++) {
+        if (use_vec) touch_vec();
+        turn = 1;
+        while (turn != 0) scheduler_yield();
+    }
+    return rdtsc() - t0;
+}
+
+static void ping_task(void) {
+    static const char *methods[] = { "fxsave", "xsave", "xsaveopt", "xsaves" };
+    have_avx = (fpu_xfeatures() & (1ULL << 2)) != 0;
+    serial_puts("[fpu_bench] save=");
+    serial_puts(methods[fpu_save_method()]);
+    serial_puts(" area_bytes=");
+    serial_put_dec(fpu_state_size());
+    serial_puts(have_avx ? " vector=avx\n" : " vector=sse\n");
+
+    uint64_t traps0 = fpu_trap_count();
+    use_vec = 0;
+    uint64_t total = run_rounds();
+    report("integer tasks", total, fpu_trap_count() - traps0);
+
+    traps0 = fpu_trap_count();
+    use_vec = 1;
+    total = run_rounds();
+    report(have_avx ? "avx tasks" : "sse tasks", total, fpu_trap_count() - traps0);
+
+    bench_done = 1;
+    serial_puts("[fpu_bench] done\n");
+}
+
+static void pong_task(void) {
+    while (!bench_done) {
+        while (turn != 1 && !bench_done) scheduler_yield();
+        if (use_vec) touch_vec();
+        turn = 0;
+    }
+}
+
+void fpu_bench(void) {
+    serial_puts("[fpu_bench] creating ping/pong tasks\n");
+    task_create(ping_task);
+    task_create(pong_task);
+}
@@ -0,0 +1,136 @@
+/* kernel/futex.c - futex wait/wake on hashed physical-address queues */
+#include "futex.h"
+#include "elf_loader.h"
+#include "mm/pagetable.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "arch/x86/uaccess.h"
+#include <stddef.h>
+
+#define FUTEX_HASH_SIZE (1u << FUTEX_HASH_BITS)
+
+/* One sleeping task. It lives on the sleeper's kernel stack: it is
+   unlinked (by a waker or the timeout) before futex_wait returns. */
+typedef struct futex_waiter {
+    struct futex_waiter *next;
+    uint64_t key;
+    process_t *task;
+    int woken;
+    int timed_out;
+} futex_waiter_t;
+
+/* FIFO per bucket so FUTEX_WAKE(1) hands the lock to the oldest sleeper.
+   The buckets are guarded by irq_save: only the boot CPU schedules. */
+typedef struct futex_bucket {
+    futex_waiter_t *head;
+    futex_waiter_t **tail;
+} futex_bucket_t;
+
+static futex_bucket_t buckets[FUTEX_HASH_SIZE];
+
+static futex_bucket_t *bucket_of(uint64_t key) {
+    /* words on one page differ in bits 2..11; fold the frame number in */
+    uint64_t h = (key >> 2) * 0x9E3779B97F4A7C15ULL;
+    futex_bucket_t *b = &buckets[h >> (64 - FUTEX_HASH_BITS)];
+    if (!b->tail) b->tail = &b->head;
+    return b;
+}
+
+static void bucket_unlink(futex_bucket_t *b, futex_waiter_t *w) {
+    for (futex_waiter_t **pp = &b->head; *pp; pp = &(*pp)->next) {
+        if (*pp == w) {
+            *pp = w->next;
+            if (b->tail == &w->next) b->tail = pp;
+            w->next = NULL;
+            return;
+        }
+    }
+}
+
+uint64_t futex_key(uint64_t uaddr) {
+    extern process_t *pm_get_current(void);
+    process_t *cur = pm_get_current();
+    void *pml4 = (cur && cur->page_table) ? cur->page_table : pt_get_kernel_pml4();
+    uint64_t pa = pt_virt_to_phys(pml4, uaddr);
+    return pa == PT_NO_PHYS ? 0 : pa;
+}
+
+static void futex_timeout(void *arg) {
+    extern void sched_wake(process_t *p);
+    futex_waiter_t *w = (futex_waiter_t *)arg;
+    if (w->woken) return;
+    bucket_unlink(bucket_of(w->key), w);
+    w->timed_out = 1;
+    sched_wake(w->task);
+}
+
+int64_t futex_wait(uint64_t uaddr, uint32_t val, uint64_t timeout_ns) {
+    extern process_t *pm_get_current(void);
+    extern void scheduler_yield(void);
+    process_t *cur = pm_get_current();
+    if (!cur || (uaddr & 3) || !access_ok((const void *)uaddr, 4)) return -1;
+    uint64_t key = futex_key(uaddr);
+    if (!key) return -1;
+
+    futex_waiter_t w = { NULL, key, cur, 0, 0 };
+    timer_event_t ev;
+    ev.heap_idx = -1;
+
+    uint64_t flags = irq_save();
+    /* Compare under the bucket lock: a waker that changed the word after
+       this read has to take the lock too, so it finds us queued */
+    uint32_t now;
+    if (copy_from_user(&now, (const void *)uaddr, 4)) {
+        irq_restore(flags);
+        return -1;
+    }
+    if (now != val) {
+        irq_restore(flags);
+        return FUTEX_EAGAIN;
+    }
+
+    futex_bucket_t *b = bucket_of(key);
+    *b->tail = &w;
+    b->tail = &w.next;
+    /* without its timer the wait could last forever: back out */
+    if (timeout_ns && timer_add(&ev, rdtsc() + timer_ns_to_tsc(timeout_ns), futex_timeout, &w) < 0) {
+        bucket_unlink(b, &w);
+        irq_restore(flags);
+        return FUTEX_ENOMEM;
+    }
+
+    while (!w.woken && !w.timed_out) {
+        cur->state = 2; /* sleeping */
+        scheduler_yield();
+    }
+    if (timeout_ns) timer_cancel(&ev);
+    irq_restore(flags);
+    return w.woken ? 0 : FUTEX_ETIMEDOUT;
+}
+
+int64_t futex_wake(uint64_t uaddr, uint32_t n) {
+    extern void sched_wake(process_t *p);
+    if ((uaddr & 3) || !access_ok((const void *)uaddr, 4)) return -1;
+    uint64_t key = futex_key(uaddr);
+    if (!key) return -1;
+
+    uint64_t flags = irq_save();
+    futex_bucket_t *b = bucket_of(key);
+    int64_t woken = 0;
+    futex_waiter_t **pp = &b->head;
+    while (*pp && (uint32_t)woken < n) {
+        futex_waiter_t *w = *pp;
+        if (w->key != key) {
+            pp = &w->next;
+            continue;
+        }
+        *pp = w->next;
+        if (b->tail == &w->next) b->tail = pp;
+        w->next = NULL;
+        w->woken = 1;
+        sched_wake(w->task);
+        woken++;
+    }
+    irq_restore(flags);
+    return woken;
+}
@@ -0,0 +1,36 @@
+/* kernel/futex.h
+ * Fast user-space locking support. A futex is any aligned 32-bit word in
+ * user memory. Lock libraries change it with atomic instructions and only
+ * enter the kernel to sleep when the word says the lock is contended
+ * (FUTEX_WAIT) or to wake sleepers after releasing it (FUTEX_WAKE), so
+ * uncontended lock/unlock never makes a syscall.
+ *
+ * Waiters are queued by the physical address of the word, not the
+ * virtual one: threads, processes sharing a page and a COW-shared page
+ * seen by parent and child all meet on the same queue however the page
+ * is mapped in each address space.
+ */
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <stdint.h>
+
+/* SYS_FUTEX operations */
+#define FUTEX_WAIT 0   /* sleep if *uaddr == val; arg = timeout in ns, 0 = none */
+#define FUTEX_WAKE 1   /* wake up to val waiters; returns how many were woken */
+
+/* Errors returned besides -1 (bad address or op) */
+#define FUTEX_EAGAIN    (-11)   /* *uaddr != val: did not sleep */
+#define FUTEX_ETIMEDOUT (-110)  /* timeout expired before a wake */
+#define FUTEX_ENOMEM    (-12)   /* no timer for the timeout: did not sleep */
+
+#define FUTEX_HASH_BITS 8
+
+/* SYS_FUTEX entry points, for the current task's address space */
+int64_t futex_wait(uint64_t uaddr, uint32_t val, uint64_t timeout_ns);
+int64_t futex_wake(uint64_t uaddr, uint32_t n);
+
+/* Queue key (physical address of uaddr), 0 if uaddr is not mapped */
+uint64_t futex_key(uint64_t uaddr);
+
+#endif /* FUTEX_H */
@@ -0,0 +1,30 @@
+/* kernel/futex_bench.c
+ * Futex mutex/condvar contention (build with -DRUN_FUTEX_BENCH). Spawns
+ * user/futex_bench, which runs 1-16 threads against one futex-based
+ * mutex and one condition variable and logs cycles per operation and
+ * SYS_FUTEX calls; its exit code says whether every count was right.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+#include "syscall.h"
+#include "user_futex_bench_bin.h"
+
+static void futex_bench_task(void) {
+    process_t *child = elf_spawn(build_user_futex_bench_elf,
+                                 build_user_futex_bench_elf_len, pm_get_current());
+    if (!child) {
+        serial_puts("[futex_bench] cannot spawn user/futex_bench\n");
+        return;
+    }
+    int code = sys_wait((int)child->pid);
+    serial_puts(code == 0 ? "[futex_bench] counts ok\n" : "[futex_bench] counts WRONG\n");
+    serial_puts("[futex_bench] done\n");
+}
+
+void futex_bench(void) {
+    serial_puts("[futex_bench] creating benchmark task\n");
+    task_create(futex_bench_task);
+}
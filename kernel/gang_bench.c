@@ -0,0 +1,105 @@
+/* kernel/gang_bench.c
+ * Gang scheduling benchmark (build with -DRUN_GANG_BENCH). A 4-stage
+ * pipeline does a fixed amount of work per step and meets at a barrier
+ * after every step, while four CPU-bound tasks compete for the CPU. The
+ * pipeline runs once as ordinary tasks and once as a gang; each run
+ * reports steps per second and the mean time per step.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+#define STAGES   4
+#define NOISE    4
+#define STEPS    200
+#define WORK_NS  100000ULL      /* per stage and step */
+#define MS 1000000ULL
+
+static volatile int gang_id = 0;
+static volatile int arrived = 0;
+static volatile int barrier_sense = 0;
+static volatile int stages_done = 0;
+static volatile int noise_stop = 0;
+static volatile uint64_t act[STAGES];   /* "activations" handed down the pipeline */
+
+/* Sense-reversing barrier; waiters give the CPU away instead of spinning */
+static void barrier(int *sense) {
+    *sense = !*sense;
+    if (__atomic_add_fetch(&arrived, 1, __ATOMIC_SEQ_CST) == STAGES) {
+        arrived = 0;
+        __atomic_store_n(&barrier_sense, *sense, __ATOMIC_SEQ_CST);
+    } else {
+        while (barrier_sense != *sense)
+            scheduler_yield();
+    }
+}
+
+static volatile int next_stage = 0;
+
+static void stage_task(void) {
+    int me = __atomic_fetch_add(&next_stage, 1, __ATOMIC_SEQ_CST);
+    int sense = barrier_sense;
+    if (gang_id) sched_gang_join(pm_get_current(), gang_id);
+
+    uint64_t work = timer_ns_to_tsc(WORK_NS);
+    for (int step = 0; step < STEPS; step++) {
+        uint64_t in = me ? act[me - 1] : (uint64_t)step;
+        uint64_t t0 = rdtsc();
+        while (rdtsc() - t0 < work)
+            asm volatile ("pause");
+        barrier(&sense);
+        act[me] = in + 1;
+        barrier(&sense);
+    }
+    __atomic_fetch_add(&stages_done, 1, __ATOMIC_SEQ_CST);
+}
+
+static void noise_task(void) {
+    while (!noise_stop)
+        asm volatile ("pause");
+}
+
+static void run(int gang) {
+    gang_id = gang ? sched_gang_create(0) : 0;
+    stages_done = 0;
+    next_stage = 0;
+
+    uint64_t t0 = rdtsc();
+    for (int i = 0; i < STAGES; i++)
+        task_create(stage_task);
+    while (stages_done < STAGES)
+        timer_sleep_ns(1 * MS);
+    uint64_t ns = timer_tsc_to_ns(rdtsc() - t0);
+
+    serial_puts("[gang_bench] ");
+    serial_puts(gang ? "gang" : "no-gang");
+    serial_puts(": steps_per_sec=");
+    serial_put_dec((uint64_t)STEPS * 1000000000ULL / ns);
+    serial_puts(" us_per_step=");
+    serial_put_dec(ns / STEPS / 1000);
+    if (gang) {
+        serial_puts(" slots=");
+        serial_put_dec(sched_gang_slots(gang_id));
+    }
+    serial_putc('\n');
+}
+
+static void gang_bench_task(void) {
+    for (int i = 0; i < NOISE; i++)
+        task_create(noise_task);
+
+    run(0);
+    run(1);
+
+    noise_stop = 1;
+    serial_puts("[gang_bench] done\n");
+}
+
+void gang_bench(void) {
+    serial_puts("[gang_bench] creating pipeline + noise tasks\n");
+    task_create(gang_bench_task);
+}
@@ -0,0 +1,382 @@
+/* kernel/ipc/channel.c - named SPSC and MPMC message rings
+ *
+ * Positions are free-running uint32_t counters; a cell is
+ * cells[pos & mask].
+ *
+ * SPSC: tail belongs to the producer and head to the consumer; each is
+ * published with a release store and read with an acquire load by the
+ * other side, and only when its cached copy says the ring looks full
+ * (producer) or empty (consumer).
+ *
+ * MPMC: a cell whose seq equals pos is free for the producer that takes
+ * pos; once written its seq becomes pos + 1, which marks it ready for
+ * the consumer that takes pos. Reading it sets seq to pos + capacity,
+ * free again one lap later. Taking a position is a CAS on tail or head,
+ * so a batch claims k consecutive cells with one CAS.
+ *
+ * A receiver that finds the ring empty queues itself on the channel (a
+ * node on its stack, as futex.c does) and sleeps; senders look at
+ * nwaiters after publishing and wake the oldest sleeper. This is a
+ * store-then-load on each side, so each needs a SEQ_CST operation
+ * between the two. The receiver bumps nwaiters, fences and then compares
+ * tail with head. The sender's SEQ_CST step is the locked instruction it
+ * needs anyway: the SEQ_CST store of tail (SPSC, an xchg) or the claim CAS
+ * on tail (MPMC). It reads nwaiters after that step. So either the
+ * receiver sees the new tail or the sender sees the waiter, on any
+ * number of CPUs, and a send adds no fence. An MPMC tail can run ahead
+ * of a cell that is still being written. A receiver that sees such a
+ * claim stays awake and lets the sender finish.
+ */
+#include "channel.h"
+#include <stddef.h>
+
+extern void *memcpy(void *dst, const void *src, size_t n);
+
+typedef uint64_t __attribute__((may_alias, aligned(1))) u64_u;
+
+/* Most messages are short. 8 to 32 bytes move as two or four
+   overlapping words rather than through an out-of-line memcpy, which
+   costs more than the ring update itself. */
+static inline void msg_copy(void *dst, const void *src, uint32_t n) {
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+    if (n < 8 || n > 32) {
+        memcpy(d, s, n);
+        return;
+    }
+    uint64_t a = *(const u64_u *)s, b = *(const u64_u *)(s + n - 8);
+    if (n > 16) {
+        uint64_t c = *(const u64_u *)(s + 8), e = *(const u64_u *)(s + n - 16);
+        *(u64_u *)(d + 8) = c;
+        *(u64_u *)(d + n - 16) = e;
+    }
+    *(u64_u *)d = a;
+    *(u64_u *)(d + n - 8) = b;
+}
+
+/* Channel creation and the wait queues are guarded by irq_save: only
+   the boot CPU schedules. The host tests build this without cpu.h. */
+#ifdef HOST_TEST
+#define chan_lock()        0
+#define chan_unlock(flags) ((void)(flags))
+#else
+#include "../arch/x86/cpu.h"
+#include "../elf_loader.h"
+#define chan_lock()        irq_save()
+#define chan_unlock(flags) irq_restore(flags)
+#endif
+
+typedef struct ipc_waiter {
+    struct ipc_waiter *next;
+    void *task;
+    int woken;
+} ipc_waiter_t;
+
+static ipc_chan_t chans[IPC_CHAN_MAX];
+static uint32_t nchans;
+static ipc_cell_t arena[IPC_CHAN_CELLS] __attribute__((aligned(64)));
+static uint32_t arena_used;
+
+static int name_eq(const char *a, const char *b) {
+    for (int i = 0; i < IPC_CHAN_NAME; i++) {
+        if (a[i] != b[i]) return 0;
+        if (!a[i]) return 1;
+    }
+    return 1;
+}
+
+ipc_chan_t *ipc_chan_find(const char *name) {
+    uint32_t n = __atomic_load_n(&nchans, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < n; i++)
+        if (name_eq(chans[i].name, name)) return &chans[i];
+    return NULL;
+}
+
+ipc_chan_t *ipc_chan_open(const char *name, int type, uint32_t capacity) {
+    if (!name || !name[0] || (type != IPC_CHAN_SPSC && type != IPC_CHAN_MPMC) ||
+        !capacity || capacity > IPC_CHAN_CELLS)
+        return NULL;
+
+    uint64_t flags = chan_lock();
+    ipc_chan_t *ch = ipc_chan_find(name);
+    if (ch) {
+        chan_unlock(flags);
+        return ch->type == type ? ch : NULL;
+    }
+    uint32_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    if (nchans == IPC_CHAN_MAX || IPC_CHAN_CELLS - arena_used < cap) {
+        chan_unlock(flags);
+        return NULL;
+    }
+
+    ch = &chans[nchans];
+    int i;
+    for (i = 0; i < IPC_CHAN_NAME - 1 && name[i]; i++) ch->name[i] = name[i];
+    ch->name[i] = 0;
+    ch->type = type;
+    ch->cells = &arena[arena_used];
+    ch->mask = cap - 1;
+    ch->head = ch->tail = ch->head_cache = ch->tail_cache = 0;
+    ch->nwaiters = 0;
+    ch->wait_head = NULL;
+    ch->wait_tail = &ch->wait_head;
+    for (uint32_t c = 0; c < cap; c++) ch->cells[c].seq = c;
+    arena_used += cap;
+    /* publishes the channel to lock-free ipc_chan_find */
+    __atomic_store_n(&nchans, nchans + 1, __ATOMIC_RELEASE);
+    chan_unlock(flags);
+    return ch;
+}
+
+/* ---- SPSC ---- */
+
+static uint32_t spsc_space(ipc_chan_t *ch, uint32_t t, uint32_t want) {
+    uint32_t cap = ch->mask + 1;
+    if (cap - (t - ch->head_cache) < want)
+        ch->head_cache = __atomic_load_n(&ch->head, __ATOMIC_ACQUIRE);
+    return cap - (t - ch->head_cache);
+}
+
+static uint32_t spsc_ready(ipc_chan_t *ch, uint32_t h, uint32_t want) {
+    if (ch->tail_cache - h < want)
+        ch->tail_cache = __atomic_load_n(&ch->tail, __ATOMIC_ACQUIRE);
+    return ch->tail_cache - h;
+}
+
+/* ---- MPMC ---- */
+
+/* Claim up to n free cells; returns how many, first position in *pos */
+static uint32_t mpmc_claim_send(ipc_chan_t *ch, uint32_t n, uint32_t *pos) {
+    uint32_t p = __atomic_load_n(&ch->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        uint32_t k = 0;
+        while (k < n && __atomic_load_n(&ch->cells[(p + k) & ch->mask].seq, __ATOMIC_ACQUIRE) == p + k) k++;
+        if (!k) {
+            int32_t dif = (int32_t)(__atomic_load_n(&ch->cells[p & ch->mask].seq, __ATOMIC_ACQUIRE) - p);
+            if (dif < 0) return 0;                      /* full */
+            p = __atomic_load_n(&ch->tail, __ATOMIC_RELAXED);
+            continue;                                   /* another producer got there first */
+        }
+        /* SEQ_CST: orders chan_wake's nwaiters load after the claim */
+        if (__atomic_compare_exchange_n(&ch->tail, &p, p + k, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            *pos = p;
+            return k;
+        }
+    }
+}
+
+/* Claim up to n ready cells; returns how many, first position in *pos */
+static uint32_t mpmc_claim_recv(ipc_chan_t *ch, uint32_t n, uint32_t *pos) {
+    uint32_t p = __atomic_load_n(&ch->head, __ATOMIC_RELAXED);
+    for (;;) {
+        uint32_t k = 0;
+        while (k < n && __atomic_load_n(&ch->cells[(p + k) & ch->mask].seq, __ATOMIC_ACQUIRE) == p + k + 1) k++;
+        if (!k) {
+            int32_t dif = (int32_t)(__atomic_load_n(&ch->cells[p & ch->mask].seq, __ATOMIC_ACQUIRE) - (p + 1));
+            if (dif < 0) return 0;                      /* empty */
+            p = __atomic_load_n(&ch->head, __ATOMIC_RELAXED);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&ch->head, &p, p + k, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *pos = p;
+            return k;
+        }
+    }
+}
+
+/* ---- sleeping receivers ---- */
+
+static int chan_has_data(ipc_chan_t *ch) {
+    uint32_t h = __atomic_load_n(&ch->head, __ATOMIC_ACQUIRE);
+    if (ch->type == IPC_CHAN_SPSC) return __atomic_load_n(&ch->tail, __ATOMIC_ACQUIRE) != h;
+    return __atomic_load_n(&ch->cells[h & ch->mask].seq, __ATOMIC_ACQUIRE) == h + 1;
+}
+
+#ifndef HOST_TEST
+/* A sender has taken a position no receiver has taken yet; for MPMC the
+   cell may still be being written */
+static int chan_claimed(ipc_chan_t *ch) {
+    uint32_t h = __atomic_load_n(&ch->head, __ATOMIC_ACQUIRE);
+    return __atomic_load_n(&ch->tail, __ATOMIC_ACQUIRE) != h;
+}
+#endif
+
+/* The sender's SEQ_CST store or CAS on tail comes first; this load and
+   the nwaiters increment, fence and chan_claimed in chan_wait form the
+   two halves of the handshake */
+static void chan_wake(ipc_chan_t *ch) {
+    if (!__atomic_load_n(&ch->nwaiters, __ATOMIC_SEQ_CST)) return;
+#ifndef HOST_TEST
+    extern void sched_wake(process_t *p);
+    uint64_t flags = chan_lock();
+    ipc_waiter_t *w = ch->wait_head;
+    if (w) {
+        ch->wait_head = w->next;
+        if (!ch->wait_head) ch->wait_tail = &ch->wait_head;
+        __atomic_fetch_sub(&ch->nwaiters, 1, __ATOMIC_RELAXED);
+        w->woken = 1;
+        sched_wake((process_t *)w->task);
+    }
+    chan_unlock(flags);
+#endif
+}
+
+/* Return once the ring has (or had) a message for this receiver */
+static void chan_wait(ipc_chan_t *ch) {
+#ifdef HOST_TEST
+    extern int sched_yield(void);
+    __atomic_fetch_add(&ch->nwaiters, 1, __ATOMIC_SEQ_CST);
+    while (!chan_has_data(ch)) sched_yield();
+    __atomic_fetch_sub(&ch->nwaiters, 1, __ATOMIC_RELAXED);
+#else
+    extern process_t *pm_get_current(void);
+    extern void scheduler_yield(void);
+    process_t *cur = pm_get_current();
+    if (!cur) {                         /* boot context: nothing to switch to */
+        while (!chan_has_data(ch)) __builtin_ia32_pause();
+        return;
+    }
+    ipc_waiter_t w = { NULL, cur, 0 };
+    int claimed = 0;
+    uint64_t flags = chan_lock();
+    *ch->wait_tail = &w;
+    ch->wait_tail = &w.next;
+    __atomic_fetch_add(&ch->nwaiters, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (chan_claimed(ch)) {
+        /* a sender moved tail before seeing us: leave the queue */
+        claimed = 1;
+        for (ipc_waiter_t **pp = &ch->wait_head; *pp; pp = &(*pp)->next) {
+            if (*pp == &w) {
+                *pp = w.next;
+                if (ch->wait_tail == &w.next) ch->wait_tail = pp;
+                __atomic_fetch_sub(&ch->nwaiters, 1, __ATOMIC_RELAXED);
+                w.woken = 1;
+                break;
+            }
+        }
+    }
+    while (!w.woken) {
+        cur->state = 2; /* sleeping */
+        scheduler_yield();
+    }
+    chan_unlock(flags);
+    /* the sender that claimed the cell is still filling it: let it run */
+    if (claimed && !chan_has_data(ch)) scheduler_yield();
+#endif
+}
+
+/* ---- API ---- */
+
+int ipc_chan_send(ipc_chan_t *ch, const void *data, uint32_t len) {
+    if (!ch || len > IPC_MSG_SIZE || (len && !data)) return -1;
+    uint32_t pos;
+    ipc_cell_t *c;
+    if (ch->type == IPC_CHAN_SPSC) {
+        pos = ch->tail;
+        if (!spsc_space(ch, pos, 1)) return -1;
+        c = &ch->cells[pos & ch->mask];
+        c->len = len;
+        msg_copy(c->data, data, len);
+        __atomic_store_n(&ch->tail, pos + 1, __ATOMIC_SEQ_CST);
+    } else {
+        if (!mpmc_claim_send(ch, 1, &pos)) return -1;
+        c = &ch->cells[pos & ch->mask];
+        c->len = len;
+        msg_copy(c->data, data, len);
+        __atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);
+    }
+    chan_wake(ch);
+    return 0;
+}
+
+int ipc_chan_send_batch(ipc_chan_t *ch, const ipc_msg_t *msgs, int n) {
+    if (!ch || !msgs || n <= 0) return 0;
+    uint32_t k = 0, pos;
+    while (k < (uint32_t)n && msgs[k].len <= IPC_MSG_SIZE) k++;   /* stop before a bad one */
+    if (!k) return 0;
+    if (ch->type == IPC_CHAN_SPSC) {
+        pos = ch->tail;
+        uint32_t space = spsc_space(ch, pos, k);
+        if (k > space) k = space;
+        for (uint32_t i = 0; i < k; i++) {
+            ipc_cell_t *c = &ch->cells[(pos + i) & ch->mask];
+            c->len = msgs[i].len;
+            msg_copy(c->data, msgs[i].data, msgs[i].len);
+        }
+        if (k) __atomic_store_n(&ch->tail, pos + k, __ATOMIC_SEQ_CST);
+    } else {
+        k = mpmc_claim_send(ch, k, &pos);
+        for (uint32_t i = 0; i < k; i++) {
+            ipc_cell_t *c = &ch->cells[(pos + i) & ch->mask];
+            c->len = msgs[i].len;
+            msg_copy(c->data, msgs[i].data, msgs[i].len);
+            __atomic_store_n(&c->seq, pos + i + 1, __ATOMIC_RELEASE);
+        }
+    }
+    if (k) chan_wake(ch);
+    return (int)k;
+}
+
+static int recv_one(ipc_chan_t *ch, void *buf, uint32_t buflen) {
+    uint32_t pos, len;
+    ipc_cell_t *c;
+    if (ch->type == IPC_CHAN_SPSC) {
+        pos = ch->head;
+        if (!spsc_ready(ch, pos, 1)) return -1;
+        c = &ch->cells[pos & ch->mask];
+        len = c->len;
+        msg_copy(buf, c->data, len < buflen ? len : buflen);
+        __atomic_store_n(&ch->head, pos + 1, __ATOMIC_RELEASE);
+    } else {
+        if (!mpmc_claim_recv(ch, 1, &pos)) return -1;
+        c = &ch->cells[pos & ch->mask];
+        len = c->len;
+        msg_copy(buf, c->data, len < buflen ? len : buflen);
+        __atomic_store_n(&c->seq, pos + ch->mask + 1, __ATOMIC_RELEASE);
+    }
+    return (int)len;
+}
+
+int ipc_chan_recv(ipc_chan_t *ch, void *buf, uint32_t buflen, int flags) {
+    if (!ch || (buflen && !buf)) return -1;
+    for (;;) {
+        int len = recv_one(ch, buf, buflen);
+        if (len >= 0 || (flags & IPC_NONBLOCK)) return len;
+        chan_wait(ch);
+    }
+}
+
+static uint32_t recv_batch(ipc_chan_t *ch, ipc_msg_t *msgs, uint32_t max) {
+    uint32_t k, pos;
+    if (ch->type == IPC_CHAN_SPSC) {
+        pos = ch->head;
+        k = spsc_ready(ch, pos, max);
+        if (k > max) k = max;
+        for (uint32_t i = 0; i < k; i++) {
+            ipc_cell_t *c = &ch->cells[(pos + i) & ch->mask];
+            msgs[i].len = c->len;
+            msg_copy(msgs[i].data, c->data, c->len);
+        }
+        if (k) __atomic_store_n(&ch->head, pos + k, __ATOMIC_RELEASE);
+    } else {
+        k = mpmc_claim_recv(ch, max, &pos);
+        for (uint32_t i = 0; i < k; i++) {
+            ipc_cell_t *c = &ch->cells[(pos + i) & ch->mask];
+            msgs[i].len = c->len;
+            msg_copy(msgs[i].data, c->data, c->len);
+            __atomic_store_n(&c->seq, pos + i + ch->mask + 1, __ATOMIC_RELEASE);
+        }
+    }
+    return k;
+}
+
+int ipc_chan_recv_batch(ipc_chan_t *ch, ipc_msg_t *msgs, int max, int flags) {
+    if (!ch || !msgs || max <= 0) return 0;
+    for (;;) {
+        uint32_t k = recv_batch(ch, msgs, (uint32_t)max);
+        if (k || (flags & IPC_NONBLOCK)) return (int)k;
+        chan_wait(ch);
+    }
+}
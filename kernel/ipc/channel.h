@@ -0,0 +1,90 @@
+/* kernel/ipc/channel.h
+ * Named message channels, each with its own bounded ring:
+ *
+ *   IPC_CHAN_SPSC  one producer, one consumer. Head and tail sit on
+ *                  separate cache lines and each side keeps a cached copy
+ *                  of the other's index, so a send or receive touches the
+ *                  shared line only when the cached view runs out.
+ *   IPC_CHAN_MPMC  any number of producers and consumers (fan-in, work
+ *                  queues). Bounded Vyukov queue: every cell carries a
+ *                  sequence number that says whose turn it is, so a send
+ *                  or receive is one CAS on its position and no side ever
+ *                  waits for another to finish.
+ *
+ * Neither takes a lock or masks interrupts on the fast path. Messages
+ * are copied into the ring, up to IPC_MSG_SIZE bytes each. Send never
+ * blocks (-1 when full); receive either fails when empty (IPC_NONBLOCK)
+ * or sleeps until a sender wakes it. The batch calls move several
+ * messages per index update.
+ *
+ * Channels live for the life of the kernel; ipc_send/ipc_recv
+ * (message.c) are a 32-slot MPMC channel named "ipc".
+ */
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <stdint.h>
+
+#define IPC_CHAN_SPSC  0
+#define IPC_CHAN_MPMC  1
+
+#define IPC_NONBLOCK   0x1      /* receive flags: fail instead of sleeping */
+
+#define IPC_MSG_SIZE     128    /* bytes per message */
+#define IPC_CHAN_MAX     16     /* named channels */
+#define IPC_CHAN_NAME    16
+#define IPC_CHAN_CELLS   2048   /* ring cells shared by all channels */
+
+typedef struct ipc_msg {
+    uint32_t len;
+    char data[IPC_MSG_SIZE];
+} ipc_msg_t;
+
+typedef struct ipc_cell {
+    uint32_t seq;               /* MPMC turn; unused by SPSC */
+    uint32_t len;
+    char data[IPC_MSG_SIZE];
+} ipc_cell_t;
+
+struct ipc_waiter;
+
+typedef struct ipc_chan {
+    /* producer side */
+    uint32_t tail __attribute__((aligned(64)));
+    uint32_t head_cache;                /* SPSC: producer's view of head */
+    /* consumer side */
+    uint32_t head __attribute__((aligned(64)));
+    uint32_t tail_cache;                /* SPSC: consumer's view of tail */
+    /* sleeping receivers */
+    uint32_t nwaiters __attribute__((aligned(64)));
+    struct ipc_waiter *wait_head, **wait_tail;
+    /* read-mostly */
+    ipc_cell_t *cells __attribute__((aligned(64)));
+    uint32_t mask;
+    int type;
+    char name[IPC_CHAN_NAME];
+} ipc_chan_t;
+
+/* Find the channel called name, or create it with room for capacity
+   messages (rounded up to a power of two). NULL if the name exists with
+   another type, or no channel or ring cells are left. */
+ipc_chan_t *ipc_chan_open(const char *name, int type, uint32_t capacity);
+
+/* Existing channel or NULL */
+ipc_chan_t *ipc_chan_find(const char *name);
+
+/* 0, or -1 if the ring is full or len > IPC_MSG_SIZE */
+int ipc_chan_send(ipc_chan_t *ch, const void *data, uint32_t len);
+
+/* Copy the oldest message into buf (at most buflen bytes) and return
+   its full length; -1 if empty and IPC_NONBLOCK is set */
+int ipc_chan_recv(ipc_chan_t *ch, void *buf, uint32_t buflen, int flags);
+
+/* Send as many of msgs[0..n) as fit, in order; returns how many */
+int ipc_chan_send_batch(ipc_chan_t *ch, const ipc_msg_t *msgs, int n);
+
+/* Receive up to max messages; without IPC_NONBLOCK waits for at least
+   one. Returns how many (0 only with IPC_NONBLOCK). */
+int ipc_chan_recv_batch(ipc_chan_t *ch, ipc_msg_t *msgs, int max, int flags);
+
+#endif /* CHANNEL_H */
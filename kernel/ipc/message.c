@@ -1,29 +1,30 @@
-/* kernel/ipc/message.c - simple in-kernel message queue (very small) */
+/* kernel/ipc/message.c - the original string queue, now the 32-slot MPMC
+   channel "ipc" (channel.c). Sends still fail when full and receives
+   when empty; strings are cut to MSG_SIZE - 1 bytes. */
 #include <stdint.h>
+#include "channel.h"
 
 #define MSG_MAX 32
 #define MSG_SIZE 128
 
-static char msgs[MSG_MAX][MSG_SIZE];
-static int head = 0, tail = 0, count = 0;
+static ipc_chan_t *default_chan(void) {
+    static ipc_chan_t *ch;
+    if (!ch) ch = ipc_chan_open("ipc", IPC_CHAN_MPMC, MSG_MAX);
+    return ch;
+}
 
 int ipc_send(const char *s) {
-    if (count >= MSG_MAX) return -1;
-    int idx = tail++;
-    if (tail >= MSG_MAX) tail = 0;
-    for (int i=0;i<MSG_SIZE-1 && s[i];i++) msgs[idx][i]=s[i];
-    msgs[idx][MSG_SIZE-1]=0;
-    count++;
-    return 0;
+    uint32_t n = 0;
+    while (n < MSG_SIZE - 1 && s[n]) n++;
+    return ipc_chan_send(default_chan(), s, n);
 }
 
 int ipc_recv(char *buf, int buflen) {
-    if (count == 0) return -1;
-    int idx = head++;
-    if (head >= MSG_MAX) head=0;
+    char msg[MSG_SIZE];
+    int n = ipc_chan_recv(default_chan(), msg, sizeof(msg), IPC_NONBLOCK);
+    if (n < 0) return -1;
     int i;
-    for (i=0; i<buflen-1 && msgs[idx][i]; i++) buf[i]=msgs[idx][i];
-    buf[i]=0;
-    count--;
+    for (i = 0; i < buflen - 1 && i < n; i++) buf[i] = msg[i];
+    buf[i] = 0;
     return 0;
 }
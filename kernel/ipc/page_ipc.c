@@ -0,0 +1,152 @@
+/* kernel/ipc/page_ipc.c - page-transfer message queue
+ *
+ * A message is a descriptor (length, mode, span) plus the frame numbers
+ * of its pages. Frames are kept in one ring shared by all messages:
+ * messages leave in the order they came, so each one's frames form a
+ * contiguous span and receiving frees the oldest span.
+ *
+ * A sender reserves its slot and span under irq_save, rewrites its PTEs
+ * with interrupts on and only then marks the slot ready; a receiver
+ * claims the ready head slot the same way, so a 64 MiB transfer never
+ * runs with interrupts off.
+ */
+#include "page_ipc.h"
+#include "../mm/pagetable.h"
+#include "../mm/physical_memory.h"
+#include "../mm/page.h"
+#include "../arch/x86/cpu.h"
+#include <stddef.h>
+
+#define PTE_P      0x1ULL
+#define PTE_W      0x2ULL
+#define PTE_U      0x4ULL
+#define PTE_PS     0x80ULL      /* large page; never set on this kernel's 4 KiB PTEs */
+#define PTE_FRAME  0x000FFFFFFFFFF000ULL
+
+/* with more pages than this, one CR3 reload beats invlpg per page */
+#define FLUSH_ALL_PAGES 32
+
+enum { SLOT_FREE, SLOT_FILLING, SLOT_READY, SLOT_BUSY };
+
+typedef struct page_msg {
+    uint64_t len;
+    uint32_t span;              /* first frame, index into frames[] */
+    uint32_t npages;
+    int mode;
+    int state;
+} page_msg_t;
+
+static page_msg_t msgs[IPC_PAGES_MSGS];
+static uint32_t msg_head, msg_tail;             /* monotonic */
+static uint32_t frames[IPC_PAGES_RING];
+static uint32_t span_head, span_tail;           /* monotonic */
+
+/* Present 4 KiB user PTE for vaddr, or NULL */
+static uint64_t *user_pte(void *pml4, uint64_t vaddr) {
+    uint64_t *pte = pt_find_pte_for_vaddr(pml4, vaddr);
+    if (!pte || (*pte & (PTE_P | PTE_U | PTE_PS)) != (PTE_P | PTE_U)) return NULL;
+    return pte;
+}
+
+static void flush_range(void *pml4, uint64_t vaddr, uint32_t npages) {
+#ifdef HOST_TEST
+    (void)pml4; (void)vaddr; (void)npages;
+#else
+    if (read_cr3() != (uint64_t)pml4) return;   /* no stale entries on this CPU */
+    if (npages > FLUSH_ALL_PAGES) {
+        pt_set_cr3(pml4);
+        return;
+    }
+    for (uint32_t i = 0; i < npages; i++) invlpg(vaddr + (uint64_t)i * PAGE_SIZE);
+#endif
+}
+
+int ipc_send_pages(void *pml4, uint64_t vaddr, uint64_t len, int mode) {
+    if (!pml4 || (vaddr & (PAGE_SIZE - 1)) || !len || len > IPC_PAGES_MAX_BYTES ||
+        (mode != IPC_PAGES_MOVE && mode != IPC_PAGES_SHARE))
+        return -1;
+    uint32_t npages = (uint32_t)((len + PAGE_SIZE - 1) / PAGE_SIZE);
+    for (uint32_t i = 0; i < npages; i++)
+        if (!user_pte(pml4, vaddr + (uint64_t)i * PAGE_SIZE)) return -1;
+
+    uint64_t flags = irq_save();
+    if (msg_tail - msg_head == IPC_PAGES_MSGS || IPC_PAGES_RING - (span_head - span_tail) < npages) {
+        irq_restore(flags);
+        return -1;
+    }
+    page_msg_t *m = &msgs[msg_tail++ % IPC_PAGES_MSGS];
+    m->len = len;
+    m->span = span_head;
+    m->npages = npages;
+    m->mode = mode;
+    m->state = SLOT_FILLING;
+    span_head += npages;
+    irq_restore(flags);
+
+    for (uint32_t i = 0; i < npages; i++) {
+        uint64_t *pte = pt_find_pte_for_vaddr(pml4, vaddr + (uint64_t)i * PAGE_SIZE);
+        uint32_t frame = (uint32_t)(*pte & PTE_FRAME);
+        frames[(m->span + i) & (IPC_PAGES_RING - 1)] = frame;
+        if (mode == IPC_PAGES_MOVE) {
+            *pte = 0;                   /* the sender's reference moves along */
+        } else {
+            frame_incref(frame);        /* the receiver's reference */
+            *pte &= ~PTE_W;
+        }
+    }
+    flush_range(pml4, vaddr, npages);
+
+    __atomic_store_n(&m->state, SLOT_READY, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int64_t ipc_recv_pages(void *pml4, uint64_t vaddr, uint64_t maxlen) {
+    if (!pml4 || (vaddr & (PAGE_SIZE - 1))) return -1;
+
+    uint64_t flags = irq_save();
+    page_msg_t *m = &msgs[msg_head % IPC_PAGES_MSGS];
+    if (msg_head == msg_tail || m->state != SLOT_READY || m->len > maxlen) {
+        irq_restore(flags);
+        return -1;
+    }
+    m->state = SLOT_BUSY;
+    irq_restore(flags);
+
+    uint32_t i;
+    for (i = 0; i < m->npages; i++) {
+        uint64_t *pte = pt_find_pte_for_vaddr(pml4, vaddr + (uint64_t)i * PAGE_SIZE);
+        if (pte && (*pte & PTE_P)) break;
+    }
+    if (i == m->npages) {
+        for (i = 0; i < m->npages; i++) {
+            uint32_t frame = frames[(m->span + i) & (IPC_PAGES_RING - 1)];
+            /* a moved page someone else still shares stays COW */
+            uint64_t prot = PTE_U;
+            if (m->mode == IPC_PAGES_MOVE && frame_refcount_get(frame) <= 1) prot |= PTE_W;
+            if (pt_map_page(pml4, vaddr + (uint64_t)i * PAGE_SIZE, frame, prot) < 0) break;
+        }
+        if (i == m->npages) {
+            flags = irq_save();
+            uint32_t npages = m->npages;
+            int64_t len = (int64_t)m->len;
+            m->state = SLOT_FREE;
+            msg_head++;
+            span_tail += npages;
+            irq_restore(flags);
+            return len;
+        }
+        /* out of page-table memory: take back what was mapped */
+        while (i--) *pt_find_pte_for_vaddr(pml4, vaddr + (uint64_t)i * PAGE_SIZE) = 0;
+        flush_range(pml4, vaddr, m->npages);
+    }
+    __atomic_store_n(&m->state, SLOT_READY, __ATOMIC_RELEASE);
+    return -1;
+}
+
+uint64_t ipc_pages_peek(void) {
+    uint64_t flags = irq_save();
+    const page_msg_t *m = &msgs[msg_head % IPC_PAGES_MSGS];
+    uint64_t len = (msg_head != msg_tail && m->state == SLOT_READY) ? m->len : 0;
+    irq_restore(flags);
+    return len;
+}
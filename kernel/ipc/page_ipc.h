@@ -0,0 +1,43 @@
+/* kernel/ipc/page_ipc.h
+ * Page-transfer messages for large payloads. ipc_send/ipc_recv copy a
+ * string of at most 127 bytes twice; these carry a page-aligned buffer
+ * of up to IPC_PAGES_MAX_BYTES by handing over its page frames instead:
+ *
+ *   IPC_PAGES_MOVE   the pages are unmapped from the sender and mapped
+ *                    writable at the receiver's address
+ *   IPC_PAGES_SHARE  both sides keep them read-only; frame_refcount
+ *                    counts the extra owner and the first write on
+ *                    either side takes a COW fault (page_fault_handler)
+ *
+ * The cost is a PTE update per page on each side, never the bytes, so
+ * the bandwidth does not depend on the message size. The buffer must be
+ * mapped in 4 KiB user pages; the receive window must be unmapped.
+ *
+ * Messages are delivered in send order. A receive that fails (window
+ * too small or already mapped) leaves the message queued.
+ */
+#ifndef PAGE_IPC_H
+#define PAGE_IPC_H
+
+#include <stdint.h>
+
+#define IPC_PAGES_MOVE   0
+#define IPC_PAGES_SHARE  1
+
+#define IPC_PAGES_MSGS       16                  /* queued messages */
+#define IPC_PAGES_MAX_BYTES  (64ULL << 20)       /* one message */
+#define IPC_PAGES_RING       32768               /* queued pages, power of two */
+
+/* Queue len bytes (rounded up to whole pages) at vaddr in pml4.
+   Returns 0, or -1 if an argument or page is unusable or the queue is
+   full. Nothing changes on failure. */
+int ipc_send_pages(void *pml4, uint64_t vaddr, uint64_t len, int mode);
+
+/* Map the oldest message at vaddr in pml4 if it fits in maxlen bytes.
+   Returns its length, or -1 (empty queue, or the message stays queued). */
+int64_t ipc_recv_pages(void *pml4, uint64_t vaddr, uint64_t maxlen);
+
+/* Length of the oldest message, 0 if none */
+uint64_t ipc_pages_peek(void);
+
+#endif /* PAGE_IPC_H */
@@ -3,12 +3,21 @@
  * Portabel bootimage for any UEFI/BIOS system (VM, physical hardware, cloud)
  */
 #include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "klog.h"
 
 /* forward declarations for functions in other modules */
 void gdt_install(void);
 void idt_install(void);
 void irq_install(void);
 void timer_install(void);
+void fpu_init(void);
+void vdso_init(void);
+void uaccess_init(void);
+void libc_init(void);
+void physical_memory_init(void);
+void page_ops_init(void);
 void keyboard_install(void);
 void serial_init(void);
 void paging_enable(void);
@@ -17,18 +26,72 @@ void syscall_install(void);
 /* ELF loader and process management */
 void elf_loader_demo(void);
 
+/* In-kernel benchmarks (DEFS=-DRUN_*_BENCH) replace the demo tasks */
+#if defined(RUN_YIELD_BENCH) || defined(RUN_TIMER_BENCH) || defined(RUN_TICKLESS_BENCH) || \
+    defined(RUN_FPU_BENCH) || defined(RUN_CR3_BENCH) || defined(RUN_THREAD_BENCH) || \
+    defined(RUN_SPAWN_BENCH) || defined(RUN_AFFINITY_BENCH) || defined(RUN_EDF_BENCH) || \
+    defined(RUN_TRACE_BENCH) || defined(RUN_GANG_BENCH) || defined(RUN_SYSCALL_BENCH) || \
+    defined(RUN_URING_BENCH) || defined(RUN_VDSO_BENCH) || defined(RUN_UACCESS_BENCH) || \
+    defined(RUN_FUTEX_BENCH) || defined(RUN_COW_BENCH) || defined(RUN_PAGE_IPC_BENCH)
+#define RUN_KERNEL_BENCH
+#endif
+
 void show_string(const char *s);
 
+/* Multiboot2 boot command line (tag type 1), or NULL */
+static const char *boot_cmdline(uint32_t mbi_ptr) {
+    if (!mbi_ptr) return 0;
+    uint32_t total = *(volatile uint32_t *)(uintptr_t)mbi_ptr;
+    for (uint32_t off = 8; off + 8 <= total; ) {
+        uint32_t type = *(volatile uint32_t *)(uintptr_t)(mbi_ptr + off);
+        uint32_t size = *(volatile uint32_t *)(uintptr_t)(mbi_ptr + off + 4);
+        if (type == 0 || size < 8) break;
+        if (type == 1) return (const char *)(uintptr_t)(mbi_ptr + off + 8);
+        off += (size + 7) & ~7u;
+    }
+    return 0;
+}
+
+/* Value of key=... in the command line, or NULL */
+static const char *boot_param(const char *cmdline, const char *key) {
+    for (const char *s = cmdline; s && *s; s++) {
+        if (s != cmdline && s[-1] != ' ') continue;
+        const char *k = key, *v = s;
+        while (*k && *v == *k) { k++; v++; }
+        if (!*k) return v;
+    }
+    return 0;
+}
+
+static uint32_t boot_param_dec(const char *v) {
+    uint32_t n = 0;
+    while (v && *v >= '0' && *v <= '9') n = n * 10 + (uint32_t)(*v++ - '0');
+    return n;
+}
+
 /* entry called from start.S (mbi_ptr passed in EDI for 64-bit signature) */
 void kmain(uint32_t mbi_ptr) {
-    (void)mbi_ptr; /* Multiboot info not used for now */
-    
+    const char *cmdline = boot_cmdline(mbi_ptr);
+
     /* initialize subsystems */
     serial_init();
+    /* serial=sync: poll every byte out, like before the TX ring */
+    const char *sp = boot_param(cmdline, "serial=");
+    if (sp && sp[0] == 's' && sp[1] == 'y' && sp[2] == 'n' && sp[3] == 'c') serial_set_sync();
+    const char *baud = boot_param(cmdline, "baud=");
+    if (baud && serial_set_baud(boot_param_dec(baud)) != 0)
+        serial_puts("[serial] unsupported baud rate, keeping default\n");
+    physical_memory_init();
     gdt_install();
     idt_install();
     irq_install();
+    serial_irq_install();
     timer_install();
+    fpu_init();
+    uaccess_init();
+    libc_init();
+    page_ops_init();
+    vdso_init();
     keyboard_install();
     
     show_string("=== SOH Descentralizado (64-bit x86-64 Kernel) ===\n");
@@ -43,8 +106,70 @@ void kmain(uint32_t mbi_ptr) {
     /* Setup syscall interface (Phase 1) */
     syscall_install();
     show_string("[kmain] Syscall interface installed\n");
+
+    /* isolcpus=<list>: keep housekeeping tasks off these CPUs */
+    const char *isol = boot_param(cmdline, "isolcpus=");
+    if (isol) {
+        extern uint64_t sched_parse_cpulist(const char *s);
+        extern void sched_set_isolated(uint64_t mask);
+        sched_set_isolated(sched_parse_cpulist(isol));
+    }
     /* Demo: load and execute embedded user ELF (phase 1 test) */
-#ifdef RUN_FORK_DEMO
+#if defined(RUN_YIELD_BENCH)
+    extern void yield_bench(void);
+    yield_bench();
+#elif defined(RUN_TIMER_BENCH)
+    extern void timer_bench(void);
+    timer_bench();
+#elif defined(RUN_TICKLESS_BENCH)
+    extern void tickless_bench(void);
+    tickless_bench();
+#elif defined(RUN_FPU_BENCH)
+    extern void fpu_bench(void);
+    fpu_bench();
+#elif defined(RUN_CR3_BENCH)
+    extern void cr3_bench(void);
+    cr3_bench();
+#elif defined(RUN_THREAD_BENCH)
+    extern void thread_bench(void);
+    thread_bench();
+#elif defined(RUN_SPAWN_BENCH)
+    extern void spawn_bench(void);
+    spawn_bench();
+#elif defined(RUN_AFFINITY_BENCH)
+    extern void affinity_bench(void);
+    affinity_bench();
+#elif defined(RUN_EDF_BENCH)
+    extern void edf_bench(void);
+    edf_bench();
+#elif defined(RUN_TRACE_BENCH)
+    extern void trace_bench(void);
+    trace_bench();
+#elif defined(RUN_GANG_BENCH)
+    extern void gang_bench(void);
+    gang_bench();
+#elif defined(RUN_SYSCALL_BENCH)
+    extern void syscall_bench(void);
+    syscall_bench();
+#elif defined(RUN_URING_BENCH)
+    extern void uring_bench(void);
+    uring_bench();
+#elif defined(RUN_VDSO_BENCH)
+    extern void vdso_bench(void);
+    vdso_bench();
+#elif defined(RUN_UACCESS_BENCH)
+    extern void uaccess_bench(void);
+    uaccess_bench();
+#elif defined(RUN_FUTEX_BENCH)
+    extern void futex_bench(void);
+    futex_bench();
+#elif defined(RUN_COW_BENCH)
+    extern void cow_bench(void);
+    cow_bench();
+#elif defined(RUN_PAGE_IPC_BENCH)
+    extern void page_ipc_bench(void);
+    page_ipc_bench();
+#elif defined(RUN_FORK_DEMO)
     extern void elf_loader_fork_demo(void);
     elf_loader_fork_demo();
 #else
@@ -54,35 +179,55 @@ void kmain(uint32_t mbi_ptr) {
     /* Demo: Test IPC + Scheduler (still functional in 64-bit) */
     extern int task_create(void (*)(void));
     extern void scheduler_start(void);
+    extern void scheduler_yield(void);
     extern int ipc_send(const char *s);
     extern int ipc_recv(char *buf, int buflen);
 
+#ifndef RUN_KERNEL_BENCH
+    /* Producer and consumer hand the CPU to each other with an explicit
+       yield instead of waiting for the next PIT tick. */
     void producer(void) {
-        static int i = 0;
-        if (i < 3) {
-            ipc_send("hello from producer");
-            i++;
+        for (int i = 0; i < 3; i++) {
+            while (ipc_send("hello from producer") != 0)
+                scheduler_yield();
+            scheduler_yield();
         }
     }
 
     void consumer(void) {
-        static int i = 0;
         char buf[128];
-        if (i < 3) {
+        for (int i = 0; i < 3; ) {
             if (ipc_recv(buf, sizeof(buf)) == 0) {
                 show_string("consumer got: ");
                 show_string(buf);
                 show_string("\n");
+                i++;
+            } else {
+                scheduler_yield();
             }
-            i++;
         }
     }
 
     /* Create demo tasks */
     task_create(producer);
     task_create(consumer);
-    
-    show_string("[kmain] Starting cooperative round-robin scheduler...\n");
+#endif
+
+    show_string("[kmain] Starting preemptive round-robin scheduler...\n");
+    klog_flush();       /* boot-time records (ELF loads, syscall setup) */
+
+    /* what kmain's console output cost the boot CPU */
+    serial_stats_t ss;
+    serial_get_stats(&ss);
+    serial_puts("[serial] kmain logging: bytes=");
+    serial_put_dec(ss.bytes);
+    serial_puts(" cycles=");
+    serial_put_dec(ss.cycles);
+    serial_puts(" us=");
+    serial_put_dec(timer_tsc_to_ns(ss.cycles) / 1000);
+    serial_puts(" dropped=");
+    serial_put_dec(ss.dropped);
+    serial_puts(ss.buffered ? " mode=buffered\n" : " mode=sync\n");
     scheduler_start();
 
     /* Should never return */
@@ -95,14 +240,12 @@ void show_string(const char *s) {
        are visible when running QEMU with `-serial stdio`. */
     volatile char *video = (volatile char*)0xB8000;
     static int pos = 0;
-    /* serial_putc is implemented in drivers/serial.c */
-    extern void serial_putc(char c);
+    /* one serial write per string keeps the line together in the TX ring */
+    serial_puts(s);
     while (*s) {
         char ch = *s++;
         video[pos++] = ch;
         video[pos++] = 0x07;
-        /* also emit to serial for console logging */
-        serial_putc(ch);
         if (pos > 80*25*2-2) pos = 0;
     }
 }
@@ -0,0 +1,129 @@
+/* kernel/klog.c - per-CPU binary log rings and their serial drain */
+#include "klog.h"
+#include "drivers/serial.h"
+#ifndef HOST_TEST
+#include "arch/x86/cpu.h"
+#endif
+
+typedef struct klog_ring {
+    uint64_t head;                       /* next slot to write (monotonic) */
+    uint64_t tail;                       /* oldest unflushed record */
+    uint64_t dropped;
+    uint64_t reported;                   /* dropped count already flushed */
+    klog_record_t rec[KLOG_RING_RECORDS];
+} klog_ring_t;
+
+static klog_ring_t rings[KLOG_MAX_CPUS];
+static int hz_sent;
+
+#ifdef HOST_TEST
+extern const klog_site_t __start___klog_sites[];
+#define KLOG_SITES __start___klog_sites
+int sched_cpu_id(void);
+uint64_t timer_tsc_hz(void);
+static inline uint64_t irq_save(void) { return 0; }
+static inline void irq_restore(uint64_t flags) { (void)flags; }
+static inline uint64_t rdtsc(void) { return __builtin_ia32_rdtsc(); }
+#else
+extern const klog_site_t __klog_sites_start[];      /* linker.ld */
+#define KLOG_SITES __klog_sites_start
+#endif
+
+void klog_record(const klog_site_t *site, uint64_t a0, uint64_t a1, uint64_t a2,
+                 uint64_t a3, uint64_t a4, uint64_t a5) {
+    extern int sched_cpu_id(void);
+    int cpu = sched_cpu_id();
+    klog_ring_t *r = &rings[cpu];
+
+    /* written only by its own CPU: masking interrupts keeps an IRQ-time
+       record out of our slot (as in trace.c) */
+    uint64_t flags = irq_save();
+    uint64_t h = r->head++;
+    klog_record_t *e = &r->rec[h & (KLOG_RING_RECORDS - 1)];
+    e->tsc = rdtsc();
+    e->id = (uint32_t)(site - KLOG_SITES);
+    e->cpu = (uint16_t)cpu;
+    e->nargs = site->nargs;
+    e->arg[0] = a0;
+    e->arg[1] = a1;
+    e->arg[2] = a2;
+    e->arg[3] = a3;
+    e->arg[4] = a4;
+    e->arg[5] = a5;
+    if (h - r->tail >= KLOG_RING_RECORDS) {
+        r->tail++;                       /* overwrote the oldest record */
+        r->dropped++;
+    }
+    irq_restore(flags);
+}
+
+static int pop(klog_ring_t *r, klog_record_t *out) {
+    uint64_t flags = irq_save();
+    int ok = r->tail != r->head;
+    if (ok) *out = r->rec[r->tail++ & (KLOG_RING_RECORDS - 1)];
+    irq_restore(flags);
+    return ok;
+}
+
+int klog_read(klog_record_t *buf, int max) {
+    int n = 0;
+    for (int c = 0; c < KLOG_MAX_CPUS && n < max; c++)
+        while (n < max && pop(&rings[c], &buf[n])) n++;
+    return n;
+}
+
+uint64_t klog_dropped(void) {
+    uint64_t n = 0;
+    for (int c = 0; c < KLOG_MAX_CPUS; c++) n += rings[c].dropped;
+    return n;
+}
+
+static char *put_hex(char *p, uint64_t v) {
+    char tmp[16];
+    int n = 0;
+    do { tmp[n++] = "0123456789abcdef"[v & 0xF]; v >>= 4; } while (v);
+    *p++ = ' ';
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+/* "[klog] <cpu> <tsc> <id> <args...>", hex, one serial write per record */
+static void emit(const klog_record_t *e) {
+    char line[8 + 17 * (3 + KLOG_MAX_ARGS) + 1];
+    char *p = line;
+    for (const char *s = "[klog]"; *s; ) *p++ = *s++;
+    p = put_hex(p, e->cpu);
+    p = put_hex(p, e->tsc);
+    p = put_hex(p, e->id);
+    for (int i = 0; i < e->nargs && i < KLOG_MAX_ARGS; i++) p = put_hex(p, e->arg[i]);
+    *p++ = '\n';
+    serial_write(line, (uint32_t)(p - line));
+}
+
+void klog_flush(void) {
+    extern int sched_cpu_id(void);
+    extern uint64_t timer_tsc_hz(void);
+    klog_ring_t *r = &rings[sched_cpu_id()];
+    if (!hz_sent && timer_tsc_hz()) {
+        /* the decoder turns TSC values into seconds with this */
+        hz_sent = 1;
+        serial_puts("[klog] hz ");
+        serial_put_dec(timer_tsc_hz());
+        serial_putc('\n');
+    }
+    klog_record_t e;
+    while (pop(r, &e)) emit(&e);
+    uint64_t lost = r->dropped - r->reported;
+    if (lost) {
+        serial_puts("[klog] dropped ");
+        serial_put_dec(lost);
+        serial_putc('\n');
+        r->reported += lost;
+    }
+}
+
+void klog_poll(void) {
+    extern int sched_cpu_id(void);
+    klog_ring_t *r = &rings[sched_cpu_id()];
+    if (r->head - r->tail >= KLOG_RING_RECORDS / 2) klog_flush();
+}
@@ -0,0 +1,135 @@
+/* kernel/klog.h
+ * Binary kernel log. A call site
+ *
+ *     klog_info("[pm] registered process pid=%lu", proc->pid);
+ *
+ * stores only a TSC timestamp, the site's index and the raw 64-bit
+ * arguments in the CPU's ring; the format string never leaves .rodata.
+ * Each site is a klog_site_t in the __klog_sites section (linker.ld), so
+ * its index is a static format ID. klog_flush later writes pending
+ * records to serial as short hex lines,
+ *
+ *     [klog] <cpu> <tsc> <id> <arg>...
+ *
+ * and tools/klogdump.c rebuilds the text on the host from those lines
+ * and the kernel ELF (site table + format strings).
+ *
+ * Formats take %d %i %u %x %X %o %c %p with optional flags, width and
+ * length modifiers (every argument is a u64), and %s only for strings
+ * that live in the kernel image. At most KLOG_MAX_ARGS arguments.
+ *
+ * Levels below KLOG_LEVEL (DEFS=-DKLOG_LEVEL=...) compile to nothing:
+ * no site, no call, arguments not evaluated. Error and warning sites
+ * flush right away.
+ */
+
+#ifndef KLOG_H
+#define KLOG_H
+
+#include <stdint.h>
+
+#define KLOG_ERR    0
+#define KLOG_WARN   1
+#define KLOG_INFO   2
+#define KLOG_DEBUG  3
+
+#ifndef KLOG_LEVEL
+#define KLOG_LEVEL  KLOG_INFO
+#endif
+
+#define KLOG_MAX_ARGS     6
+#define KLOG_MAX_CPUS     8
+#define KLOG_RING_RECORDS 1024      /* per CPU, power of two */
+
+typedef struct klog_site {
+    const char *fmt;
+    uint16_t level;
+    uint16_t nargs;
+    uint32_t line;
+} __attribute__((aligned(16))) klog_site_t;
+
+typedef struct klog_record {
+    uint64_t tsc;
+    uint32_t id;                    /* index into the site table */
+    uint16_t cpu;
+    uint16_t nargs;
+    uint64_t arg[KLOG_MAX_ARGS];
+} klog_record_t;
+
+void klog_record(const klog_site_t *site, uint64_t a0, uint64_t a1, uint64_t a2,
+                 uint64_t a3, uint64_t a4, uint64_t a5);
+
+/* Write this CPU's pending records to serial (idle loop, panic).
+   klog_poll does it only once the ring is half full (timer tick). */
+#if defined(HOST_TEST) && !defined(KLOG_HOST_RING)
+static inline void klog_flush(void) { }
+static inline void klog_poll(void) { }
+#else
+void klog_flush(void);
+void klog_poll(void);
+#endif
+
+/* Move up to max pending records of every CPU into buf, oldest first */
+int klog_read(klog_record_t *buf, int max);
+
+/* Records lost to ring overwrites */
+uint64_t klog_dropped(void);
+
+/* ---- call-site macros ---- */
+
+#define KLOG_NARGS(...) KLOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define KLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+#define KLOG_CAT(a, b)  KLOG_CAT_(a, b)
+#define KLOG_CAT_(a, b) a##b
+
+#define KLOG_U(x) ((uint64_t)(x))
+#define KLOG_CALL0(s)                      klog_record(s, 0, 0, 0, 0, 0, 0)
+#define KLOG_CALL1(s, a)                   klog_record(s, KLOG_U(a), 0, 0, 0, 0, 0)
+#define KLOG_CALL2(s, a, b)                klog_record(s, KLOG_U(a), KLOG_U(b), 0, 0, 0, 0)
+#define KLOG_CALL3(s, a, b, c)             klog_record(s, KLOG_U(a), KLOG_U(b), KLOG_U(c), 0, 0, 0)
+#define KLOG_CALL4(s, a, b, c, d)          klog_record(s, KLOG_U(a), KLOG_U(b), KLOG_U(c), KLOG_U(d), 0, 0)
+#define KLOG_CALL5(s, a, b, c, d, e)       klog_record(s, KLOG_U(a), KLOG_U(b), KLOG_U(c), KLOG_U(d), KLOG_U(e), 0)
+#define KLOG_CALL6(s, a, b, c, d, e, f)    klog_record(s, KLOG_U(a), KLOG_U(b), KLOG_U(c), KLOG_U(d), KLOG_U(e), KLOG_U(f))
+
+/* a stripped site: arguments are type-checked and count as used, but
+   never evaluated, and nothing lands in __klog_sites */
+#define KLOG_NOP(fmt, ...) do {                                                 \
+        if (0) KLOG_CAT(KLOG_CALL, KLOG_NARGS(__VA_ARGS__))((const klog_site_t *)0, ##__VA_ARGS__); \
+    } while (0)
+
+#if defined(HOST_TEST) && !defined(KLOG_HOST_RING)
+/* host tests of pm/syscall/elf/vm code have no log to write to;
+   tests/klog_test.c defines KLOG_HOST_RING */
+#define KLOG_SITE(lvl, fmt, ...) KLOG_NOP(fmt, ##__VA_ARGS__)
+#else
+#define KLOG_SITE(lvl, fmt_, ...) do {                                          \
+        static const klog_site_t klog_site_                                     \
+            __attribute__((section("__klog_sites"), used)) =                    \
+            { fmt_, lvl, KLOG_NARGS(__VA_ARGS__), __LINE__ };                   \
+        KLOG_CAT(KLOG_CALL, KLOG_NARGS(__VA_ARGS__))(&klog_site_, ##__VA_ARGS__); \
+        if ((lvl) <= KLOG_WARN) klog_flush();                                   \
+    } while (0)
+#endif
+
+#if KLOG_LEVEL >= KLOG_ERR
+#define klog_err(fmt, ...)   KLOG_SITE(KLOG_ERR, fmt, ##__VA_ARGS__)
+#else
+#define klog_err(fmt, ...)   KLOG_NOP(fmt, ##__VA_ARGS__)
+#endif
+#if KLOG_LEVEL >= KLOG_WARN
+#define klog_warn(fmt, ...)  KLOG_SITE(KLOG_WARN, fmt, ##__VA_ARGS__)
+#else
+#define klog_warn(fmt, ...)  KLOG_NOP(fmt, ##__VA_ARGS__)
+#endif
+#if KLOG_LEVEL >= KLOG_INFO
+#define klog_info(fmt, ...)  KLOG_SITE(KLOG_INFO, fmt, ##__VA_ARGS__)
+#else
+#define klog_info(fmt, ...)  KLOG_NOP(fmt, ##__VA_ARGS__)
+#endif
+#if KLOG_LEVEL >= KLOG_DEBUG
+#define klog_debug(fmt, ...) KLOG_SITE(KLOG_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define klog_debug(fmt, ...) KLOG_NOP(fmt, ##__VA_ARGS__)
+#endif
+
+#endif /* KLOG_H */
@@ -1,36 +1,283 @@
 /* kernel/libc.c
  * Minimal C library functions for kernel (memcpy, memset, strlen, etc.)
+ *
+ * memcpy and memset pick a strategy by size from what libc_init found in
+ * CPUID: rep movsb/stosb when the CPU has fast strings (FSRM: any size,
+ * ERMS: from LIBC_ERMS_MIN), otherwise SSE2/AVX2 for large blocks and
+ * 64-bit words for the rest. The vector paths borrow the FPU registers
+ * through fpu_kernel_begin/end, which costs a state save, so they only
+ * run from LIBC_VEC_MIN and in LIBC_VEC_CHUNK pieces to bound the time
+ * spent with interrupts off. Until libc_init runs only the word path is
+ * used. strlen and strcmp scan a word at a time.
  */
 
 #include <stddef.h>
 #include <stdint.h>
+#include "arch/x86/cpu.h"
+#ifndef HOST_TEST
+#include "arch/x86/fpu.h"
+#include "drivers/serial.h"
+#endif
+
+#define LIBC_ERMS_MIN  256      /* rep movsb startup beats words above this (no FSRM) */
+#define LIBC_VEC_MIN   4096     /* vector paths repay fpu_kernel_begin above this */
+#define LIBC_VEC_CHUNK 65536    /* bytes per fpu_kernel_begin/end section */
+
+#define LIBC_VEC_NONE  0
+#define LIBC_VEC_SSE2  1
+#define LIBC_VEC_AVX2  2
+
+static int libc_erms, libc_fsrm, libc_vec;
+
+#ifdef HOST_TEST
+/* Host tests run in ring 3 with the vector registers their own */
+static inline uint64_t fpu_kernel_begin(void) { return 0; }
+static inline void fpu_kernel_end(uint64_t flags) { (void)flags; }
+#endif
+
+/* Unaligned, alias-anything word accesses */
+typedef uint64_t __attribute__((may_alias, aligned(1))) u64_u;
+typedef uint32_t __attribute__((may_alias, aligned(1))) u32_u;
+typedef uint64_t __attribute__((may_alias)) u64_a;
+
+#define ONES  0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+#define HAS_ZERO(v) (((v) - ONES) & ~(v) & HIGHS)
+
+/* ---- memcpy variants: each handles any n ---- */
+
+static void copy_bytes(uint8_t *d, const uint8_t *s, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        d[i] = s[i];
+}
+
+/* Up to 16 bytes with at most two overlapping loads and stores */
+static inline void copy_small(uint8_t *d, const uint8_t *s, size_t n) {
+    if (n >= 8) {
+        uint64_t a = *(const u64_u *)s, b = *(const u64_u *)(s + n - 8);
+        *(u64_u *)d = a;
+        *(u64_u *)(d + n - 8) = b;
+    } else if (n >= 4) {
+        uint32_t a = *(const u32_u *)s, b = *(const u32_u *)(s + n - 4);
+        *(u32_u *)d = a;
+        *(u32_u *)(d + n - 4) = b;
+    } else {
+        copy_bytes(d, s, n);
+    }
+}
+
+static void copy_words(uint8_t *d, const uint8_t *s, size_t n) {
+    if (n <= 16) {
+        copy_small(d, s, n);
+        return;
+    }
+    uint64_t last = *(const u64_u *)(s + n - 8);
+    uint8_t *end = d + n - 8;
+    while (n >= 32) {
+        uint64_t a = ((const u64_u *)s)[0], b = ((const u64_u *)s)[1];
+        uint64_t c = ((const u64_u *)s)[2], e = ((const u64_u *)s)[3];
+        ((u64_u *)d)[0] = a;
+        ((u64_u *)d)[1] = b;
+        ((u64_u *)d)[2] = c;
+        ((u64_u *)d)[3] = e;
+        d += 32;
+        s += 32;
+        n -= 32;
+    }
+    while (n > 8) {
+        *(u64_u *)d = *(const u64_u *)s;
+        d += 8;
+        s += 8;
+        n -= 8;
+    }
+    *(u64_u *)end = last;
+}
+
+static void copy_movsb(uint8_t *d, const uint8_t *s, size_t n) {
+    asm volatile ("rep movsb" : "+D"(d), "+S"(s), "+c"(n) : : "memory");
+}
+
+/* The vector registers are not clobber-listed: -mgeneral-regs-only
+   keeps the compiler off them, and fpu_kernel_begin made them ours. */
+static void sse2_copy_blocks(uint8_t *d, const uint8_t *s, size_t n) {
+    asm volatile ("1:\n\t"
+                  "movdqu   (%1), %%xmm0\n\t"
+                  "movdqu 16(%1), %%xmm1\n\t"
+                  "movdqu 32(%1), %%xmm2\n\t"
+                  "movdqu 48(%1), %%xmm3\n\t"
+                  "movdqu %%xmm0,   (%0)\n\t"
+                  "movdqu %%xmm1, 16(%0)\n\t"
+                  "movdqu %%xmm2, 32(%0)\n\t"
+                  "movdqu %%xmm3, 48(%0)\n\t"
+                  "add $64, %1\n\t"
+                  "add $64, %0\n\t"
+                  "sub $64, %2\n\t"
+                  "jnz 1b"
+                  : "+r"(d), "+r"(s), "+r"(n) : : "memory", "cc");
+}
+
+static void avx2_copy_blocks(uint8_t *d, const uint8_t *s, size_t n) {
+    asm volatile ("1:\n\t"
+                  "vmovdqu   (%1), %%ymm0\n\t"
+                  "vmovdqu 32(%1), %%ymm1\n\t"
+                  "vmovdqu %%ymm0,   (%0)\n\t"
+                  "vmovdqu %%ymm1, 32(%0)\n\t"
+                  "add $64, %1\n\t"
+                  "add $64, %0\n\t"
+                  "sub $64, %2\n\t"
+                  "jnz 1b\n\t"
+                  "vzeroupper"
+                  : "+r"(d), "+r"(s), "+r"(n) : : "memory", "cc");
+}
+
+/* 64-byte blocks through the vector registers, the tail by words */
+static void copy_vec(uint8_t *d, const uint8_t *s, size_t n, int avx2) {
+    size_t blocks = n & ~(size_t)63;
+    while (blocks) {
+        size_t chunk = blocks < LIBC_VEC_CHUNK ? blocks : LIBC_VEC_CHUNK;
+        uint64_t flags = fpu_kernel_begin();
+        if (avx2) avx2_copy_blocks(d, s, chunk);
+        else sse2_copy_blocks(d, s, chunk);
+        fpu_kernel_end(flags);
+        d += chunk;
+        s += chunk;
+        blocks -= chunk;
+        n -= chunk;
+    }
+    copy_words(d, s, n);
+}
 
 void *memcpy(void *dst, const void *src, size_t n) {
     uint8_t *d = (uint8_t *)dst;
     const uint8_t *s = (const uint8_t *)src;
-    for (size_t i = 0; i < n; i++) {
-        d[i] = s[i];
-    }
+    if (n <= 16)
+        copy_small(d, s, n);
+    else if (libc_fsrm || (libc_erms && n >= LIBC_ERMS_MIN))
+        copy_movsb(d, s, n);
+    else if (libc_vec && n >= LIBC_VEC_MIN)
+        copy_vec(d, s, n, libc_vec == LIBC_VEC_AVX2);
+    else
+        copy_words(d, s, n);
     return dst;
 }
 
+/* ---- memset variants ---- */
+
+static void set_bytes(uint8_t *d, uint8_t c, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        d[i] = c;
+}
+
+static void set_words(uint8_t *d, uint8_t c, size_t n) {
+    uint64_t v = ONES * c;
+    if (n < 8) {
+        set_bytes(d, c, n);
+        return;
+    }
+    uint8_t *end = d + n - 8;
+    while (n >= 32) {
+        ((u64_u *)d)[0] = v;
+        ((u64_u *)d)[1] = v;
+        ((u64_u *)d)[2] = v;
+        ((u64_u *)d)[3] = v;
+        d += 32;
+        n -= 32;
+    }
+    while (n > 8) {
+        *(u64_u *)d = v;
+        d += 8;
+        n -= 8;
+    }
+    *(u64_u *)end = v;
+}
+
+static void set_stosb(uint8_t *d, uint8_t c, size_t n) {
+    asm volatile ("rep stosb" : "+D"(d), "+c"(n) : "a"(c) : "memory");
+}
+
+static void sse2_set_blocks(uint8_t *d, uint64_t v, size_t n) {
+    asm volatile ("movq %2, %%xmm0\n\t"
+                  "punpcklqdq %%xmm0, %%xmm0\n\t"
+                  "1:\n\t"
+                  "movdqu %%xmm0,   (%0)\n\t"
+                  "movdqu %%xmm0, 16(%0)\n\t"
+                  "movdqu %%xmm0, 32(%0)\n\t"
+                  "movdqu %%xmm0, 48(%0)\n\t"
+                  "add $64, %0\n\t"
+                  "sub $64, %1\n\t"
+                  "jnz 1b"
+                  : "+r"(d), "+r"(n) : "r"(v) : "memory", "cc");
+}
+
+static void avx2_set_blocks(uint8_t *d, uint64_t v, size_t n) {
+    asm volatile ("vmovq %2, %%xmm0\n\t"
+                  "vpbroadcastq %%xmm0, %%ymm0\n\t"
+                  "1:\n\t"
+                  "vmovdqu %%ymm0,   (%0)\n\t"
+                  "vmovdqu %%ymm0, 32(%0)\n\t"
+                  "add $64, %0\n\t"
+                  "sub $64, %1\n\t"
+                  "jnz 1b\n\t"
+                  "vzeroupper"
+                  : "+r"(d), "+r"(n) : "r"(v) : "memory", "cc");
+}
+
+static void set_vec(uint8_t *d, uint8_t c, size_t n, int avx2) {
+    size_t blocks = n & ~(size_t)63;
+    while (blocks) {
+        size_t chunk = blocks < LIBC_VEC_CHUNK ? blocks : LIBC_VEC_CHUNK;
+        uint64_t flags = fpu_kernel_begin();
+        if (avx2) avx2_set_blocks(d, ONES * c, chunk);
+        else sse2_set_blocks(d, ONES * c, chunk);
+        fpu_kernel_end(flags);
+        d += chunk;
+        blocks -= chunk;
+        n -= chunk;
+    }
+    set_words(d, c, n);
+}
+
 void *memset(void *dst, int c, size_t n) {
     uint8_t *d = (uint8_t *)dst;
-    for (size_t i = 0; i < n; i++) {
-        d[i] = (uint8_t)c;
-    }
+    if (libc_fsrm || (libc_erms && n >= LIBC_ERMS_MIN))
+        set_stosb(d, (uint8_t)c, n);
+    else if (libc_vec && n >= LIBC_VEC_MIN)
+        set_vec(d, (uint8_t)c, n, libc_vec == LIBC_VEC_AVX2);
+    else
+        set_words(d, (uint8_t)c, n);
     return dst;
 }
 
+/* ---- strings: aligned words never cross a page, so reading the whole
+   word that holds the terminator is safe ---- */
+
 size_t strlen(const char *s) {
-    size_t len = 0;
-    while (s[len]) len++;
-    return len;
+    const char *p = s;
+    for (; (uintptr_t)p & 7; p++)
+        if (!*p) return (size_t)(p - s);
+    const u64_a *w = (const u64_a *)p;
+    while (!HAS_ZERO(*w))
+        w++;
+    for (p = (const char *)w; *p; p++)
+        ;
+    return (size_t)(p - s);
 }
 
 int strcmp(const char *s1, const char *s2) {
-    while (*s1 && *s2) {
-        if (*s1 != *s2) return (unsigned char)*s1 - (unsigned char)*s2;
+    if ((((uintptr_t)s1 ^ (uintptr_t)s2) & 7) == 0) {
+        /* same alignment: bytes up to a word boundary, then words until
+           one differs or holds the terminator */
+        for (; (uintptr_t)s1 & 7; s1++, s2++)
+            if (!*s1 || *s1 != *s2) return (unsigned char)*s1 - (unsigned char)*s2;
+        const u64_a *a = (const u64_a *)s1, *b = (const u64_a *)s2;
+        while (*a == *b && !HAS_ZERO(*a)) {
+            a++;
+            b++;
+        }
+        s1 = (const char *)a;
+        s2 = (const char *)b;
+    }
+    while (*s1 && *s1 == *s2) {
         s1++;
         s2++;
     }
@@ -42,3 +289,41 @@ char *strcpy(char *dst, const char *src) {
     while ((*d++ = *src++));
     return dst;
 }
+
+/* Pick the memcpy/memset strategy. Call after fpu_init, which enables
+   SSE and the AVX state the vector paths need. */
+void libc_init(void) {
+    uint32_t a, b, c, d;
+    cpuid(0, 0, &a, &b, &c, &d);
+    uint32_t max_leaf = a;
+    cpuid(1, 0, &a, &b, &c, &d);
+    int sse2 = (d >> 26) & 1;
+    int avx = ((c >> 28) & 1) && ((c >> 27) & 1);   /* AVX + OSXSAVE */
+    int avx2 = 0;
+    if (max_leaf >= 7) {
+        cpuid(7, 0, &a, &b, &c, &d);
+        libc_erms = (b >> 9) & 1;
+        libc_fsrm = (d >> 4) & 1;
+        avx2 = (b >> 5) & 1;
+    }
+#ifdef HOST_TEST
+    uint64_t xcr0 = avx ? 0x6 : 0;
+#else
+    uint64_t xcr0 = fpu_xfeatures();
+#endif
+    if (avx && avx2 && (xcr0 & 0x6) == 0x6)
+        libc_vec = LIBC_VEC_AVX2;
+    else if (sse2)
+        libc_vec = LIBC_VEC_SSE2;
+
+#ifndef HOST_TEST
+    static const char *vec_names[] = { "words", "sse2", "avx2" };
+    serial_puts("[libc] memcpy/memset: ");
+    serial_puts(libc_fsrm ? "rep movsb (fsrm)" : libc_erms ? "rep movsb (erms) >= 256, " : "");
+    if (!libc_fsrm) {
+        serial_puts(vec_names[libc_vec]);
+        if (libc_vec) serial_puts(" >= 4096, words below");
+    }
+    serial_putc('\n');
+#endif
+}
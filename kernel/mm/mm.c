@@ -0,0 +1,30 @@
+/* kernel/mm/mm.c - shared address-space objects */
+#include "mm.h"
+#include "slab.h"
+#include <stddef.h>
+
+static kmem_cache_t mm_cache = KMEM_CACHE_INIT("mm", sizeof(mm_t), 16);
+
+mm_t *mm_create(uint64_t *page_table) {
+    mm_t *mm = (mm_t *)kmem_cache_zalloc(&mm_cache);
+    if (!mm) return NULL;
+    mm->page_table = page_table;
+    mm->users = 1;
+    return mm;
+}
+
+mm_t *mm_get(mm_t *mm) {
+    if (mm) __atomic_fetch_add(&mm->users, 1, __ATOMIC_RELAXED);
+    return mm;
+}
+
+void mm_put(mm_t *mm) {
+    if (!mm) return;
+    if (__atomic_sub_fetch(&mm->users, 1, __ATOMIC_ACQ_REL) == 0) {
+#ifndef HOST_TEST
+        extern void elf_free_image(void *pml4);
+        if (mm->image) elf_free_image(mm->page_table);
+#endif
+        kmem_cache_free(&mm_cache, mm);
+    }
+}
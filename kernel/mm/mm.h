@@ -0,0 +1,25 @@
+/* kernel/mm/mm.h
+ * Address-space object shared by the threads of a process. A process gets
+ * one the first time it creates a thread; until then its page_table alone
+ * describes the address space.
+ */
+
+#ifndef MM_H
+#define MM_H
+
+#include <stdint.h>
+
+typedef struct mm {
+    uint64_t *page_table;     /* PML4 shared by every user of this mm */
+    int       users;          /* threads referencing it */
+    int       image;          /* page_table is private (PF_IMAGE): freed with the last user */
+} mm_t;
+
+/* New mm around an existing PML4 (one user) */
+mm_t *mm_create(uint64_t *page_table);
+
+/* Take/drop a reference; the last mm_put releases the object */
+mm_t *mm_get(mm_t *mm);
+void mm_put(mm_t *mm);
+
+#endif /* MM_H */
@@ -0,0 +1,215 @@
+/* kernel/mm/page.c - whole-page copy and clear */
+#include "page.h"
+#include "../arch/x86/cpu.h"
+#ifndef HOST_TEST
+#include "../arch/x86/fpu.h"
+#include "../drivers/serial.h"
+#endif
+#include <stddef.h>
+
+extern void *memcpy(void *dst, const void *src, size_t n);
+extern void *memset(void *dst, int c, size_t n);
+
+static int copy_method = PAGE_COPY_MOVSQ;
+static int clear_method = PAGE_CLEAR_STOSQ;
+static int has_avx;
+
+#ifdef HOST_TEST
+static inline uint64_t fpu_kernel_begin(void) { return 0; }
+static inline void fpu_kernel_end(uint64_t flags) { (void)flags; }
+static inline int fpu_kernel_busy(void) { return 0; }
+#endif
+
+int page_copy_method(void) { return copy_method; }
+int page_clear_method(void) { return clear_method; }
+
+const char *page_copy_name(int method) {
+    static const char *names[] = { "rep movsq", "avx", "movnti", "memcpy" };
+    return method >= 0 && method < PAGE_COPY_METHODS ? names[method] : "?";
+}
+
+const char *page_clear_name(int method) {
+    static const char *names[] = { "rep stosq", "avx", "movnti", "memset" };
+    return method >= 0 && method < PAGE_CLEAR_METHODS ? names[method] : "?";
+}
+
+int page_ops_set(int copy, int clear) {
+    if (copy < 0 || copy >= PAGE_COPY_METHODS || clear < 0 || clear >= PAGE_CLEAR_METHODS)
+        return -1;
+    if ((copy == PAGE_COPY_AVX || clear == PAGE_CLEAR_AVX) && !has_avx)
+        return -1;
+    copy_method = copy;
+    clear_method = clear;
+    return 0;
+}
+
+/* The vector registers are not clobber-listed: -mgeneral-regs-only
+   keeps the compiler off them, and fpu_kernel_begin made them ours. */
+static void copy_page_avx(void *dst, const void *src) {
+    uint64_t flags = fpu_kernel_begin();
+    uint64_t n = PAGE_SIZE / 256;
+    asm volatile ("1:\n\t"
+                  "vmovdqu    (%1), %%ymm0\n\t"
+                  "vmovdqu  32(%1), %%ymm1\n\t"
+                  "vmovdqu  64(%1), %%ymm2\n\t"
+                  "vmovdqu  96(%1), %%ymm3\n\t"
+                  "vmovdqu 128(%1), %%ymm4\n\t"
+                  "vmovdqu 160(%1), %%ymm5\n\t"
+                  "vmovdqu 192(%1), %%ymm6\n\t"
+                  "vmovdqu 224(%1), %%ymm7\n\t"
+                  "vmovdqu %%ymm0,    (%0)\n\t"
+                  "vmovdqu %%ymm1,  32(%0)\n\t"
+                  "vmovdqu %%ymm2,  64(%0)\n\t"
+                  "vmovdqu %%ymm3,  96(%0)\n\t"
+                  "vmovdqu %%ymm4, 128(%0)\n\t"
+                  "vmovdqu %%ymm5, 160(%0)\n\t"
+                  "vmovdqu %%ymm6, 192(%0)\n\t"
+                  "vmovdqu %%ymm7, 224(%0)\n\t"
+                  "add $256, %1\n\t"
+                  "add $256, %0\n\t"
+                  "dec %2\n\t"
+                  "jnz 1b\n\t"
+                  "vzeroupper"
+                  : "+r"(dst), "+r"(src), "+r"(n) : : "memory", "cc");
+    fpu_kernel_end(flags);
+}
+
+/* movnti takes general registers: no FPU state involved */
+static void copy_page_nt(void *dst, const void *src) {
+    uint64_t n = PAGE_SIZE / 64;
+    asm volatile ("1:\n\t"
+                  "movq   (%1), %%r8\n\t"
+                  "movq  8(%1), %%r9\n\t"
+                  "movq 16(%1), %%r10\n\t"
+                  "movq 24(%1), %%r11\n\t"
+                  "movnti %%r8,    (%0)\n\t"
+                  "movnti %%r9,   8(%0)\n\t"
+                  "movnti %%r10, 16(%0)\n\t"
+                  "movnti %%r11, 24(%0)\n\t"
+                  "movq 32(%1), %%r8\n\t"
+                  "movq 40(%1), %%r9\n\t"
+                  "movq 48(%1), %%r10\n\t"
+                  "movq 56(%1), %%r11\n\t"
+                  "movnti %%r8,  32(%0)\n\t"
+                  "movnti %%r9,  40(%0)\n\t"
+                  "movnti %%r10, 48(%0)\n\t"
+                  "movnti %%r11, 56(%0)\n\t"
+                  "add $64, %1\n\t"
+                  "add $64, %0\n\t"
+                  "dec %2\n\t"
+                  "jnz 1b\n\t"
+                  "sfence"
+                  : "+r"(dst), "+r"(src), "+r"(n)
+                  : : "r8", "r9", "r10", "r11", "memory", "cc");
+}
+
+void copy_page(void *dst, const void *src) {
+    switch (copy_method) {
+        case PAGE_COPY_AVX:
+            if (fpu_kernel_busy()) goto movsq;   /* COW fault inside a vector copy */
+            copy_page_avx(dst, src);
+            break;
+        case PAGE_COPY_NT:
+            copy_page_nt(dst, src);
+            break;
+        case PAGE_COPY_MEMCPY:
+            memcpy(dst, src, PAGE_SIZE);
+            break;
+        default: movsq: {
+            uint64_t n = PAGE_SIZE / 8;
+            asm volatile ("rep movsq" : "+D"(dst), "+S"(src), "+c"(n) : : "memory");
+            break;
+        }
+    }
+}
+
+static void clear_page_avx(void *dst) {
+    uint64_t flags = fpu_kernel_begin();
+    uint64_t n = PAGE_SIZE / 256;
+    asm volatile ("vpxor %%xmm0, %%xmm0, %%xmm0\n\t"
+                  "1:\n\t"
+                  "vmovdqu %%ymm0,    (%0)\n\t"
+                  "vmovdqu %%ymm0,  32(%0)\n\t"
+                  "vmovdqu %%ymm0,  64(%0)\n\t"
+                  "vmovdqu %%ymm0,  96(%0)\n\t"
+                  "vmovdqu %%ymm0, 128(%0)\n\t"
+                  "vmovdqu %%ymm0, 160(%0)\n\t"
+                  "vmovdqu %%ymm0, 192(%0)\n\t"
+                  "vmovdqu %%ymm0, 224(%0)\n\t"
+                  "add $256, %0\n\t"
+                  "dec %1\n\t"
+                  "jnz 1b\n\t"
+                  "vzeroupper"
+                  : "+r"(dst), "+r"(n) : : "memory", "cc");
+    fpu_kernel_end(flags);
+}
+
+static void clear_page_nt(void *dst) {
+    uint64_t n = PAGE_SIZE / 64;
+    asm volatile ("1:\n\t"
+                  "movnti %2,   (%0)\n\t"
+                  "movnti %2,  8(%0)\n\t"
+                  "movnti %2, 16(%0)\n\t"
+                  "movnti %2, 24(%0)\n\t"
+                  "movnti %2, 32(%0)\n\t"
+                  "movnti %2, 40(%0)\n\t"
+                  "movnti %2, 48(%0)\n\t"
+                  "movnti %2, 56(%0)\n\t"
+                  "add $64, %0\n\t"
+                  "dec %1\n\t"
+                  "jnz 1b\n\t"
+                  "sfence"
+                  : "+r"(dst), "+r"(n) : "r"(0ULL) : "memory", "cc");
+}
+
+void clear_page(void *dst) {
+    switch (clear_method) {
+        case PAGE_CLEAR_AVX:
+            if (fpu_kernel_busy()) goto stosq;
+            clear_page_avx(dst);
+            break;
+        case PAGE_CLEAR_NT:
+            clear_page_nt(dst);
+            break;
+        case PAGE_CLEAR_MEMSET:
+            memset(dst, 0, PAGE_SIZE);
+            break;
+        default: stosq: {
+            uint64_t n = PAGE_SIZE / 8;
+            asm volatile ("rep stosq" : "+D"(dst), "+c"(n) : "a"(0ULL) : "memory");
+            break;
+        }
+    }
+}
+
+/* A copied page is usually written right away (COW), so copies stay
+   cached: AVX where the CPU lacks fast strings, rep movsq otherwise. A
+   cleared page often is not touched for a while, so clears bypass the
+   cache. */
+void page_ops_init(void) {
+    uint32_t a, b, c, d;
+    cpuid(0, 0, &a, &b, &c, &d);
+    uint32_t max_leaf = a;
+    cpuid(1, 0, &a, &b, &c, &d);
+    int avx = ((c >> 28) & 1) && ((c >> 27) & 1);    /* AVX + OSXSAVE */
+    int erms = 0;
+    if (max_leaf >= 7) {
+        cpuid(7, 0, &a, &b, &c, &d);
+        erms = (b >> 9) & 1;
+    }
+#ifdef HOST_TEST
+    has_avx = avx;
+#else
+    has_avx = avx && (fpu_xfeatures() & 0x6) == 0x6;
+#endif
+    copy_method = (has_avx && !erms) ? PAGE_COPY_AVX : PAGE_COPY_MOVSQ;
+    clear_method = PAGE_CLEAR_NT;
+
+#ifndef HOST_TEST
+    serial_puts("[page] copy_page=");
+    serial_puts(page_copy_name(copy_method));
+    serial_puts(" clear_page=");
+    serial_puts(page_clear_name(clear_method));
+    serial_putc('\n');
+#endif
+}
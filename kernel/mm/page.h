@@ -0,0 +1,43 @@
+/* kernel/mm/page.h - whole-page copy and clear
+ *
+ * COW resolution, page-table allocation and PML4 cloning move or zero
+ * exactly one 4 KiB page at a time. These routines are specialised for
+ * that: no size dispatch, fully unrolled loops. The method is chosen at
+ * boot by page_ops_init from CPU features.
+ */
+#ifndef PAGE_H
+#define PAGE_H
+
+#include <stdint.h>
+
+#define PAGE_SIZE 4096
+
+/* copy_page methods */
+#define PAGE_COPY_MOVSQ   0   /* rep movsq */
+#define PAGE_COPY_AVX     1   /* unrolled 256-bit loads/stores */
+#define PAGE_COPY_NT      2   /* movnti (non-temporal) stores + sfence */
+#define PAGE_COPY_MEMCPY  3   /* generic memcpy, for comparison */
+#define PAGE_COPY_METHODS 4
+
+/* clear_page methods */
+#define PAGE_CLEAR_STOSQ   0  /* rep stosq */
+#define PAGE_CLEAR_AVX     1  /* unrolled 256-bit stores */
+#define PAGE_CLEAR_NT      2  /* movnti (non-temporal) stores + sfence */
+#define PAGE_CLEAR_MEMSET  3  /* generic memset, for comparison */
+#define PAGE_CLEAR_METHODS 4
+
+void copy_page(void *dst, const void *src);
+void clear_page(void *dst);
+
+/* Pick the methods; after fpu_init (the AVX variants need XCR0 set up) */
+void page_ops_init(void);
+
+/* Introspection and override for benchmarks. page_ops_set returns -1
+   for a method the CPU cannot run. */
+int page_copy_method(void);
+int page_clear_method(void);
+int page_ops_set(int copy, int clear);
+const char *page_copy_name(int method);
+const char *page_clear_name(int method);
+
+#endif
@@ -5,18 +5,22 @@
 #include "virtual_memory.h"
 #include <string.h>
 #include "physical_memory.h"
+#include "page.h"
 
 #ifdef HOST_TEST
 #include <stdlib.h>
 /* In host tests, emulate a kernel pml4 array */
-static uint64_t host_pml4[512];
+static uint64_t host_pml4[512] __attribute__((aligned(4096)));
 
 void *pt_get_kernel_pml4(void) { return host_pml4; }
 
 extern void *kmalloc(unsigned int size);
 
+static uint64_t *pt_alloc_table(void) { return aligned_alloc(4096, 4096); }
+static void pt_free_table(uint64_t *t) { free(t); }
+
 void *pt_clone_current(void) {
-    void *p = malloc(4096);
+    void *p = pt_alloc_table();
     if (!p) return NULL;
     memcpy(p, host_pml4, 4096);
     return p;
@@ -57,63 +61,25 @@ uint64_t *pt_find_pte_for_vaddr(void *pml4_base, uint64_t vaddr) {
     return &pt[pt_idx];
 }
 
-/* Clone the current PML4 and apply copy-on-write semantics for all mapped PT entries
- * - Allocates a page for new PML4
- * - Copies the PML4 content
- * - Walks all present PML4->PDPT->PD->PT entries and for each present 4KB PTE:
- *   - increments frame refcount
- *   - clears the writable bit in both parent and child entries so writes will cause PF
- */
-void *pt_clone_for_cow(void *parent_pml4) {
-    if (!parent_pml4) return NULL;
-    void *new_pml4 = kmalloc(4096);
-    if (!new_pml4) return NULL;
-    memcpy(new_pml4, parent_pml4, 4096);
-
-    /* Walk PML4 entries */
-    uint64_t *orig = (uint64_t *)parent_pml4;
-    uint64_t *copy = (uint64_t *)new_pml4;
-    for (int i = 0; i < 512; ++i) {
-        uint64_t pml4e = orig[i];
-        if (!(pml4e & 1)) continue; /* not present */
-        uint64_t *pdpt = (uint64_t *)((uint64_t)(pml4e & ~0xFFFULL));
-        uint64_t *pdpt_copy = (uint64_t *)((uint64_t)(copy[i] & ~0xFFFULL));
-        if (!pdpt_copy) continue;
-        for (int j = 0; j < 512; ++j) {
-            uint64_t pdpte = pdpt[j];
-            if (!(pdpte & 1)) continue;
-            /* big 1GB pages? leave unchanged (hard to COW now) */
-            if (pdpte & (1ULL<<7)) continue;
-            uint64_t *pd = (uint64_t *)((uint64_t)(pdpte & ~0xFFFULL));
-            uint64_t *pd_copy = (uint64_t *)((uint64_t)(pdpt_copy[j] & ~0xFFFULL));
-            if (!pd_copy) continue;
-            for (int k = 0; k < 512; ++k) {
-                uint64_t pde = pd[k];
-                if (!(pde & 1)) continue;
-                if (pde & (1ULL<<7)) continue; /* 2MB page, leave for now */
-                uint64_t *pt = (uint64_t *)((uint64_t)(pde & ~0xFFFULL));
-                uint64_t *pt_copy = (uint64_t *)((uint64_t)(pd_copy[k] & ~0xFFFULL));
-                if (!pt_copy) continue;
-                for (int m = 0; m < 512; ++m) {
-                    uint64_t pte = pt[m];
-                    if (!(pte & 1)) continue;
-                    /* physical frame address */
-                    uint32_t frame = (uint32_t)(pte & ~0xFFFULL);
-                    if (frame == 0) continue;
-                    /* increment refcount */
-                    frame_incref(frame);
-                    /* Clear writable bit on both parent and child PTEs */
-                    pt[m] = pte & ~0x2ULL; /* clear writable */
-                    pt_copy[m] = pt[m];
-                }
-            }
-        }
+/* Return the next-level table under entry *e, allocating a zeroed one if
+   the entry is not present. NULL on allocation failure or large page. */
+static uint64_t *pt_next_level(uint64_t *e) {
+    if (*e & 1) {
+        if (*e & (1ULL<<7)) return NULL;
+        return (uint64_t *)(*e & ~0xFFFULL);
     }
-
-    return new_pml4;
+    uint64_t *t = pt_alloc_table();
+    if (!t) return NULL;
+    memset(t, 0, 4096);
+    *e = (uint64_t)t | 0x7;   /* present, writable, user: the leaf decides */
+    return t;
 }
 
-void pt_set_cr3(void *p) { (void)p; /* no-op in host tests */ }
+/* no-op in host tests beyond the alignment check */
+int pt_set_cr3(void *p) { return ((uint64_t)p & 0xFFF) ? -1 : 0; }
+
+static void pt_flush_if_loaded(void *pml4_base) { (void)pml4_base; }
+static void pt_invlpg(uint64_t vaddr) { (void)vaddr; }
 
 #else
 /* In kernel builds, use existing pml4 symbol exported by start.S (identity mapping) */
@@ -121,10 +87,16 @@ extern uint64_t pml4[];
 
 void *pt_get_kernel_pml4(void) { return (void *)pml4; }
 
-/* Page-table helpers available in kernel build */
-/* kmalloc is defined in virtual_memory.c; declare it here so kernel builds
-    don't get implicit-declaration warnings when using kmalloc. */
-extern void *kmalloc(unsigned int size);
+/* Page tables must be 4 KiB aligned. This holds for the PML4 too: CR3
+   ignores bits 11:0, so an unaligned root would make the CPU walk
+   whatever page it starts in. Tables are whole frames from the frame
+   pool (aligned, identity mapped, and freeable), not kmalloc memory. */
+static uint64_t *pt_alloc_table(void) {
+    uint32_t f = alloc_frame();
+    return f ? (uint64_t *)(uintptr_t)f : NULL;
+}
+static void pt_free_table(uint64_t *t) { frame_decref((uint32_t)(uintptr_t)t); }
+
 uint64_t *pt_find_pte_for_vaddr(void *pml4_base, uint64_t vaddr) {
     uint64_t *pml4 = (uint64_t *)pml4_base;
     uint64_t pml4_idx = (vaddr >> 39) & 0x1FFULL;
@@ -149,61 +121,224 @@ uint64_t *pt_find_pte_for_vaddr(void *pml4_base, uint64_t vaddr) {
     return &pt[pt_idx];
 }
 
-void *pt_clone_for_cow(void *parent_pml4) {
-    if (!parent_pml4) return NULL;
-    void *new_pml4 = kmalloc(4096);
-    if (!new_pml4) return NULL;
-    memcpy(new_pml4, parent_pml4, 4096);
-
-    uint64_t *orig = (uint64_t *)parent_pml4;
-    uint64_t *copy = (uint64_t *)new_pml4;
-    for (int i = 0; i < 512; ++i) {
-        uint64_t pml4e = orig[i];
-        if (!(pml4e & 1)) continue;
-        uint64_t *pdpt = (uint64_t *)((uint64_t)(pml4e & ~0xFFFULL));
-        uint64_t *pdpt_copy = (uint64_t *)((uint64_t)(copy[i] & ~0xFFFULL));
-        if (!pdpt_copy) continue;
-        for (int j = 0; j < 512; ++j) {
-            uint64_t pdpte = pdpt[j];
-            if (!(pdpte & 1)) continue;
-            if (pdpte & (1ULL<<7)) continue;
-            uint64_t *pd = (uint64_t *)((uint64_t)(pdpte & ~0xFFFULL));
-            uint64_t *pd_copy = (uint64_t *)((uint64_t)(pdpt_copy[j] & ~0xFFFULL));
-            if (!pd_copy) continue;
-            for (int k = 0; k < 512; ++k) {
-                uint64_t pde = pd[k];
-                if (!(pde & 1)) continue;
-                if (pde & (1ULL<<7)) continue;
-                uint64_t *pt = (uint64_t *)((uint64_t)(pde & ~0xFFFULL));
-                uint64_t *pt_copy = (uint64_t *)((uint64_t)(pd_copy[k] & ~0xFFFULL));
-                if (!pt_copy) continue;
-                for (int m = 0; m < 512; ++m) {
-                    uint64_t pte = pt[m];
-                    if (!(pte & 1)) continue;
-                    uint32_t frame = (uint32_t)(pte & ~0xFFFULL);
-                    if (frame == 0) continue;
-                    frame_incref(frame);
-                    pt[m] = pte & ~0x2ULL;
-                    pt_copy[m] = pt[m];
-                }
-            }
-        }
+/* Return the next-level table under entry *e, allocating a zeroed one if
+   the entry is not present. NULL on allocation failure or large page. */
+static uint64_t *pt_next_level(uint64_t *e) {
+    if (*e & 1) {
+        if (*e & (1ULL<<7)) return NULL;
+        return (uint64_t *)(*e & ~0xFFFULL);
     }
-
-    return new_pml4;
+    uint64_t *t = pt_alloc_table();
+    if (!t) return NULL;
+    clear_page(t);
+    *e = (uint64_t)t | 0x7;   /* present, writable, user: the leaf decides */
+    return t;
 }
 
 /* Clone current kernel pml4 (simple memory copy) */
 void *pt_clone_current(void) {
-    void *new = kmalloc(4096);
+    void *new = pt_alloc_table();
     if (!new) return NULL;
-    memcpy(new, (void *)pml4, 4096);
+    copy_page(new, (void *)pml4);
     return new;
 }
 
-void pt_set_cr3(void *p) {
-    /* p is page-aligned physical address (identity mapped). Use MOV to CR3 */
-    asm volatile ("mov %0, %%cr3" :: "r"(p));
+int pt_set_cr3(void *p) {
+    /* p is a page-aligned physical address (identity mapped); refuse
+       anything else rather than run on a page that is not this PML4 */
+    if ((uint64_t)p & 0xFFF) return -1;
+    asm volatile ("mov %0, %%cr3" :: "r"(p) : "memory");
+    return 0;
+}
+
+/* Entries of a live address space changed (W cleared): drop its TLB */
+static void pt_flush_if_loaded(void *pml4_base) {
+    uint64_t cr3;
+    asm volatile ("mov %%cr3, %0" : "=r"(cr3));
+    if ((cr3 & ~0xFFFULL) == (uint64_t)pml4_base)
+        asm volatile ("mov %0, %%cr3" :: "r"(cr3) : "memory");
+}
+
+static void pt_invlpg(uint64_t vaddr) {
+    asm volatile ("invlpg (%0)" :: "r"(vaddr) : "memory");
 }
 
 #endif
+
+/* Physical address behind vaddr (4 KiB, 2 MiB or 1 GiB page), or
+   PT_NO_PHYS if it is not mapped */
+#define PT_ADDR_MASK 0x000FFFFFFFFFF000ULL
+uint64_t pt_virt_to_phys(void *pml4_base, uint64_t vaddr) {
+    uint64_t e = ((uint64_t *)pml4_base)[(vaddr >> 39) & 0x1FF];
+    if (!(e & 1)) return PT_NO_PHYS;
+    e = ((uint64_t *)(e & PT_ADDR_MASK))[(vaddr >> 30) & 0x1FF];
+    if (!(e & 1)) return PT_NO_PHYS;
+    if (e & (1ULL << 7)) return (e & PT_ADDR_MASK & ~0x3FFFFFFFULL) | (vaddr & 0x3FFFFFFFULL);
+    e = ((uint64_t *)(e & PT_ADDR_MASK))[(vaddr >> 21) & 0x1FF];
+    if (!(e & 1)) return PT_NO_PHYS;
+    if (e & (1ULL << 7)) return (e & PT_ADDR_MASK & ~0x1FFFFFULL) | (vaddr & 0x1FFFFFULL);
+    e = ((uint64_t *)(e & PT_ADDR_MASK))[(vaddr >> 12) & 0x1FF];
+    if (!(e & 1)) return PT_NO_PHYS;
+    return (e & PT_ADDR_MASK) | (vaddr & 0xFFFULL);
+}
+
+/* Copy the tables on the walk to vaddr that pml4_base still shares with
+   the kernel PML4, and split a 2 MiB page there into 512 4 KiB PTEs with
+   the same frames and flags. Stops at the first missing entry
+   (pt_map_page builds private tables from there). The kernel's entries
+   are supervisor-only; the ones leading to private tables get U so a
+   user leaf below them is reachable, the split PTEs keep the kernel's. */
+int pt_unshare(void *pml4_base, uint64_t vaddr) {
+    uint64_t *kern = (uint64_t *)pt_get_kernel_pml4();
+    uint64_t *t = (uint64_t *)pml4_base;
+    if (t == kern) return -1;
+    for (int shift = 39; shift > 12; shift -= 9) {
+        uint64_t *e = &t[(vaddr >> shift) & 0x1FF];
+        uint64_t ke = kern ? kern[(vaddr >> shift) & 0x1FF] : 0;
+        if (!(*e & 1)) return 0;
+        if (*e & (1ULL << 7)) {
+            if (shift != 21) return -1;          /* 1 GiB page */
+            uint64_t *pt = pt_alloc_table();
+            if (!pt) return -1;
+            uint64_t base = *e & PT_ADDR_MASK & ~0x1FFFFFULL;
+            uint64_t flags = *e & ~PT_ADDR_MASK & ~(1ULL << 7);
+            for (int i = 0; i < 512; i++) pt[i] = (base + (uint64_t)i * 4096) | flags;
+            *e = (uint64_t)pt | flags;
+        } else if ((ke & 1) && !(ke & (1ULL << 7)) && (ke & PT_ADDR_MASK) == (*e & PT_ADDR_MASK)) {
+            uint64_t *copy = pt_alloc_table();
+            if (!copy) return -1;
+            memcpy(copy, (void *)(*e & PT_ADDR_MASK), 4096);
+            *e = (uint64_t)copy | (*e & ~PT_ADDR_MASK);
+        }
+        *e |= 0x4;
+        kern = ((ke & 1) && !(ke & (1ULL << 7))) ? (uint64_t *)(ke & PT_ADDR_MASK) : NULL;
+        t = (uint64_t *)(*e & PT_ADDR_MASK);
+    }
+    return 0;
+}
+
+int pt_map_page(void *pml4_base, uint64_t vaddr, uint64_t paddr, uint64_t flags) {
+    uint64_t *pml4 = (uint64_t *)pml4_base;
+    /* never write through tables the kernel PML4 (and so everyone) uses */
+    if (pml4_base != pt_get_kernel_pml4() && pt_unshare(pml4_base, vaddr) < 0) return -1;
+    uint64_t *pdpt = pt_next_level(&pml4[(vaddr >> 39) & 0x1FF]);
+    if (!pdpt) return -1;
+    uint64_t *pd = pt_next_level(&pdpt[(vaddr >> 30) & 0x1FF]);
+    if (!pd) return -1;
+    uint64_t *pt = pt_next_level(&pd[(vaddr >> 21) & 0x1FF]);
+    if (!pt) return -1;
+    pt[(vaddr >> 12) & 0x1FF] = (paddr & ~0xFFFULL) | (flags & 0xFFF) | 1;
+    return 0;
+}
+
+uint64_t pt_user_bytes(void *pml4_base, uint64_t vaddr, uint64_t n) {
+    uint64_t done = 0;
+    while (done < n) {
+        uint64_t va = vaddr + done, span = 0;
+        uint64_t *t = (uint64_t *)pml4_base;
+        for (int shift = 39; shift >= 12; shift -= 9) {
+            uint64_t e = t[(va >> shift) & 0x1FF];
+            if ((e & 0x5) != 0x5) return done;
+            if (shift == 12 || (shift < 39 && (e & (1ULL << 7)))) {
+                span = 1ULL << shift;
+                break;
+            }
+            t = (uint64_t *)(e & PT_ADDR_MASK);
+        }
+        uint64_t step = span - (va & (span - 1));
+        done = step >= n - done ? n : done + step;
+    }
+    return n;
+}
+
+uint64_t pt_unmap_page(void *pml4_base, uint64_t vaddr) {
+    uint64_t *pte = pt_find_pte_for_vaddr(pml4_base, vaddr);
+    if (!pte || !(*pte & 1)) return 0;
+    uint64_t old = *pte;
+    *pte = 0;
+    pt_invlpg(vaddr);
+    return old;
+}
+
+/* Drop this PML4's reference on every pool frame mapped by a 4 KiB user
+   PTE in tables it does not share with the kernel, and free those tables.
+   Supervisor PTEs (the identity entries a pt_unshare split leaves) are
+   the kernel's. */
+static void pt_release_level(uint64_t *t, uint64_t *kern, int shift) {
+    for (int i = 0; i < 512; i++) {
+        uint64_t e = t[i], pa = e & PT_ADDR_MASK;
+        if (!(e & 1)) continue;
+        if (shift == 12) {
+            if ((e & 0x4) && !(e & PTE_NOFORK) && pa >= FRAME_POOL_START) frame_decref((uint32_t)pa);
+            continue;
+        }
+        if (e & (1ULL << 7)) continue;
+        uint64_t ke = kern ? kern[i] : 0;
+        int kern_table = (ke & 1) && !(ke & (1ULL << 7));
+        if (kern_table && (ke & PT_ADDR_MASK) == pa) continue;
+        pt_release_level((uint64_t *)pa, kern_table ? (uint64_t *)(ke & PT_ADDR_MASK) : NULL,
+                         shift - 9);
+        pt_free_table((uint64_t *)pa);
+    }
+}
+
+void pt_destroy(void *pml4_base) {
+    uint64_t *kern = (uint64_t *)pt_get_kernel_pml4();
+    if (!pml4_base || pml4_base == kern) return;
+    pt_release_level((uint64_t *)pml4_base, kern, 39);
+    pt_free_table((uint64_t *)pml4_base);
+}
+
+/* One level of pt_clone_for_cow: *out is the copy of t (NULL if no table
+   could be had), with every entry after a failure cleared so it can be
+   released as it is */
+static int pt_cow_level(uint64_t *t, uint64_t *kern, int shift, uint64_t **out) {
+    uint64_t *copy = pt_alloc_table();
+    *out = copy;
+    if (!copy) return -1;
+    for (int i = 0; i < 512; i++) {
+        uint64_t e = t[i];
+        copy[i] = e;
+        if (!(e & 1)) continue;
+        if (shift == 12) {
+            if (e & PTE_NOFORK) {
+                copy[i] = 0;
+            } else if (e & 0x4) {
+                frame_incref((uint32_t)(e & PT_ADDR_MASK));
+                t[i] = copy[i] = e & ~0x2ULL;
+            }
+            continue;
+        }
+        if (e & (1ULL << 7)) continue;
+        uint64_t ke = kern ? kern[i] : 0;
+        int kern_table = (ke & 1) && !(ke & (1ULL << 7));
+        if (kern_table && (ke & PT_ADDR_MASK) == (e & PT_ADDR_MASK)) continue;
+        uint64_t *sub;
+        int r = pt_cow_level((uint64_t *)(e & PT_ADDR_MASK),
+                             kern_table ? (uint64_t *)(ke & PT_ADDR_MASK) : NULL, shift - 9, &sub);
+        copy[i] = sub ? (uint64_t)sub | (e & ~PT_ADDR_MASK) : 0;
+        if (r < 0) {
+            while (++i < 512) copy[i] = 0;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Clone for fork with copy-on-write. Every table the parent does not
+   share with the kernel PML4 is copied, so parent and child have no
+   table in common below the kernel's own. Each present 4 KiB user page
+   (U set) becomes shared: its frame gains a reference and loses W on
+   both sides, and the first write faults into the COW handler.
+   Supervisor entries and large pages are copied as they are. */
+void *pt_clone_for_cow(void *parent_pml4) {
+    if (!parent_pml4) return NULL;
+    uint64_t *copy;
+    int r = pt_cow_level((uint64_t *)parent_pml4, (uint64_t *)pt_get_kernel_pml4(), 39, &copy);
+    pt_flush_if_loaded(parent_pml4);
+    if (r < 0) {
+        if (copy) pt_destroy(copy);
+        return NULL;
+    }
+    return copy;
+}
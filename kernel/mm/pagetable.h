@@ -5,12 +5,49 @@
 #include <stdint.h>
 
 void *pt_clone_current(void);
-void pt_set_cr3(void *p);
+/* Load p (4 KiB aligned) into CR3; -1 and nothing loaded if unaligned */
+int pt_set_cr3(void *p);
 void *pt_get_kernel_pml4(void);
 
 /* Helpers for page-table walk (return pointer to PTE for vaddr in the given PML4 base, or NULL) */
 uint64_t *pt_find_pte_for_vaddr(void *pml4_base, uint64_t vaddr);
 
+/* Map one 4 KiB page vaddr -> paddr (PTE flags in the low bits) in the
+   given PML4, creating missing PDPT/PD/PT levels as user-accessible
+   tables. A process PML4 first gets private copies of the kernel tables
+   on the way (pt_unshare). Returns 0, or -1 if a table cannot be
+   allocated or vaddr lies in a large page of the kernel PML4. */
+int pt_map_page(void *pml4_base, uint64_t vaddr, uint64_t paddr, uint64_t flags);
+
+/* Software PTE bit: the page belongs to a kernel object (a uring ring),
+   not to the address space. fork does not pass it on and pt_destroy
+   leaves the frame alone; the owner unmaps and frees it. */
+#define PTE_NOFORK 0x200ULL
+
+/* Clear the 4 KiB mapping of vaddr (and its TLB entry on this CPU).
+   Returns the old PTE, 0 if nothing was mapped. */
+uint64_t pt_unmap_page(void *pml4_base, uint64_t vaddr);
+
+/* How many of the n bytes at vaddr ring 3 may touch through pml4_base:
+   counts up to the first page that is not present with U set at every
+   level of the walk */
+uint64_t pt_user_bytes(void *pml4_base, uint64_t vaddr, uint64_t n);
+
+/* Translate vaddr through the given PML4, any page size */
+#define PT_NO_PHYS (~0ULL)
+uint64_t pt_virt_to_phys(void *pml4_base, uint64_t vaddr);
+
+/* Give pml4_base its own copies of the kernel tables that translate
+   vaddr, splitting a 2 MiB page there, so pt_map_page(vaddr) changes only
+   this address space. -1 on allocation failure, a 1 GiB page or the
+   kernel PML4 itself. */
+int pt_unshare(void *pml4_base, uint64_t vaddr);
+
+/* Tear down an address space: frame_decref every user frame-pool page
+   mapped in tables private to pml4_base, then free those tables and
+   pml4_base itself. It must not be loaded in CR3 (sched_forget_mm). */
+void pt_destroy(void *pml4_base);
+
 /* Clone PML4 for fork with Copy-On-Write semantics: returns new PML4 pointer */
 void *pt_clone_for_cow(void *parent_pml4);
 
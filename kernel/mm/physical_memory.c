@@ -1,5 +1,7 @@
 /* kernel/mm/physical_memory.c - simple physical memory bitmap (stub) */
 #include <stdint.h>
+#include "physical_memory.h"
+#include "../arch/x86/cpu.h"
 #define FRAME_SIZE 4096
 #define MAX_FRAMES 32768  /* 128MB / 4KB */
 
@@ -13,38 +15,104 @@ static inline void set_frame(uint32_t frame) { frame_bitmap[frame/8] |= (1 << (f
 static inline void clear_frame(uint32_t frame) { frame_bitmap[frame/8] &= ~(1 << (frame%8)); }
 static inline int test_frame(uint32_t frame) { return frame_bitmap[frame/8] & (1 << (frame%8)); }
 
+/* No frame below this index is free: the scan starts here and skips
+   whole bytes of used frames */
+static uint32_t free_hint;
+
 uint32_t first_free_frame(void) {
-    for (uint32_t i=0;i<MAX_FRAMES;i++) if (!test_frame(i)) return i;
+    for (uint32_t i = free_hint / 8; i < MAX_FRAMES / 8; i++) {
+        if (frame_bitmap[i] == 0xFF) continue;
+        for (uint32_t f = i * 8; f < i * 8 + 8; f++) {
+            if (!test_frame(f)) {
+                free_hint = f;
+                return f;
+            }
+        }
+    }
     return (uint32_t)-1;
 }
 
+/* Keep every frame below `end` out of the allocator for good */
+void frame_reserve_below(uint64_t end) {
+    uint32_t n = (uint32_t)((end + FRAME_SIZE - 1) / FRAME_SIZE);
+    if (n > MAX_FRAMES) n = MAX_FRAMES;
+    for (uint32_t f = 0; f < n; f++) {
+        set_frame(f);
+        frame_refcount[f] = 1;
+    }
+}
+
+/* Boot: the low 64 MiB hold the kernel image (1 MiB), user program
+   images (4 MiB) and the kmalloc heap (16 MiB up); frames come from
+   above */
+void physical_memory_init(void) {
+    frame_reserve_below(FRAME_POOL_START);
+}
+
+/* The bitmap and counts are changed with interrupts off: a dying task is
+   reaped from the timer interrupt, which drops its frames (pt_destroy)
+   while a process may be in the middle of an allocation. */
 uint32_t alloc_frame(void) {
+    uint64_t flags = irq_save();
     uint32_t f = first_free_frame();
-    if (f == (uint32_t)-1) return 0;
+    if (f == (uint32_t)-1) {
+        irq_restore(flags);
+        return 0;
+    }
     set_frame(f);
     /* Initialize refcount for allocated frame */
     frame_refcount[f] = 1;
+    irq_restore(flags);
     return f * FRAME_SIZE;
 }
 
+uint32_t alloc_frames(uint32_t n) {
+    if (!n) return 0;
+    uint64_t flags = irq_save();
+    uint32_t run = 0;
+    for (uint32_t f = free_hint; f < MAX_FRAMES; f++) {
+        run = test_frame(f) ? 0 : run + 1;
+        if (run < n) continue;
+        uint32_t first = f + 1 - n;
+        for (uint32_t i = first; i <= f; i++) {
+            set_frame(i);
+            frame_refcount[i] = 1;
+        }
+        irq_restore(flags);
+        return first * FRAME_SIZE;
+    }
+    irq_restore(flags);
+    return 0;
+}
+
 void free_frame(uint32_t addr) {
     uint32_t frame = addr / FRAME_SIZE;
+    uint64_t flags = irq_save();
     clear_frame(frame);
     frame_refcount[frame] = 0;
+    if (frame < free_hint) free_hint = frame;
+    irq_restore(flags);
 }
 
 /* Increase reference count for a physical frame (address must be frame aligned) */
 void frame_incref(uint32_t addr) {
     uint32_t frame = addr / FRAME_SIZE;
+    uint64_t flags = irq_save();
     if (frame < MAX_FRAMES) frame_refcount[frame]++;
+    irq_restore(flags);
 }
 
 /* Decrease reference count and free frame if reaches zero */
 void frame_decref(uint32_t addr) {
     uint32_t frame = addr / FRAME_SIZE;
     if (frame >= MAX_FRAMES) return;
+    uint64_t flags = irq_save();
     if (frame_refcount[frame] > 0) frame_refcount[frame]--;
-    if (frame_refcount[frame] == 0) clear_frame(frame);
+    if (frame_refcount[frame] == 0) {
+        clear_frame(frame);
+        if (frame < free_hint) free_hint = frame;
+    }
+    irq_restore(flags);
 }
 
 /* Return refcount for a given frame address */
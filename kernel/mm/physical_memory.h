@@ -8,11 +8,21 @@
 uint32_t alloc_frame(void);
 void free_frame(uint32_t addr);
 
+/* n physically contiguous frames (refcount 1 each), or 0. Each is given
+   back with frame_decref. */
+uint32_t alloc_frames(uint32_t n);
+
 /* Frame reference counting for COW */
 void frame_incref(uint32_t addr);
 void frame_decref(uint32_t addr);
 int frame_refcount_get(uint32_t addr);
 
+/* Boot: frames below `end` belong to the kernel and are never handed out.
+   physical_memory_init reserves everything below FRAME_POOL_START. */
+#define FRAME_POOL_START 0x04000000ULL
+void frame_reserve_below(uint64_t end);
+void physical_memory_init(void);
+
 /* Utility */
 uint32_t first_free_frame(void);
 
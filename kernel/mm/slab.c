@@ -0,0 +1,68 @@
+/* kernel/mm/slab.c - fixed-size object caches on top of kmalloc */
+#include "slab.h"
+#include "../arch/x86/cpu.h"
+#include <stddef.h>
+#include <string.h>
+
+extern void *kmalloc(unsigned int size);
+
+#define SLAB_BYTES (64 * 1024)   /* backing chunk size (one object if larger) */
+
+/* First use: round the object size and work out how many fit in a slab */
+static void cache_setup(kmem_cache_t *c) {
+    if (c->align < sizeof(void *)) c->align = sizeof(void *);
+    uint32_t size = c->obj_size < sizeof(void *) ? sizeof(void *) : c->obj_size;
+    c->obj_size = (size + c->align - 1) & ~(c->align - 1);
+    c->objs_per_slab = SLAB_BYTES / c->obj_size;
+    if (c->objs_per_slab == 0) c->objs_per_slab = 1;
+}
+
+static int cache_grow(kmem_cache_t *c) {
+    uint64_t bytes = (uint64_t)c->obj_size * c->objs_per_slab;
+    uint8_t *raw = (uint8_t *)kmalloc((unsigned int)(bytes + c->align - 1));
+    if (!raw) return -1;
+    uint8_t *base = (uint8_t *)(((uintptr_t)raw + c->align - 1) & ~(uintptr_t)(c->align - 1));
+
+    /* Thread the new objects onto the free list, lowest address first */
+    for (uint32_t i = c->objs_per_slab; i-- > 0;) {
+        void **obj = (void **)(base + (uint64_t)i * c->obj_size);
+        *obj = c->free_list;
+        c->free_list = obj;
+    }
+    c->slabs++;
+    return 0;
+}
+
+void *kmem_cache_alloc(kmem_cache_t *c) {
+    uint64_t flags = irq_save();
+    if (!c->objs_per_slab) cache_setup(c);
+    if (!c->free_list && cache_grow(c) < 0) {
+        irq_restore(flags);
+        return NULL;
+    }
+
+    void **obj = (void **)c->free_list;
+    c->free_list = *obj;
+    c->in_use++;
+    irq_restore(flags);
+    return obj;
+}
+
+void *kmem_cache_zalloc(kmem_cache_t *c) {
+    void *obj = kmem_cache_alloc(c);
+    if (obj) memset(obj, 0, c->obj_size);
+    return obj;
+}
+
+void kmem_cache_free(kmem_cache_t *c, void *obj) {
+    if (!obj) return;
+    uint64_t flags = irq_save();
+    *(void **)obj = c->free_list;
+    c->free_list = obj;
+    c->in_use--;
+    irq_restore(flags);
+}
+
+uint64_t kmem_cache_bytes(const kmem_cache_t *c) {
+    return c->slabs * c->objs_per_slab * (uint64_t)c->obj_size;
+}
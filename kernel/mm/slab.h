@@ -0,0 +1,42 @@
+/* kernel/mm/slab.h
+ * Fixed-size object caches. Objects are carved from slabs obtained with
+ * kmalloc and recycled through a per-cache free list, so a workload that
+ * keeps creating and destroying objects of one type stays flat in memory.
+ * Slabs are never handed back (kmalloc cannot free yet).
+ *
+ * Alloc and free hold interrupts off around the free list, so they may be
+ * called from process context and from the timer interrupt alike (the
+ * scheduler reaps tasks and releases FPU areas there).
+ */
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdint.h>
+
+typedef struct kmem_cache {
+    const char *name;
+    uint32_t obj_size;        /* object size rounded up to the alignment */
+    uint32_t align;
+    uint32_t objs_per_slab;
+    void    *free_list;       /* free objects, linked through their first word */
+    uint64_t slabs;           /* slabs carved so far */
+    uint64_t in_use;          /* objects currently allocated */
+} kmem_cache_t;
+
+/* Static initializer, e.g. static kmem_cache_t c = KMEM_CACHE_INIT("x", sizeof(x), 16); */
+#define KMEM_CACHE_INIT(n, size, al) { (n), (size), (al), 0, 0, 0, 0 }
+
+/* Allocate one object (contents undefined), NULL if out of memory */
+void *kmem_cache_alloc(kmem_cache_t *c);
+
+/* Allocate one zero-filled object */
+void *kmem_cache_zalloc(kmem_cache_t *c);
+
+/* Return an object to its cache */
+void kmem_cache_free(kmem_cache_t *c, void *obj);
+
+/* Bytes of backing memory the cache holds (in use or free) */
+uint64_t kmem_cache_bytes(const kmem_cache_t *c);
+
+#endif /* SLAB_H */
@@ -4,6 +4,10 @@
 #include <string.h>
 #include "../drivers/serial.h"
 #include "../process_manager.h"
+#include "page.h"
+#include "physical_memory.h"
+#include "../klog.h"
+#include "../arch/x86/cpu.h"
 #ifdef HOST_TEST
 #include <stdlib.h>
 #endif
@@ -153,11 +157,41 @@ int virtual_memory_refcount(uint64_t vaddr) {
     return r->refcount;
 }
 
+#ifndef HOST_TEST
+/* Frame layout from isr_0x0e: 15 saved GPRs, the error code, then the
+   CPU's RIP, CS, RFLAGS, RSP, SS */
+#define PF_ERR  15
+#define PF_RIP  16
+#define PF_CS   17
+#define PF_ERR_WRITE 0x2
+
+/* A kernel fault inside a user copy (arch/x86/uaccess.c) resumes at its
+   exception-table fixup, which reports the failure to the syscall,
+   instead of taking the task down */
+static int pf_fixup(uint64_t *regs) {
+    extern uint64_t extable_search(uint64_t rip);
+    if (regs[PF_CS] & 3) return 0;
+    uint64_t fixup = extable_search(regs[PF_RIP]);
+    if (!fixup) return 0;
+    klog_debug("[pf] fault in user copy at rip=0x%lx -> fixup", regs[PF_RIP]);
+    regs[PF_RIP] = fixup;
+    return 1;
+}
+
+/* Unresolvable fault: report it, kill the current task and stop */
+static void __attribute__((noreturn)) pf_kill(uint64_t fault_addr, const char *why) {
+    extern process_t *pm_get_current(void);
+    serial_panic();     /* the ring is never drained once this CPU halts */
+    klog_flush();       /* what led up to the fault, then the fault itself */
+    klog_err("[pf] fault at 0x%lx: %s -> killing", fault_addr, why);
+    process_t *cur = pm_get_current();
+    if (cur) { cur->state = 3; cur->exit_code = -1; }
+    for(;;) asm volatile("hlt");
+}
+#endif
+
 uint64_t page_fault_handler(uint64_t *saved_regs_ptr, uint64_t fault_addr) {
     (void)saved_regs_ptr;
-    serial_puts("[pf] page fault at 0x");
-    serial_put_hex((uint64_t)fault_addr);
-    serial_putc('\n');
 
 #ifdef HOST_TEST
     void *w = virtual_memory_make_writable(fault_addr, 4096);
@@ -170,7 +204,8 @@ uint64_t page_fault_handler(uint64_t *saved_regs_ptr, uint64_t fault_addr) {
        1) Find PTE for faulting address
        2) If PTE present, not writable and frame_refcount > 1 -> allocate new frame
        3) Copy page contents and update PTE to new frame with writable bit
-    */
+       The resolved paths stay silent: a fork-heavy workload takes one
+       fault per touched page, and a serial line each would dominate. */
     extern uint64_t *pt_find_pte_for_vaddr(void *pml4_base, uint64_t vaddr);
     extern void *pt_get_kernel_pml4(void);
     extern uint32_t alloc_frame(void);
@@ -182,64 +217,50 @@ uint64_t page_fault_handler(uint64_t *saved_regs_ptr, uint64_t fault_addr) {
     asm volatile ("mov %%cr3, %0" : "=r" (cr3));
     uint64_t *pte_ptr = pt_find_pte_for_vaddr((void *)cr3, fault_addr);
     if (!pte_ptr) {
-        serial_puts("[pf] no page-table entry -> killing\n");
-        /* kill process */
-        extern process_t *pm_get_current(void);
-        process_t *cur = pm_get_current();
-        if (cur) { cur->state = 3; cur->exit_code = -1; }
-        for(;;) asm volatile("hlt");
+        if (pf_fixup(saved_regs_ptr)) return (uint64_t)saved_regs_ptr;
+        pf_kill(fault_addr, "no page-table entry");
     }
 
     uint64_t pte = *pte_ptr;
     if (!(pte & 1)) {
-        serial_puts("[pf] pte not present -> killing\n");
-        extern process_t *pm_get_current(void);
-        process_t *cur = pm_get_current();
-        if (cur) { cur->state = 3; cur->exit_code = -1; }
-        for(;;) asm volatile("hlt");
+        if (pf_fixup(saved_regs_ptr)) return (uint64_t)saved_regs_ptr;
+        pf_kill(fault_addr, "pte not present");
     }
 
-    /* if writable - not a write fault COW, escalate */
-    if (pte & 0x2) {
-        serial_puts("[pf] page already writable -> escalate\n");
-        extern process_t *pm_get_current(void);
-        process_t *cur = pm_get_current();
-        if (cur) { cur->state = 3; cur->exit_code = -1; }
-        for(;;) asm volatile("hlt");
+    /* Only a write to a read-only page can be COW. The vDSO is read-only
+       but shared by every process: never hand out a writable copy. */
+    extern int vdso_contains(uint64_t vaddr);
+    if ((pte & 0x2) || !(saved_regs_ptr[PF_ERR] & PF_ERR_WRITE) || vdso_contains(fault_addr)) {
+        if (pf_fixup(saved_regs_ptr)) return (uint64_t)saved_regs_ptr;
+        pf_kill(fault_addr, "not a COW fault");
     }
 
-    uint32_t frame = (uint32_t)(pte & ~0xFFFULL);
+    uint32_t frame = (uint32_t)(pte & 0x000FFFFFFFFFF000ULL);
+    uint64_t page_base = fault_addr & ~0xFFFULL;
     int refc = frame_refcount_get(frame);
     if (refc <= 1) {
-        serial_puts("[pf] frame refcount<=1 -> make writable and continue\n");
         *pte_ptr = pte | 0x2; /* make writable */
+        invlpg(page_base);
         return (uint64_t)saved_regs_ptr;
     }
 
     /* allocate new frame and copy page contents */
     uint32_t newframe = alloc_frame();
-    if (!newframe) { serial_puts("[pf] alloc_frame failed\n");
-        /* kill process */
-        extern process_t *pm_get_current(void);
-        process_t *cur = pm_get_current();
-        if (cur) {
-            cur->state = 3;
-            cur->exit_code = -1;
-        }
-        for(;;) asm volatile("hlt");
+    if (!newframe) {
+        if (pf_fixup(saved_regs_ptr)) return (uint64_t)saved_regs_ptr;
+        pf_kill(fault_addr, "alloc_frame failed");
     }
-    uint64_t page_base = fault_addr & ~0xFFFULL;
-    /* identity mapping guarantees page_base can be used as pointer */
-    memcpy((void *)(uintptr_t)newframe, (const void *)page_base, 4096);
+    /* both frames through the identity map: the faulting address is a
+       user page, which the kernel may not read under SMAP */
+    copy_page((void *)(uintptr_t)newframe, (const void *)(uintptr_t)frame);
 
     /* Update PTE to new frame and set writable */
-    uint64_t newpte = (uint64_t)newframe | (pte & 0xFFFULL) | 0x2ULL; /* keep flags and set writable */
+    uint64_t newpte = (uint64_t)newframe | (pte & ~0x000FFFFFFFFFF000ULL) | 0x2ULL; /* keep flags and set writable */
     *pte_ptr = newpte;
+    invlpg(page_base);
 
     /* reduce old frame refcount */
     frame_decref(frame);
-
-    serial_puts("[pf] performed kernel COW, continuing\n");
     return (uint64_t)saved_regs_ptr;
 #endif
 
@@ -247,9 +268,7 @@ uint64_t page_fault_handler(uint64_t *saved_regs_ptr, uint64_t fault_addr) {
     extern process_t *pm_get_current(void);
     process_t *cur = pm_get_current();
     if (cur) {
-        serial_puts("[pf] killing process pid=");
-        serial_put_hex(cur->pid);
-        serial_putc('\n');
+        klog_err("[pf] killing process pid=%lu", cur->pid);
         cur->state = 3; /* dead */
         cur->exit_code = -1;
     }
@@ -258,7 +277,10 @@ uint64_t page_fault_handler(uint64_t *saved_regs_ptr, uint64_t fault_addr) {
     for(;;) asm volatile("hlt");
 }
 
-/* Legacy kmalloc stub */
+/* Legacy kmalloc stub: a bump allocator over [16 MiB, FRAME_POOL_START).
+   The slab caches grow through it from the timer interrupt, so the bump
+   is a CAS (no lock, no window for a nested call); it never frees and
+   returns NULL rather than run into the frame pool. */
 void *kmalloc(unsigned int size) {
 #ifdef HOST_TEST
     /* When running host-side unit tests, fall back to malloc so pointers
@@ -266,9 +288,12 @@ void *kmalloc(unsigned int size) {
     return malloc(size);
 #else
     static uint64_t heap = 0x01000000; /* 16MB start */
-    void *ptr = (void *)heap;
-    heap += size;
-    return ptr;
+    uint64_t p = __atomic_load_n(&heap, __ATOMIC_RELAXED);
+    do {
+        if (size > FRAME_POOL_START - p) return NULL;
+    } while (!__atomic_compare_exchange_n(&heap, &p, p + size, 0,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    return (void *)p;
 #endif
 }
 
@@ -0,0 +1,174 @@
+/* kernel/page_ipc_bench.c
+ * Page-transfer IPC against copying (build with -DRUN_PAGE_IPC_BENCH).
+ * For message sizes from 4 KiB to 64 MiB the task, on a private PML4,
+ * times:
+ *   copy   one memcpy from the source window into a mapped destination
+ *          (what any copying IPC pays at least once; ipc_send/ipc_recv
+ *          copy twice)
+ *   move   ipc_send_pages(MOVE) + ipc_recv_pages into the empty
+ *          destination window, then the same back
+ *   share  ipc_send_pages(SHARE) + ipc_recv_pages; the window is torn
+ *          down and the source made writable again outside the timing
+ * and reports MiB/s for each. Both windows are 4 KiB mappings of 64 MiB
+ * of physical memory above the frame allocator's range (128 MiB up), so
+ * run it with -m 512M as tests/qemu_bench.sh does.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "ipc/page_ipc.h"
+#include "mm/page.h"
+#include "mm/pagetable.h"
+#include "mm/physical_memory.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+extern void *kmalloc(unsigned int size);
+extern void *memcpy(void *dst, const void *src, size_t n);
+
+#define MAX_BYTES  IPC_PAGES_MAX_BYTES
+#define SRC_BASE   0x0000008000000000ULL     /* PML4 slot 1: unused by the kernel */
+#define DST_BASE   (SRC_BASE + (1ULL << 30))
+#define SRC_PHYS   (128ULL << 20)            /* above MAX_FRAMES: not allocator frames */
+#define COPY_PHYS  (SRC_PHYS + MAX_BYTES)
+#define SIZES      8                         /* 4 KiB << 2*i */
+#define WORK_BYTES (256ULL << 20)            /* moved per size and method */
+
+static uint64_t cyc[3][SIZES];
+static int bad[3][SIZES];
+
+static uint64_t size_of(int s) { return (uint64_t)PAGE_SIZE << (2 * s); }
+
+static uint32_t iters_of(uint64_t size) {
+    uint64_t n = WORK_BYTES / size;
+    return (uint32_t)(n < 4 ? 4 : n > 4096 ? 4096 : n);
+}
+
+static int map_window(void *pml4, uint64_t va, uint64_t phys, uint64_t bytes) {
+    for (uint64_t off = 0; off < bytes; off += PAGE_SIZE)
+        if (pt_map_page(pml4, va + off, phys + off, 0x7) < 0) return -1;
+    return 0;
+}
+
+/* the page index is stored in the first word of every source page */
+static int check(uint64_t va, uint64_t size) {
+    uint64_t last = size / PAGE_SIZE - 1;
+    return *(volatile uint64_t *)va == 0 &&
+           *(volatile uint64_t *)(va + last * PAGE_SIZE) == last;
+}
+
+/* after a SHARE receive: drop the receiver's mapping and reference and
+   give the sender its writable pages back */
+static void unshare(void *pml4, uint64_t size) {
+    for (uint64_t off = 0; off < size; off += PAGE_SIZE) {
+        uint64_t *d = pt_find_pte_for_vaddr(pml4, DST_BASE + off);
+        frame_decref((uint32_t)(*d & ~0xFFFULL));
+        *d = 0;
+        *pt_find_pte_for_vaddr(pml4, SRC_BASE + off) |= 0x2;
+    }
+    pt_set_cr3(pml4);
+}
+
+static void run_transfers(void *pml4, int s) {
+    uint64_t size = size_of(s);
+    uint32_t n = iters_of(size);
+    uint64_t t0 = rdtsc();
+    for (uint32_t i = 0; i < n; i++) {
+        if (ipc_send_pages(pml4, SRC_BASE, size, IPC_PAGES_MOVE) < 0 ||
+            ipc_recv_pages(pml4, DST_BASE, size) != (int64_t)size ||
+            ipc_send_pages(pml4, DST_BASE, size, IPC_PAGES_MOVE) < 0 ||
+            ipc_recv_pages(pml4, SRC_BASE, size) != (int64_t)size) {
+            bad[1][s] = 1;
+            break;
+        }
+    }
+    cyc[1][s] = (rdtsc() - t0) / 2;              /* two moves per round */
+    bad[1][s] |= !check(SRC_BASE, size);
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n && !bad[2][s]; i++) {
+        t0 = rdtsc();
+        if (ipc_send_pages(pml4, SRC_BASE, size, IPC_PAGES_SHARE) < 0 ||
+            ipc_recv_pages(pml4, DST_BASE, size) != (int64_t)size)
+            bad[2][s] = 1;
+        sum += rdtsc() - t0;
+        if (!bad[2][s]) {
+            if (i == 0) bad[2][s] |= !check(DST_BASE, size);
+            unshare(pml4, size);
+        }
+    }
+    cyc[2][s] = sum;
+}
+
+static void report(int s) {
+    static const char *names[3] = { "copy", "move", "share" };
+    uint64_t size = size_of(s);
+    uint64_t bytes = size * iters_of(size);
+    serial_puts("[page_ipc_bench] size_kib=");
+    serial_put_dec(size >> 10);
+    for (int m = 0; m < 3; m++) {
+        uint64_t ns = timer_tsc_to_ns(cyc[m][s]);
+        serial_putc(' ');
+        serial_puts(names[m]);
+        serial_puts("_mib_s=");
+        serial_put_dec(ns ? (bytes >> 10) * 1000000000ULL / ns >> 10 : 0);
+        serial_putc(' ');
+        serial_puts(names[m]);
+        serial_puts("_cycles=");
+        serial_put_dec(cyc[m][s] / iters_of(size));
+        if (bad[m][s]) serial_puts(" FAILED");
+    }
+    serial_putc('\n');
+}
+
+static void page_ipc_bench_task(void) {
+    /* private PML4 (page aligned for CR3) sharing the kernel's tables */
+    uint64_t raw = (uint64_t)kmalloc(2 * PAGE_SIZE);
+    if (!raw) {
+        serial_puts("[page_ipc_bench] out of kernel heap\n");
+        return;
+    }
+    void *pml4 = (void *)((raw + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1));
+    copy_page(pml4, pt_get_kernel_pml4());
+    for (uint64_t p = 0; p < MAX_BYTES / PAGE_SIZE; p++)
+        *(uint64_t *)(SRC_PHYS + p * PAGE_SIZE) = p;
+    if (map_window(pml4, SRC_BASE, SRC_PHYS, MAX_BYTES) < 0) {
+        serial_puts("[page_ipc_bench] cannot map the source window\n");
+        return;
+    }
+
+    process_t *cur = pm_get_current();
+    uint64_t *kernel_pt = cur->page_table;
+    cur->page_table = (uint64_t *)pml4;
+    pt_set_cr3(pml4);
+
+    /* transfers first, while the destination window is empty */
+    for (int s = 0; s < SIZES; s++) run_transfers(pml4, s);
+
+    if (map_window(pml4, DST_BASE, COPY_PHYS, MAX_BYTES) < 0) {
+        serial_puts("[page_ipc_bench] cannot map the copy window\n");
+    } else {
+        for (int s = 0; s < SIZES; s++) {
+            uint64_t size = size_of(s);
+            uint32_t n = iters_of(size);
+            uint64_t t0 = rdtsc();
+            for (uint32_t i = 0; i < n; i++) memcpy((void *)DST_BASE, (const void *)SRC_BASE, size);
+            cyc[0][s] = rdtsc() - t0;
+            bad[0][s] = !check(DST_BASE, size);
+        }
+    }
+
+    for (int s = 0; s < SIZES; s++) report(s);
+
+    cur->page_table = kernel_pt;
+    pt_set_cr3(kernel_pt ? (void *)kernel_pt : pt_get_kernel_pml4());
+    serial_puts("[page_ipc_bench] done\n");
+}
+
+void page_ipc_bench(void) {
+    serial_puts("[page_ipc_bench] creating benchmark task\n");
+    task_create(page_ipc_bench_task);
+}
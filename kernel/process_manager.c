@@ -1,42 +1,168 @@
-/* kernel/process_manager.c - phase1 process registry (simple) */
+/* kernel/process_manager.c - process registry, PID allocation and PCB lifetime */
 #include "process_manager.h"
+#include "mm/slab.h"
+#include "rcu.h"
+#include "trace.h"
+#include <stddef.h>
 #include "drivers/serial.h"
+#include "klog.h"
+#include "arch/x86/cpu.h"
 #include <string.h>
 
-static process_t *pm_proc_table[PM_MAX_PROCS];
+extern void *kmalloc(unsigned int size);
+
+/* The authoritative list of live (and zombie) processes, linked through
+   pm_next/pm_prev in registration order. */
+static process_t *pm_head = NULL;
+static process_t *pm_tail = NULL;
 static int proc_cnt = 0;
 static process_t *current = NULL;
 
+static kmem_cache_t proc_cache = KMEM_CACHE_INIT("process", sizeof(process_t), 16);
+
+/* PID allocator: bit i of pid_map set = PID_BASE + i in use. Allocation
+   continues cyclically after the last PID handed out, so a PID that was
+   just released is not reused right away (a slow sys_wait caller would
+   otherwise find an unrelated process). The map doubles when full. */
+#define PID_MAP_MIN_WORDS 16
+#define PID_LIMIT (1U << 22)            /* PIDs PID_BASE .. PID_BASE+PID_LIMIT-1 */
+static uint64_t *pid_map = NULL;
+static uint32_t pid_map_words = 0;
+static uint32_t pid_last = (uint32_t)-1;
+
+static int pid_map_grow(void) {
+    uint32_t words = pid_map_words ? pid_map_words * 2 : PID_MAP_MIN_WORDS;
+    if (words > PID_LIMIT / 64) return -1;
+    uint64_t *map = (uint64_t *)kmalloc(words * sizeof(uint64_t));
+    if (!map) return -1;
+    memset(map, 0, words * sizeof(uint64_t));
+    if (pid_map) memcpy(map, pid_map, pid_map_words * sizeof(uint64_t));
+    /* the old map is not returned: kmalloc cannot free yet */
+    pid_map = map;
+    pid_map_words = words;
+    return 0;
+}
+
+static uint64_t pid_alloc(void) {
+    for (;;) {
+        uint32_t bits = pid_map_words * 64;
+        if (bits) {
+            uint32_t start = (pid_last + 1) % bits;
+            for (uint32_t n = 0; n <= pid_map_words; n++) {
+                uint32_t w = (start / 64 + n) % pid_map_words;
+                uint64_t avail = ~pid_map[w];
+                if (n == 0) avail &= ~0ULL << (start % 64);
+                if (avail) {
+                    uint32_t bit = w * 64 + (uint32_t)__builtin_ctzll(avail);
+                    pid_map[w] |= 1ULL << (bit % 64);
+                    pid_last = bit;
+                    return PID_BASE + bit;
+                }
+            }
+        }
+        if (pid_map_grow() < 0) return 0;
+    }
+}
+
+static void pid_free(uint64_t pid) {
+    uint64_t bit = pid - PID_BASE;
+    if (pid < PID_BASE || bit >= (uint64_t)pid_map_words * 64) return;
+    pid_map[bit / 64] &= ~(1ULL << (bit % 64));
+}
+
+/* PID -> process index: a two-level radix table over the PID bit number.
+   Leaves (1024 slots) are allocated on first use and kept. Lookups are
+   lockless; entries are published and cleared with single pointer stores,
+   and unregistered PCBs are only freed after an RCU grace period, so a
+   reader inside rcu_read_lock() never sees freed memory. */
+#define PID_LEAF_BITS 10
+#define PID_LEAF_SIZE (1U << PID_LEAF_BITS)
+static process_t **pid_dir[PID_LIMIT / PID_LEAF_SIZE];
+static kmem_cache_t pid_leaf_cache =
+    KMEM_CACHE_INIT("pid_leaf", PID_LEAF_SIZE * sizeof(process_t *), 64);
+
+static int pid_index_set(uint64_t pid, process_t *p) {
+    uint64_t bit = pid - PID_BASE;
+    process_t **leaf = pid_dir[bit >> PID_LEAF_BITS];
+    if (!leaf) {
+        if (!p) return 0;
+        leaf = (process_t **)kmem_cache_zalloc(&pid_leaf_cache);
+        if (!leaf) return -1;
+        __atomic_store_n(&pid_dir[bit >> PID_LEAF_BITS], leaf, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&leaf[bit & (PID_LEAF_SIZE - 1)], p, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/* Give p a PID and append it to the registry. The PID map, index and
+   list are also changed by pm_reap from the timer interrupt, hence
+   irq_save here and in pm_unregister_process. */
+static uint64_t pm_link(process_t *p) {
+    uint64_t flags = irq_save();
+    uint64_t pid = pid_alloc();
+    if (pid && pid_index_set(pid, p) < 0) {
+        pid_free(pid);
+        pid = 0;
+    }
+    if (!pid) {
+        irq_restore(flags);
+        return 0;
+    }
+    p->pid = pid;
+    p->pm_next = NULL;
+    p->pm_prev = pm_tail;
+    if (pm_tail) pm_tail->pm_next = p; else pm_head = p;
+    pm_tail = p;
+    proc_cnt++;
+    irq_restore(flags);
+    return pid;
+}
+
+process_t *pm_alloc_process(void) {
+    process_t *p = (process_t *)kmem_cache_zalloc(&proc_cache);
+    if (p) p->flags = PF_SLAB;
+    return p;
+}
+
+void pm_free_process(process_t *p) {
+    if (p && (p->flags & PF_SLAB)) kmem_cache_free(&proc_cache, p);
+}
+
 uint64_t pm_register_process(process_t *proc) {
     if (!proc) return 0;
-    if (proc_cnt >= PM_MAX_PROCS) return 0;
-    pm_proc_table[proc_cnt] = proc;
-    proc->pid = (uint64_t)(1000 + proc_cnt);
+    if (!pm_link(proc)) return 0;
     /* Assign default page table (kernel PML4) */
     extern void *pt_get_kernel_pml4(void);
     proc->page_table = pt_get_kernel_pml4();
-    proc_cnt++;
     /* Initialize FDs to -1 to indicate unused */
     for (int i = 0; i < 16; ++i) proc->fds[i] = -1;
     if (!current) current = proc;
-    serial_puts("[pm] registered process pid=");
-    serial_put_hex(proc->pid);
-    serial_putc('\n');
+    klog_info("[pm] registered process pid=%lu", proc->pid);
     return proc->pid;
 }
 
 process_t *pm_clone_process(process_t *parent) {
     if (!parent) return NULL;
-    if (proc_cnt >= PM_MAX_PROCS) return NULL;
-    /* allocate via kmalloc (legacy stub) */
-    extern void *kmalloc(unsigned int);
-    process_t *child = (process_t *)kmalloc(sizeof(process_t));
+    process_t *child = pm_alloc_process();
     if (!child) return NULL;
     memcpy(child, parent, sizeof(process_t));
-    /* assign new pid and set state to new */
-    child->pid = (uint64_t)(1000 + proc_cnt);
-    /* Clone page table for child so it has its own PML4 (shallow/complete copy for Phase1) */
-    /* Clone page tables using COW-aware helper in kernel; host test uses pt_clone_current */
+    /* Per-process bookkeeping is not inherited */
+    child->flags = PF_SLAB;
+    child->on_rq = 0;
+    child->run_next = child->run_prev = NULL;
+    child->cpu_tsc = 0;
+    child->mm = NULL;         /* fork: new address space, new thread group */
+    child->tgid = 0;
+    memset(&child->dl, 0, sizeof(child->dl));   /* children start in the fair class */
+    child->gang = 0;                            /* and outside any gang */
+    child->uring = NULL;                        /* rings are not inherited */
+    if (!pm_link(child)) {
+        pm_free_process(child);
+        return NULL;
+    }
+    /* Clone page tables using COW-aware helper in kernel; host test uses pt_clone_current.
+       Without its own tables the child would write into the parent's
+       pages, so a failed clone fails the fork. */
 #ifdef HOST_TEST
     extern void *pt_clone_current(void);
     void *new_pml4 = pt_clone_current();
@@ -44,7 +170,23 @@ process_t *pm_clone_process(process_t *parent) {
     extern void *pt_clone_for_cow(void *parent_pml4);
     void *new_pml4 = pt_clone_for_cow(parent->page_table);
 #endif
-    if (new_pml4) child->page_table = new_pml4; else child->page_table = parent->page_table;
+    if (!new_pml4) {
+        pm_unregister_process(child);
+        pm_free_process(child);
+        return NULL;
+    }
+    child->page_table = new_pml4;
+#ifndef HOST_TEST
+    child->flags |= PF_IMAGE;     /* its user frames are its own references */
+#endif
+
+    /* Child gets its own copy of the parent's FPU/SSE/AVX state */
+#ifndef HOST_TEST
+    extern void fpu_fork(process_t *child, process_t *parent);
+    fpu_fork(child, parent);
+#else
+    child->fpu_state = NULL;
+#endif
 
     /* Share heap region (copy-on-write semantics) if present */
     if (parent->heap_start && parent->heap_end && parent->heap_end > parent->heap_start) {
@@ -54,13 +196,19 @@ process_t *pm_clone_process(process_t *parent) {
 
     /* Clone stack memory if parent has a stack_base/size (we give child its own stack) */
     if (parent->stack_base && parent->stack_size) {
+        void *new_stack;
+        extern void *sched_alloc_kstack(void);
+        if (parent->flags & PF_KSTACK) {
+            new_stack = sched_alloc_kstack();
+            if (new_stack) child->flags |= PF_KSTACK;
+        } else {
 #ifdef HOST_TEST
-        extern void *kmalloc(unsigned int);
-        void *new_stack = kmalloc((unsigned int)parent->stack_size);
+            new_stack = kmalloc((unsigned int)parent->stack_size);
 #else
-        extern void *virtual_memory_alloc(uint64_t, uint64_t, int);
-        void *new_stack = virtual_memory_alloc(0, parent->stack_size, 0);
+            extern void *virtual_memory_alloc(uint64_t, uint64_t, int);
+            new_stack = virtual_memory_alloc(0, parent->stack_size, 0);
 #endif
+        }
         if (new_stack) {
             /* copy whole stack region */
             memcpy(new_stack, (void *)parent->stack_base, parent->stack_size);
@@ -69,6 +217,10 @@ process_t *pm_clone_process(process_t *parent) {
             child->stack_base = (uint64_t)new_stack;
             child->stack_size = parent->stack_size;
             child->stack_top = child->stack_base + offset;
+            /* A ring-3 parent's stack is its kernel entry stack: the child
+               enters the kernel on its own copy */
+            if (parent->kstack_top)
+                child->kstack_top = child->stack_base + (parent->kstack_top - parent->stack_base);
 
                 /* Ensure child will return 0 from fork by clearing saved RAX slot.
                Saved regs layout used by our ISR places r15..rax in the first
@@ -89,13 +241,11 @@ process_t *pm_clone_process(process_t *parent) {
     }
     
     child->state = 0; /* new */
-    pm_proc_table[proc_cnt++] = child;
     /* Add new process to scheduler if available */
     extern int sched_add_existing_process(process_t *p);
     (void)sched_add_existing_process(child);
-    serial_puts("[pm] cloned process pid=");
-    serial_put_hex(child->pid);
-    serial_putc('\n');
+    trace_sched(TRACE_FORK, parent->pid, child->pid);
+    klog_info("[pm] cloned process pid=%lu", child->pid);
     return child;
 }
 
@@ -104,8 +254,72 @@ void pm_set_current(process_t *p) { current = p; }
 int pm_count(void) { return proc_cnt; }
 
 process_t *pm_find_by_pid(uint64_t pid) {
-    for (int i = 0; i < proc_cnt; ++i) {
-        if (pm_proc_table[i] && pm_proc_table[i]->pid == pid) return pm_proc_table[i];
+    uint64_t bit = pid - PID_BASE;
+    if (pid < PID_BASE || bit >= PID_LIMIT) return NULL;
+    process_t **leaf = __atomic_load_n(&pid_dir[bit >> PID_LEAF_BITS], __ATOMIC_ACQUIRE);
+    if (!leaf) return NULL;
+    return __atomic_load_n(&leaf[bit & (PID_LEAF_SIZE - 1)], __ATOMIC_ACQUIRE);
+}
+
+void pm_unregister_process(process_t *p) {
+    if (!p) return;
+    uint64_t flags = irq_save();
+    if (!p->pid) {
+        irq_restore(flags);
+        return;
+    }
+    if (p->pm_prev) p->pm_prev->pm_next = p->pm_next; else pm_head = p->pm_next;
+    if (p->pm_next) p->pm_next->pm_prev = p->pm_prev; else pm_tail = p->pm_prev;
+    p->pm_next = p->pm_prev = NULL;
+    pid_index_set(p->pid, NULL);
+    pid_free(p->pid);
+    p->pid = 0;
+    proc_cnt--;
+    if (current == p) current = NULL;
+    irq_restore(flags);
+}
+
+static void pm_free_rcu(rcu_head_t *head) {
+    pm_free_process((process_t *)((uint8_t *)head - offsetof(process_t, rcu)));
+}
+
+/* Release everything a dead process still holds: its run-list slot and
+   kernel stack, FPU area, PID and registry entry, and the PCB itself.
+   Called by sys_wait for a collected child and by the scheduler for tasks
+   nobody waits for. */
+void pm_exit(process_t *p, int code) {
+    extern void fs_decref(int fd);
+    for (int i = 0; i < 16; ++i) {
+        if (p->fds[i] >= 0) fs_decref(p->fds[i]);
+        p->fds[i] = -1;
+    }
+#ifndef HOST_TEST
+    extern void uring_release(process_t *p);
+    extern void fpu_release(process_t *p);
+    uring_release(p);
+    fpu_release(p);
+#endif
+    p->exit_code = code;
+    p->state = 3; /* dead */
+}
+
+void pm_reap(process_t *p) {
+    if (!p) return;
+    extern void sched_remove(process_t *p);
+    sched_remove(p);
+#ifndef HOST_TEST
+    extern void fpu_release(process_t *p);
+    fpu_release(p);
+    /* a thread group's address space goes with its mm (mm_put) */
+    extern void elf_free_process(process_t *p);
+    elf_free_process(p);
+#endif
+    if (p->mm) {
+        extern void mm_put(struct mm *mm);
+        mm_put(p->mm);
+        p->mm = NULL;
     }
-    return NULL;
+    pm_unregister_process(p);
+    /* lockless pm_find_by_pid readers may still hold the pointer */
+    call_rcu(&p->rcu, pm_free_rcu);
 }
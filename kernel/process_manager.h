@@ -6,11 +6,28 @@
 
 #include "elf_loader.h"
 
-#define PM_MAX_PROCS 32
+/* PIDs are handed out from PID_BASE upwards and recycled */
+#define PID_BASE 1000
 
-/* Register a process (takes ownership of proc pointer) and returns pid */
+/* Allocate a zeroed PCB from the process cache (flags = PF_SLAB) */
+process_t *pm_alloc_process(void);
+void pm_free_process(process_t *p);
+
+/* Register a process (takes ownership of proc pointer) and returns pid,
+   or 0 if no PID could be allocated */
 uint64_t pm_register_process(process_t *proc);
 
+/* Drop a process from the registry and release its PID */
+void pm_unregister_process(process_t *p);
+
+/* Tear down a dead process completely (registry, PID, scheduler slot,
+   kernel stack, FPU area, PCB) */
+void pm_reap(process_t *p);
+
+/* Make p dead with exit code `code`: close its descriptors, drop its
+   rings and FPU area. The PCB stays for sys_wait (or pm_reap). */
+void pm_exit(process_t *p, int code);
+
 /* Clone current process and return new process pointer (or NULL) */
 process_t *pm_clone_process(process_t *parent);
 
@@ -18,7 +35,9 @@ process_t *pm_clone_process(process_t *parent);
 process_t *pm_get_current(void);
 void pm_set_current(process_t *p);
 int pm_count(void);
-/* Return pointer to process by pid, or NULL */
+/* Return pointer to process by pid, or NULL. O(1) and lockless: callers
+   that may race with the process being reaped must hold rcu_read_lock()
+   while they use the result. */
 process_t *pm_find_by_pid(uint64_t pid);
 
 #endif
@@ -0,0 +1,64 @@
+/* kernel/rcu.c - epoch-based deferred reclamation (see rcu.h) */
+#include "rcu.h"
+#include "arch/x86/cpu.h"
+#include <stddef.h>
+
+static int rcu_epoch = 0;               /* counter new readers register in */
+static int64_t rcu_readers[2];          /* readers active per epoch */
+static rcu_head_t *rcu_pending = NULL;  /* queued, grace period not started */
+static rcu_head_t *rcu_waiting = NULL;  /* waiting for the old epoch to drain */
+static int rcu_gp_active = 0;
+
+int rcu_read_lock(void) {
+    for (;;) {
+        int idx = __atomic_load_n(&rcu_epoch, __ATOMIC_SEQ_CST);
+        __atomic_fetch_add(&rcu_readers[idx], 1, __ATOMIC_SEQ_CST);
+        /* If a writer flipped the epoch in between it may already have
+           seen this counter at zero: move to the new epoch. */
+        if (__atomic_load_n(&rcu_epoch, __ATOMIC_SEQ_CST) == idx) return idx;
+        __atomic_fetch_sub(&rcu_readers[idx], 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+void rcu_read_unlock(int idx) {
+    __atomic_fetch_sub(&rcu_readers[idx], 1, __ATOMIC_SEQ_CST);
+}
+
+void call_rcu(rcu_head_t *head, void (*func)(rcu_head_t *head)) {
+    uint64_t flags = irq_save();
+    head->func = func;
+    head->next = rcu_pending;
+    rcu_pending = head;
+    irq_restore(flags);
+}
+
+static void rcu_run(rcu_head_t *list) {
+    while (list) {
+        rcu_head_t *next = list->next;
+        list->func(list);
+        list = next;
+    }
+}
+
+void rcu_poll(void) {
+    uint64_t flags = irq_save();
+    rcu_head_t *ready = NULL;
+
+    if (!rcu_gp_active && rcu_pending) {
+        /* Start a grace period: callbacks queued so far wait for every
+           reader registered in the current epoch. */
+        rcu_waiting = rcu_pending;
+        rcu_pending = NULL;
+        __atomic_store_n(&rcu_epoch, rcu_epoch ^ 1, __ATOMIC_SEQ_CST);
+        rcu_gp_active = 1;
+    }
+    if (rcu_gp_active &&
+        __atomic_load_n(&rcu_readers[rcu_epoch ^ 1], __ATOMIC_SEQ_CST) == 0) {
+        ready = rcu_waiting;
+        rcu_waiting = NULL;
+        rcu_gp_active = 0;
+    }
+    irq_restore(flags);
+
+    rcu_run(ready);
+}
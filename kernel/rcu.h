@@ -0,0 +1,33 @@
+/* kernel/rcu.h
+ * Read-copy-update style deferred reclamation. Readers bracket lockless
+ * lookups with rcu_read_lock/rcu_read_unlock; writers unpublish an object
+ * and hand it to call_rcu, which runs the callback only after every reader
+ * that could still see it has left its read-side section.
+ *
+ * Grace periods are tracked with two reader counters selected by an epoch
+ * bit (as in SRCU), so readers may be preempted or run on other CPUs.
+ * Pending callbacks are processed by rcu_poll, called on every context
+ * switch.
+ */
+
+#ifndef RCU_H
+#define RCU_H
+
+#include <stdint.h>
+
+typedef struct rcu_head {
+    struct rcu_head *next;
+    void (*func)(struct rcu_head *head);
+} rcu_head_t;
+
+/* Enter/leave a read-side section. Pass the returned index to unlock. */
+int rcu_read_lock(void);
+void rcu_read_unlock(int idx);
+
+/* Run func(head) once all current readers are done */
+void call_rcu(rcu_head_t *head, void (*func)(rcu_head_t *head));
+
+/* Advance grace periods and run ready callbacks (never blocks) */
+void rcu_poll(void);
+
+#endif /* RCU_H */
@@ -0,0 +1,132 @@
+/* kernel/scheduler/deadline.c - deadline (EDF) class: parameters,
+ * admission control, budget accounting and job releases. The pick itself
+ * (earliest deadline among runnable deadline tasks) and the budget timer
+ * live in preemptive.c next to the fair class.
+ */
+#include "deadline.h"
+#include "preemptive.h"
+#include "../drivers/serial.h"
+#include "../drivers/timer.h"
+
+static uint64_t dl_total_bw = 0;
+
+uint64_t sched_dl_bandwidth(void) { return dl_total_bw; }
+
+/* Start a new job at release time t with a full budget */
+static void dl_new_job(process_t *p, uint64_t t) {
+    p->dl.release = t;
+    p->dl.abs_deadline = t + p->dl.deadline;
+    p->dl.remaining = (int64_t)p->dl.runtime;
+    p->dl.missed = 0;
+}
+
+/* Release / replenishment timer (interrupt context) */
+static void dl_timer_fire(void *arg) {
+    process_t *p = (process_t *)arg;
+    uint64_t t = p->dl.release + p->dl.period;
+
+    if (p->dl.waiting) {
+        p->dl.waiting = 0;
+        dl_new_job(p, t);
+    } else if (p->dl.throttled) {
+        /* Same job continues in the next period. deadline <= period, so
+           it is still unfinished at its deadline: a miss */
+        if (!p->dl.missed) {
+            p->dl.misses++;
+            p->dl.missed = 1;
+        }
+        p->dl.release = t;
+        p->dl.abs_deadline = t + p->dl.deadline;
+        p->dl.remaining = (int64_t)p->dl.runtime;
+    }
+    p->dl.throttled = 0;
+    sched_wake(p);
+}
+
+int sched_dl_setattr(process_t *p, uint64_t runtime_ns, uint64_t deadline_ns,
+                     uint64_t period_ns, uint64_t now) {
+    if (!p) return -1;
+    if (runtime_ns == 0) {
+        sched_dl_clear(p);
+        return 0;
+    }
+    if (!deadline_ns) deadline_ns = period_ns;
+    if (runtime_ns > deadline_ns || deadline_ns > period_ns) return -1;
+
+    uint64_t bw = (runtime_ns << DL_BW_SHIFT) / period_ns;
+    if (dl_total_bw - p->dl.bw + bw > DL_BW_LIMIT) {
+        serial_puts("[dl] admission refused for pid=");
+        serial_put_hex(p->pid);
+        serial_putc('\n');
+        return -1;
+    }
+    dl_total_bw = dl_total_bw - p->dl.bw + bw;
+
+    timer_cancel(&p->dl.timer);
+    p->dl.runtime = timer_ns_to_tsc(runtime_ns);
+    p->dl.deadline = timer_ns_to_tsc(deadline_ns);
+    p->dl.period = timer_ns_to_tsc(period_ns);
+    p->dl.bw = bw;
+    p->dl.throttled = p->dl.waiting = 0;
+    dl_new_job(p, now);
+    return 0;
+}
+
+void sched_dl_clear(process_t *p) {
+    if (!p || !p->dl.runtime) return;
+    timer_cancel(&p->dl.timer);
+    dl_total_bw -= p->dl.bw;
+    p->dl.bw = 0;
+    p->dl.runtime = 0;
+    /* a throttled/waiting task goes back to the fair class runnable */
+    if (p->dl.throttled || p->dl.waiting) {
+        p->dl.throttled = p->dl.waiting = 0;
+        sched_wake(p);
+    }
+}
+
+void sched_dl_charge(process_t *p, uint64_t ran, uint64_t now) {
+    if (!p->dl.runtime || p->dl.waiting) return;
+    p->dl.remaining -= (int64_t)ran;
+    if (p->dl.remaining > 0 || p->state == 3) return;
+
+    /* Overrun: park it until the next period refills the budget */
+    p->dl.throttled = 1;
+    p->dl.throttles++;
+    p->state = 2;
+    uint64_t next = p->dl.release + p->dl.period;
+    if (timer_add(&p->dl.timer, next > now ? next : now, dl_timer_fire, p) != 0)
+        dl_timer_fire(p);
+}
+
+void sched_dl_job_done(process_t *p, uint64_t now) {
+    if (!p->dl.runtime) return;
+    p->dl.jobs++;
+    if (!p->dl.missed && now > p->dl.abs_deadline) p->dl.misses++;
+
+    uint64_t next = p->dl.release + p->dl.period;
+    if (next <= now) {
+        /* already late for the next release: start it right away */
+        dl_new_job(p, next);
+        return;
+    }
+    p->dl.waiting = 1;
+    p->state = 2;
+    if (timer_add(&p->dl.timer, next, dl_timer_fire, p) != 0) {
+        p->dl.waiting = 0;
+        p->state = 1;
+        dl_new_job(p, next);   /* no timer slot: run the next job early */
+    }
+}
+
+void sched_dl_report(process_t *p) {
+    serial_puts("[dl] pid=");
+    serial_put_dec(p->pid);
+    serial_puts(" jobs=");
+    serial_put_dec(p->dl.jobs);
+    serial_puts(" misses=");
+    serial_put_dec(p->dl.misses);
+    serial_puts(" throttles=");
+    serial_put_dec(p->dl.throttles);
+    serial_putc('\n');
+}
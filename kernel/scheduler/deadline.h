@@ -0,0 +1,65 @@
+/* kernel/scheduler/deadline.h
+ * Deadline (EDF) scheduling class for periodic work. A task with a
+ * non-zero runtime gets up to `runtime` of CPU time in every `period`,
+ * each job due `deadline` after its release. Deadline tasks always run
+ * before fair (round-robin) tasks, earliest absolute deadline first, and
+ * are throttled when they exhaust their budget so an overrunning task
+ * cannot steal time guaranteed to the others.
+ */
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <stdint.h>
+#include "../drivers/timer.h"
+
+struct process;
+
+/* Bandwidth is runtime/period in 1/2^20 units; admission keeps the sum
+   of all deadline tasks under 95% of the CPU so fair tasks never starve */
+#define DL_BW_SHIFT 20
+#define DL_BW_LIMIT ((95ULL << DL_BW_SHIFT) / 100)
+
+/* Per-task deadline state (process_t.dl). Times are TSC cycles. */
+typedef struct sched_dl {
+    uint64_t runtime;          /* budget per period, 0 = fair class */
+    uint64_t deadline;         /* relative deadline */
+    uint64_t period;
+    uint64_t bw;               /* admitted bandwidth */
+    uint64_t release;          /* release time of the current job */
+    uint64_t abs_deadline;     /* absolute deadline of the current job */
+    int64_t  remaining;        /* budget left in the current period */
+    int      throttled;        /* budget exhausted, waiting for replenishment */
+    int      waiting;          /* job done, sleeping until the next release */
+    int      missed;           /* current job already counted as a miss */
+    uint64_t jobs;             /* completed jobs */
+    uint64_t misses;           /* jobs that finished after their deadline */
+    uint64_t throttles;        /* budget overruns */
+    timer_event_t timer;       /* next release / replenishment */
+} sched_dl_t;
+
+/* Switch p to the deadline class (times in ns) with admission control,
+   or back to the fair class with runtime_ns = 0. Requires
+   0 < runtime <= deadline <= period. Returns 0, or -1 if the parameters
+   are invalid or the bandwidth would exceed DL_BW_LIMIT. */
+int sched_dl_setattr(struct process *p, uint64_t runtime_ns, uint64_t deadline_ns,
+                     uint64_t period_ns, uint64_t now);
+
+/* Leave the deadline class: cancel timers, give back the bandwidth */
+void sched_dl_clear(struct process *p);
+
+/* Charge ran cycles of CPU time to p; throttles it (state = sleeping)
+   when its budget runs out before the job completes */
+void sched_dl_charge(struct process *p, uint64_t ran, uint64_t now);
+
+/* p finished its current job at now: account a miss if it is late and
+   sleep until the next release (stays runnable if that is already due) */
+void sched_dl_job_done(struct process *p, uint64_t now);
+
+/* Total admitted bandwidth (1/2^20 units) */
+uint64_t sched_dl_bandwidth(void);
+
+/* Log p's job/miss/throttle counters */
+void sched_dl_report(struct process *p);
+
+#endif /* DEADLINE_H */
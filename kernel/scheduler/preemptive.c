@@ -3,23 +3,103 @@
 #include "../process_manager.h"
 #include "../mm/pagetable.h"
 #include "../drivers/serial.h"
+#include "../arch/x86/cpu.h"
+#include "../arch/x86/fpu.h"
+#include "../mm/slab.h"
+#include "../mm/mm.h"
+#include "deadline.h"
+#include "../trace.h"
+#include "../klog.h"
+#include "../rcu.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
-#define MAX_TASKS 16
 #define KERNEL_STACK_SIZE (16*1024)
 
-static process_t *tasks[MAX_TASKS];
+/* GDT selectors (arch/x86/gdt.c) */
+#define KERNEL_CS 0x08
+#define KERNEL_SS 0x10
+#define USER_CS   0x23
+#define USER_SS   0x1B
+
+#define MSR_FS_BASE 0xC0000100
+#define MSR_GS_BASE 0xC0000101
+
+/* CPU affinity. Only the boot CPU is started (no AP bring-up yet), so
+   CPU 0 is the only online CPU and tasks whose mask excludes it stay
+   parked on the run list until a CPU they allow comes online. Isolated
+   CPUs are left out of the default mask: only tasks that ask for them
+   explicitly run there. */
+static uint64_t cpus_online = 1;
+static uint64_t cpus_isolated = 0;
+
+/* Run list: every scheduled task that has not died yet, linked circularly
+   through run_next/run_prev. Sleeping tasks stay on it and are skipped. */
+static process_t *run_head = NULL;
 static int task_count = 0;
-static int sched_current = -1; /* index of current task */
+static process_t *cur_task = NULL;     /* running task, NULL = idle (boot) context */
+static process_t *reap_pending = NULL; /* dead task whose stack we were still on */
+static kmem_cache_t kstack_cache = KMEM_CACHE_INIT("kstack", KERNEL_STACK_SIZE, 16);
+static uint64_t idle_rsp = 0;  /* saved context of the boot stack idle loop */
+static volatile int need_resched = 0; /* a task became runnable: switch at next IRQ */
+static uint64_t last_switch_tsc = 0;  /* start of the current context's run */
+static uint64_t loaded_cr3 = 0;       /* address space currently in CR3 */
+static uint64_t cr3_loads = 0;
+static uint64_t loaded_fs = 0, loaded_gs = 0;  /* TLS bases in the MSRs */
+static uint64_t idle_tsc = 0;         /* time spent in the idle context */
+static timer_event_t dl_budget_ev = { .heap_idx = -1 };  /* running deadline task's budget */
+
+/* Gangs: groups of cooperating tasks that are only run together. While a
+   gang holds the CPU (its slot, up to slice_tsc long) the fair class picks
+   nothing but its members; when the slot expires or every member is
+   waiting, the others get their turn before the gang is picked again.
+   With a single online CPU the slot is what keeps the members' steps
+   together; once APs run their own queues the same slot is opened on every
+   CPU a member is placed on. */
+typedef struct sched_gang {
+    int members;
+    uint64_t slice_tsc;
+    uint64_t slots;            /* times the gang was given the CPU */
+} sched_gang_t;
+
+static sched_gang_t gangs[SCHED_MAX_GANGS + 1];   /* index 0 unused */
+static int active_gang = 0;
+static uint64_t gang_slot_end = 0;
+static int benched_gang = 0;      /* gang whose slot just ended */
+static int bench_turns = 0;       /* picks left before it may run again */
+
+#ifdef HOST_TEST
+/* Host simulations drive the scheduler from a virtual clock */
+uint64_t (*sched_clock_hook)(void) = NULL;
+static uint64_t sched_clock(void) { return sched_clock_hook ? sched_clock_hook() : rdtsc(); }
+#else
+#define sched_clock() rdtsc()
+#endif
+
+extern void timer_sched_update(int nr_runnable);
+
+/* Landing pad for kernel tasks whose entry function returns: mark the task
+   dead and give the CPU away for good. */
+static void task_exit(void) {
+    process_t *cur = pm_get_current();
+    if (cur) cur->state = 3; /* dead */
+#ifndef HOST_TEST
+    fpu_release(cur);
+#endif
+    for (;;) scheduler_yield();
+}
 
-/* Helper: build initial stack frame for a new kernel task */
-static uint64_t *prepare_initial_frame(void *stack_top, uint64_t entry_point) {
+/* Helper: build initial stack frame for a new task. Kernel tasks get
+   cs/ss = kernel selectors and rsp = 0 (use the task_exit pad on the same
+   stack); user tasks get the ring-3 selectors and their user stack. */
+static uint64_t *prepare_initial_frame(void *stack_top, uint64_t entry_point,
+                                       uint64_t cs, uint64_t ss, uint64_t rsp) {
     /* We will create a stack with saved registers (15 qwords) followed
-       by the interrupt frame (RIP, CS, RFLAGS). The ISR expects the
-       saved registers to be present so pop restores them and then iretq
-       uses the interrupt frame to set RIP and continue.
+       by the interrupt frame (RIP, CS, RFLAGS, RSP, SS). In long mode the
+       CPU always pushes SS:RSP, so iretq pops all five words. The ISR
+       expects the saved registers to be present so pop restores them and
+       then iretq uses the interrupt frame to set RIP and continue.
     */
     const int REG_COUNT = 15; /* r15..rbp..rax order used by ISR */
     uint64_t *sp = (uint64_t *)stack_top;
@@ -27,107 +107,675 @@ static uint64_t *prepare_initial_frame(void *stack_top, uint64_t entry_point) {
     /* Align down */
     sp = (uint64_t *)((uintptr_t)sp & ~0xFULL);
 
+    /* Return address for the task entry: when entry returns it lands in
+       task_exit. Keep it at an address ending in 8 (as after a call). */
+    if (!rsp) {
+        sp -= 2;
+        sp[0] = (uint64_t)task_exit;
+        sp[1] = 0;
+        rsp = (uint64_t)sp;
+    }
+
     /* Reserve space for regs + irq frame */
-    sp -= (REG_COUNT + 3);
+    sp -= (REG_COUNT + 5);
 
     /* we'll fill regs in order the ISR expects to pop: r15..r14.. ..rax */
     for (int i = 0; i < REG_COUNT; i++) sp[i] = 0; /* zero regs */
 
-    /* Interrupt frame: RIP, CS, RFLAGS */
+    /* Interrupt frame: RIP, CS, RFLAGS, RSP, SS */
     sp[REG_COUNT + 0] = entry_point; /* RIP */
-    sp[REG_COUNT + 1] = 0x08;        /* CS (kernel code) */
+    sp[REG_COUNT + 1] = cs;          /* CS */
     sp[REG_COUNT + 2] = 0x202;       /* RFLAGS (IF = 1) */
+    sp[REG_COUNT + 3] = rsp;         /* RSP */
+    sp[REG_COUNT + 4] = ss;          /* SS */
 
     /* Return pointer to location of r15 (top of saved regs) */
     return sp;
 }
 
-int task_create(void (*entry)(void)) {
-    if (task_count >= MAX_TASKS) return -1;
+static int sched_select_cpu(process_t *p);
+static int sched_nr_runnable(void);
 
-    extern void *virtual_memory_alloc(uint64_t, uint64_t, int);
-    extern uint64_t pm_register_process(process_t *p);
-    extern void *kmalloc(unsigned int size);
+/* The run list is also changed from the timer interrupt (scheduler_switch
+   dropping and reaping dead tasks), so both ends hold interrupts off */
+static void rq_add(process_t *p) {
+    uint64_t flags = irq_save();
+    if (p->on_rq) {
+        irq_restore(flags);
+        return;
+    }
+    if (!p->cpus_allowed) p->cpus_allowed = sched_default_mask();
+    p->cpu = sched_select_cpu(p);
+    if (!run_head) {
+        p->run_next = p->run_prev = p;
+        run_head = p;
+    } else {
+        /* append at the tail (just before the head) */
+        p->run_next = run_head;
+        p->run_prev = run_head->run_prev;
+        run_head->run_prev->run_next = p;
+        run_head->run_prev = p;
+    }
+    p->on_rq = 1;
+    task_count++;
+    irq_restore(flags);
+}
 
-    process_t *proc = (process_t *)kmalloc(sizeof(process_t));
-    if (!proc) return -1;
-    memset(proc, 0, sizeof(process_t));
-    proc->entry_point = (uint64_t)entry;
+static void rq_del(process_t *p) {
+    uint64_t flags = irq_save();
+    if (!p->on_rq) {
+        irq_restore(flags);
+        return;
+    }
+    if (p->run_next == p) {
+        run_head = NULL;
+    } else {
+        p->run_prev->run_next = p->run_next;
+        p->run_next->run_prev = p->run_prev;
+        if (run_head == p) run_head = p->run_next;
+    }
+    p->run_next = p->run_prev = NULL;
+    p->on_rq = 0;
+    task_count--;
+    irq_restore(flags);
+}
+
+/* Kernel stacks are recycled through their own cache */
+void *sched_alloc_kstack(void) {
+    return kmem_cache_alloc(&kstack_cache);
+}
 
-    /* allocate kernel stack */
-    void *stk = virtual_memory_alloc(0, KERNEL_STACK_SIZE, 0);
+/* Take p off the run list and give back its kernel stack (it must not be
+   running on it). Part of pm_reap. */
+void sched_remove(process_t *p) {
+    uint64_t flags = irq_save();
+    rq_del(p);
+    if (p->dl.runtime) {
+        sched_dl_report(p);
+        sched_dl_clear(p);
+    }
+    if (p->gang) sched_gang_join(p, 0);
+    if (p->flags & PF_KSTACK) {
+        kmem_cache_free(&kstack_cache, (void *)p->stack_base);
+        p->flags &= ~PF_KSTACK;
+        p->stack_base = p->stack_top = p->kstack_top = 0;
+    }
+    irq_restore(flags);
+}
+
+/* Allocate PCB + kernel stack, build the first frame and queue the task.
+   Tasks created here have no parent to wait for them: they are reaped as
+   soon as they die. */
+/* Give proc a kernel stack holding an initial frame that enters entry */
+static int task_init_stack(process_t *proc, uint64_t entry, uint64_t cs, uint64_t ss, uint64_t rsp) {
+    void *stk = sched_alloc_kstack();
     if (!stk) return -1;
     uint64_t stktop = (uint64_t)stk + KERNEL_STACK_SIZE;
 
-    uint64_t *frame = prepare_initial_frame((void*)stktop, (uint64_t)entry);
+    uint64_t *frame = prepare_initial_frame((void*)stktop, entry, cs, ss, rsp);
+    proc->entry_point = entry;
     proc->stack_top = (uint64_t)frame; /* initial RSP for context */
     proc->stack_base = (uint64_t)stk;
     proc->stack_size = KERNEL_STACK_SIZE;
+    proc->flags |= PF_KSTACK;
     proc->state = 0;
+    return 0;
+}
+
+/* Runs with interrupts on (task_create from kernel tasks): the tick may
+   reap and free tasks meanwhile, so the PCB, stack and PID are taken in
+   one interrupts-off section */
+static process_t *task_alloc(uint64_t entry, uint64_t cs, uint64_t ss, uint64_t rsp) {
+    uint64_t flags = irq_save();
+    process_t *proc = pm_alloc_process();
+    if (!proc) goto out;
+
+    if (task_init_stack(proc, entry, cs, ss, rsp) < 0) {
+        pm_free_process(proc);
+        proc = NULL;
+        goto out;
+    }
+    proc->flags |= PF_AUTOREAP;
+
+    if (!pm_register_process(proc)) {
+        sched_remove(proc);
+        pm_free_process(proc);
+        proc = NULL;
+    }
+out:
+    irq_restore(flags);
+    return proc;
+}
+
+int task_create(void (*entry)(void)) {
+    process_t *proc = task_alloc((uint64_t)entry, KERNEL_CS, KERNEL_SS, 0);
+    if (!proc) return -1;
+    rq_add(proc);
+    return 0;
+}
 
-    pm_register_process(proc);
+/* Create a ring-3 task: the saved context lives on a private kernel stack
+   (which also becomes TSS.RSP0 while it runs) and iretq drops to entry with
+   the user selectors and user_sp. page_table may be NULL for the kernel
+   PML4. Returns 0 or -1. */
+int task_create_user(uint64_t entry, uint64_t user_sp, void *page_table) {
+    process_t *proc = task_alloc(entry, USER_CS, USER_SS, user_sp & ~0xFULL);
+    if (!proc) return -1;
+    proc->kstack_top = proc->stack_base + KERNEL_STACK_SIZE;
+    if (page_table) proc->page_table = (uint64_t *)page_table;
+    rq_add(proc);
+    return 0;
+}
 
-    tasks[task_count++] = proc;
+/* Start an already registered process (one built by elf_load) in ring 3
+   at its entry point on user_sp. Its PCB, PID and page table are kept; the
+   task is waitable (no PF_AUTOREAP). Returns 0 or -1. */
+int task_start_user(process_t *proc, uint64_t user_sp) {
+    if (!proc || proc->on_rq) return -1;
+    if (task_init_stack(proc, proc->entry_point, USER_CS, USER_SS, user_sp & ~0xFULL) < 0)
+        return -1;
+    proc->kstack_top = proc->stack_base + KERNEL_STACK_SIZE;
+    rq_add(proc);
     return 0;
 }
 
-/* Test helper: add an existing process_t into the scheduler's task list
- * Returns index or -1 on failure.
+/* Create a thread of parent: it shares parent's mm, so no page table is
+   copied or even read, and gets its own kernel stack and TLS base. For a
+   user parent it enters ring 3 at entry on stack_top; a kernel thread runs
+   on its kernel stack (stack_top ignored). tls = 0 inherits the parent's
+   FS base. Threads are joined with sys_wait. */
+process_t *thread_create(process_t *parent, uint64_t entry, uint64_t stack_top, uint64_t tls) {
+    if (!parent) return NULL;
+    int user = parent->kstack_top != 0;
+    if (user && !stack_top) return NULL;
+    if (!parent->mm) {
+        if (!(parent->mm = mm_create(parent->page_table))) return NULL;
+        /* from now on the address space outlives the parent if a thread
+           does: the mm owns it */
+        if (parent->flags & PF_IMAGE) {
+            parent->mm->image = 1;
+            parent->flags &= ~PF_IMAGE;
+        }
+    }
+
+    process_t *t = user ? task_alloc(entry, USER_CS, USER_SS, stack_top & ~0xFULL)
+                        : task_alloc(entry, KERNEL_CS, KERNEL_SS, 0);
+    if (!t) return NULL;
+    t->flags &= ~PF_AUTOREAP;
+    t->mm = mm_get(parent->mm);
+    t->page_table = parent->page_table;
+    t->tgid = parent->tgid ? parent->tgid : parent->pid;
+    t->heap_start = parent->heap_start;
+    t->heap_end = parent->heap_end;
+    t->fs_base = tls ? tls : parent->fs_base;
+    t->gs_base = parent->gs_base;
+    t->cpus_allowed = parent->cpus_allowed;
+    if (user) t->kstack_top = t->stack_base + KERNEL_STACK_SIZE;
+
+    /* Descriptors are per-PCB here: give the thread references to the
+       same open files */
+    extern void fs_incref(int fd);
+    for (int i = 0; i < 16; ++i) {
+        t->fds[i] = parent->fds[i];
+        if (t->fds[i] >= 0) fs_incref(t->fds[i]);
+    }
+
+    rq_add(t);
+    trace_sched(TRACE_FORK, parent->pid, t->pid);
+    return t;
+}
+
+/* Add an existing process_t (forked child, test fixture) to the run list.
+ * Returns its position or -1 on failure.
  */
 int sched_add_existing_process(process_t *p) {
-    if (task_count >= MAX_TASKS) return -1;
-    tasks[task_count++] = p;
+    if (!p) return -1;
+    rq_add(p);
     return task_count - 1;
 }
 
 void scheduler_start(void) {
-    /* choose first task and switch to it by changing stack and iret via assembly
-       call. We'll simply pause here and let timer interrupts perform switching.
-    */
+    /* The boot stack becomes the idle context: the first switch saves it
+       in idle_rsp and it only runs again when no task is runnable. */
     extern void enable_interrupts(void);
-    extern void disable_interrupts(void);
 
-    /* select first task if present */
     if (task_count == 0) return;
-    sched_current = 0;
-    /* Switch to the next task's page table (CR3) */
-    if (tasks[sched_current] && tasks[sched_current]->page_table) {
-        pt_set_cr3((void *)tasks[sched_current]->page_table);
-    }
-    pm_set_current(tasks[sched_current]);
-
-    /* Jump directly into the first task by switching stack and performing an iret
-       sequence: write the stack pointer to tasks[current]->stack_top and then
-       return. We'll simulate by just enabling interrupts and returning so the
-       next timer interrupt will schedule tasks properly. In a full kernel we
-       would perform an immediate context switch here.
-    */
+
     enable_interrupts();
 
-    /* Wait forever — scheduler will run via interrupts */
-    for (;;)
+    /* Switch into the first task right away instead of waiting for the
+       next timer tick. */
+    scheduler_yield();
+
+    /* Idle loop — scheduler comes back here when nothing is runnable.
+       Nothing else wants the CPU: format the log now. */
+    for (;;) {
+        klog_flush();
         asm volatile ("hlt");
+    }
+}
+
+static int runnable(process_t *p) {
+    return p->state != 2 && p->state != 3; /* not sleeping, not dead */
+}
+
+int sched_cpu_id(void) {
+    return 0;   /* boot CPU: no per-CPU data until APs are started */
+}
+
+uint64_t sched_cpus_online(void) { return cpus_online; }
+uint64_t sched_cpus_isolated(void) { return cpus_isolated; }
+
+/* Mask given to tasks that did not choose one: every CPU except the
+   isolated ones, or all online CPUs if that would leave none. */
+uint64_t sched_default_mask(void) {
+    uint64_t m = ~cpus_isolated;
+    return (m & cpus_online) ? m : cpus_online;
+}
+
+/* Placement: keep the task on this CPU if allowed, else the lowest allowed
+   online CPU; -1 parks it. This is where a balancer plugs in once there is
+   more than one run queue. */
+static int sched_select_cpu(process_t *p) {
+    uint64_t ok = p->cpus_allowed & cpus_online;
+    if (!ok) return -1;
+    int self = sched_cpu_id();
+    if (ok & (1ULL << self)) return self;
+    return __builtin_ctzll(ok);
+}
+
+/* Runnable here: not sleeping/dead and queued on this CPU */
+static int eligible(process_t *p) {
+    return runnable(p) && p->cpu == sched_cpu_id();
+}
+
+/* Deadline class first: the eligible deadline task with the earliest
+   absolute deadline. Skipped entirely while no deadline task exists. */
+static process_t *sched_pick_dl(void) {
+    if (!sched_dl_bandwidth()) return NULL;
+    process_t *best = NULL, *p = run_head;
+    for (int n = task_count; n > 0 && p; n--, p = p->run_next) {
+        if (p->dl.runtime && eligible(p) &&
+            (!best || p->dl.abs_deadline < best->dl.abs_deadline))
+            best = p;
+    }
+    return best;
+}
+
+/* The running deadline task used up its budget: switch it out */
+static void dl_budget_fire(void *arg) {
+    (void)arg;
+    need_resched = 1;
+}
+
+/* Move p into the deadline class (times in ns; runtime 0 = back to the
+   fair class). Returns 0 or -1 if refused by admission control. */
+int sched_setattr(process_t *p, uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns) {
+    uint64_t flags = irq_save();
+    int ret = sched_dl_setattr(p, runtime_ns, deadline_ns, period_ns, sched_clock());
+    if (ret == 0) need_resched = 1;
+    irq_restore(flags);
+    return ret;
+}
+
+/* sched_yield: a deadline task has finished its current job and sleeps
+   until the next release; anyone else just gives up the CPU. */
+void sched_dl_yield(void) {
+    uint64_t flags = irq_save();
+    if (cur_task && cur_task->dl.runtime)
+        sched_dl_job_done(cur_task, sched_clock());
+    scheduler_yield();
+    irq_restore(flags);
+}
+
+/* Restrict p to the CPUs in mask. If p is running and may no longer run
+   here it is switched out at the next scheduling point. */
+int sched_set_affinity(process_t *p, uint64_t mask) {
+    if (!p || !mask) return -1;
+    uint64_t flags = irq_save();
+    p->cpus_allowed = mask;
+    if (p->on_rq) {
+        int cpu = sched_select_cpu(p);
+        if (cpu != p->cpu) trace_sched(TRACE_MIGRATE, p->pid, (uint16_t)cpu);
+        p->cpu = cpu;
+    }
+    if (p == cur_task && p->cpu != sched_cpu_id()) need_resched = 1;
+    timer_sched_update(sched_nr_runnable());
+    irq_restore(flags);
+    return 0;
+}
+
+/* Boot-time isolation (isolcpus=): affects tasks queued from now on */
+void sched_set_isolated(uint64_t mask) {
+    cpus_isolated = mask;
+    if (!(~mask & cpus_online)) {
+        serial_puts("[sched] isolcpus covers every online CPU: housekeeping stays on them\n");
+    }
+    serial_puts("[sched] isolated cpus mask=0x");
+    serial_put_hex(mask);
+    serial_putc('\n');
+}
+
+/* Parse a CPU list such as "1,3-5" into a mask. Stops at the first
+   character that is not part of the list. */
+uint64_t sched_parse_cpulist(const char *s) {
+    uint64_t mask = 0;
+    while (s && *s >= '0' && *s <= '9') {
+        int lo = 0, hi;
+        while (*s >= '0' && *s <= '9') lo = lo * 10 + (*s++ - '0');
+        hi = lo;
+        if (*s == '-') {
+            s++;
+            hi = 0;
+            while (*s >= '0' && *s <= '9') hi = hi * 10 + (*s++ - '0');
+        }
+        for (int c = lo; c <= hi && c < 64; c++) mask |= 1ULL << c;
+        if (*s != ',') break;
+        s++;
+    }
+    return mask;
+}
+
+/* Runnable task count as seen by the tick logic, which only cares about
+   0, 1 or "more than one": stop counting at 2. */
+static int sched_nr_runnable(void) {
+    int n = 0;
+    process_t *p = run_head;
+    for (int i = 0; i < task_count && n < 2; i++, p = p->run_next)
+        if (eligible(p)) n++;
+    return n;
+}
+
+/* A task that died while not running: drop it from the run list, and
+   release it entirely if nobody is going to wait for it. */
+static void sched_drop_dead(process_t *p) {
+    rq_del(p);
+    if (p->flags & PF_AUTOREAP) pm_reap(p);
+}
+
+/* Pick the next runnable task starting at start (round-robin), dropping
+   dead tasks met on the way. Members of gang `skip` are passed over.
+   Returns NULL if only the idle context can run. */
+static process_t *sched_pick_next(process_t *start, int skip) {
+    process_t *p = start;
+    for (int n = task_count; n > 0 && p; n--) {
+        process_t *next = p->run_next;
+        if (eligible(p) && !(skip && p->gang == skip)) return p;
+        if (p->state == 3) sched_drop_dead(p);
+        p = next;
+    }
+    return NULL;
+}
+
+/* Fair class with gangs: keep running members of the active gang until
+   its slot ends. Then every other runnable task gets one turn before the
+   gang can be picked again; picking a member opens a new slot. */
+static process_t *sched_pick_fair(process_t *start, uint64_t now) {
+    if (active_gang) {
+        process_t *p = start;
+        for (int n = task_count; n > 0 && p && now < gang_slot_end; n--, p = p->run_next)
+            if (p->gang == active_gang && eligible(p)) return p;
+        /* Slot over, or the whole gang is waiting */
+        benched_gang = active_gang;
+        bench_turns = 0;
+        p = run_head;
+        for (int n = task_count; n > 0 && p; n--, p = p->run_next)
+            if (p->gang != benched_gang && eligible(p)) bench_turns++;
+        active_gang = 0;
+    }
+    process_t *next = NULL;
+    if (benched_gang && bench_turns > 0) {
+        bench_turns--;
+        next = sched_pick_next(start, benched_gang);
+    }
+    if (!next) {
+        benched_gang = 0;
+        next = sched_pick_next(start, 0);
+    }
+    if (next && next->gang) {
+        active_gang = next->gang;
+        gang_slot_end = now + gangs[active_gang].slice_tsc;
+        gangs[active_gang].slots++;
+    }
+    return next;
+}
+
+/* New gang whose slot lasts slice_ns. Returns its id or -1. */
+int sched_gang_create(uint64_t slice_ns) {
+    if (!slice_ns) slice_ns = SCHED_GANG_SLICE_NS;
+    uint64_t flags = irq_save();
+    int id = -1;
+    for (int g = 1; g <= SCHED_MAX_GANGS; g++) {
+        if (!gangs[g].slice_tsc) {
+            gangs[g].slice_tsc = timer_ns_to_tsc(slice_ns);
+            gangs[g].members = 0;
+            gangs[g].slots = 0;
+            id = g;
+            break;
+        }
+    }
+    irq_restore(flags);
+    return id;
+}
+
+/* Move p into gang (0 = leave its gang). A gang is released when its last
+   member leaves. Returns 0 or -1 for an unknown gang. */
+int sched_gang_join(process_t *p, int gang) {
+    if (!p || gang < 0 || gang > SCHED_MAX_GANGS) return -1;
+    uint64_t flags = irq_save();
+    if (gang && !gangs[gang].slice_tsc) {
+        irq_restore(flags);
+        return -1;
+    }
+    int old = p->gang;
+    if (old && --gangs[old].members == 0) {
+        gangs[old].slice_tsc = 0;
+        if (active_gang == old) active_gang = 0;
+        if (benched_gang == old) benched_gang = 0;
+    }
+    p->gang = gang;
+    if (gang) gangs[gang].members++;
+    if (p == cur_task) need_resched = 1;
+    irq_restore(flags);
+    return 0;
+}
+
+/* Number of slots gang has been given (benchmarks) */
+uint64_t sched_gang_slots(int gang) {
+    return (gang > 0 && gang <= SCHED_MAX_GANGS) ? gangs[gang].slots : 0;
+}
+
+/* Load next's address space and kernel entry stack. CR3 is only written
+   when the address space actually changes: threads of one process and
+   kernel tasks (which run on the shared kernel mapping and keep whatever
+   CR3 is loaded) avoid the write and the TLB flush it implies. */
+static int switch_mm(process_t *next) {
+    uint64_t cr3 = (uint64_t)next->page_table;
+    if (cr3 && cr3 != loaded_cr3) {
+        /* an unaligned root is refused: CR3 would drop bits 11:0 */
+        if (pt_set_cr3((void *)cr3) < 0) return -1;
+        loaded_cr3 = cr3;
+        cr3_loads++;
+    }
+#ifndef HOST_TEST
+    /* Interrupts/syscalls from ring 3 land on this task's kernel stack:
+       TSS.RSP0 for int 0x80 and interrupts, the per-CPU syscall block for
+       SYSCALL (which does not switch stacks by itself) */
+    if (next->kstack_top) {
+        extern void tss_set_rsp0(uint64_t rsp0);
+        extern void syscall_set_kstack(uint64_t rsp0);
+        tss_set_rsp0(next->kstack_top);
+        syscall_set_kstack(next->kstack_top);
+    }
+    /* TLS: the MSR writes are serializing, skip them when unchanged. The
+       kernel runs with the user GS base loaded (SWAPGS is only done
+       around the stack switch on SYSCALL entry), so writing the active
+       GS base here is right; KERNEL_GS_BASE always holds the per-CPU
+       syscall block. */
+    if (next->fs_base != loaded_fs) {
+        wrmsr(MSR_FS_BASE, next->fs_base);
+        loaded_fs = next->fs_base;
+    }
+    if (next->gs_base != loaded_gs) {
+        wrmsr(MSR_GS_BASE, next->gs_base);
+        loaded_gs = next->gs_base;
+    }
+#endif
+    return 0;
+}
+
+/* Set p's FS (which = 0) or GS (which = 1) base; takes effect at once if
+   p is running. */
+void sched_set_tls(process_t *p, int which, uint64_t base) {
+    if (which == 0) p->fs_base = base; else p->gs_base = base;
+    if (p != cur_task) return;
+#ifndef HOST_TEST
+    if (which == 0) { wrmsr(MSR_FS_BASE, base); loaded_fs = base; }
+    else            { wrmsr(MSR_GS_BASE, base); loaded_gs = base; }
+#endif
+}
+
+uint64_t sched_cr3_loads(void) { return cr3_loads; }
+
+/* A dead task's PML4 stays loaded until the next switch_mm (the idle
+   context and kernel tasks without a page table keep whatever is in CR3),
+   so its tables are only freed once CR3 points elsewhere. */
+void sched_forget_mm(void *pml4) {
+    uint64_t flags = irq_save();
+    if (pml4 && (uint64_t)pml4 == loaded_cr3) {
+        void *kern = pt_get_kernel_pml4();
+        pt_set_cr3(kern);
+        loaded_cr3 = (uint64_t)kern;
+        cr3_loads++;
+    }
+    irq_restore(flags);
 }
 
-/* Scheduler tick called from IRQ handler: saved_regs_ptr points to region
-   where ISR pushed registers. We must save this pointer for current task and
-   return the next task's saved RSP so the ISR will switch stacks.
+/* Core context switch shared by the timer IRQ and the yield vector:
+   saved_regs_ptr points to the register block pushed by the ISR. We save
+   it for the current context and return the saved RSP of the next one.
 */
-uint64_t scheduler_tick(uint64_t *saved_regs_ptr) {
-    /* Save current task rip */
-    /* Advance current index round-robin */
-    if (sched_current >= 0 && sched_current < task_count && saved_regs_ptr) {
-        /* Save current task's RSP (pointer to saved registers) */
-        tasks[sched_current]->stack_top = (uint64_t)saved_regs_ptr;
+uint64_t scheduler_switch(uint64_t *saved_regs_ptr) {
+    /* Charge the elapsed time by TSC (not by ticks, which may be stopped) */
+    uint64_t now = sched_clock();
+    uint64_t ran = last_switch_tsc ? now - last_switch_tsc : 0;
+    last_switch_tsc = now;
+
+    /* Context switches are the points where deferred frees make progress */
+    rcu_poll();
+
+    /* We are off the stack of the task that died last time: free it */
+    if (reap_pending) {
+        process_t *dead = reap_pending;
+        reap_pending = NULL;
+        pm_reap(dead);
     }
 
-    int next = (sched_current + 1) % (task_count == 0 ? 1 : task_count);
-    sched_current = next;
-    pm_set_current(tasks[sched_current]);
+    /* Save current context (a task, or the idle loop) */
+    process_t *prev = cur_task;
+    if (prev) {
+        prev->cpu_tsc += ran;
+        if (prev->dl.runtime) sched_dl_charge(prev, ran, now);
+        if (saved_regs_ptr) prev->stack_top = (uint64_t)saved_regs_ptr;
+    } else {
+        idle_tsc += ran;
+        if (saved_regs_ptr) idle_rsp = (uint64_t)saved_regs_ptr;
+    }
 
-    /* Send EOI to PIC */
-    extern void pic_send_eoi(int irq);
-    pic_send_eoi(0);
+    if (prev && prev->state == 2) trace_sched(TRACE_BLOCK, prev->pid, 0);
+    if (prev && prev->state == 3) trace_sched(TRACE_EXIT, prev->pid, (uint32_t)prev->exit_code);
+
+    process_t *start = (prev && prev->on_rq) ? prev->run_next : run_head;
+    if (prev && prev->state == 3) {
+        /* Leaving a dead task: unlink it now, but its stack is the one we
+           are running on, so an orphan is only released at the next switch */
+        rq_del(prev);
+        if (start == prev) start = run_head;
+        if (prev->flags & PF_AUTOREAP) reap_pending = prev;
+    }
+
+    process_t *next = sched_pick_dl();
+    if (!next) next = sched_pick_fair(start, now);
+    if (next != prev) trace_sched(TRACE_SWITCH, prev ? prev->pid : 0, next ? next->pid : 0);
+    cur_task = next;
+    if (next && next->dl.runtime) {
+        /* Deadline tasks are preempted by their budget timer and by
+           releases of earlier deadlines, not by the slice tick */
+        timer_add(&dl_budget_ev, now + (uint64_t)next->dl.remaining, dl_budget_fire, 0);
+        timer_sched_update(1);
+    } else {
+        if (dl_budget_ev.heap_idx >= 0) timer_cancel(&dl_budget_ev);
+        timer_sched_update(sched_nr_runnable());
+    }
+#ifndef HOST_TEST
+    fpu_switch(next);
+#endif
+    if (!next) {
+        pm_set_current(NULL);
+        return idle_rsp ? idle_rsp : (uint64_t)saved_regs_ptr;
+    }
+
+    if (next->state == 0) next->state = 1; /* running */
+    if (switch_mm(next) < 0) {
+        /* never run a task on someone else's address space: kill it the
+           way sys_exit would and idle until the next tick picks again */
+        klog_err("[sched] pid=%lu has an unaligned PML4 0x%lx -> killing",
+                 next->pid, (uint64_t)next->page_table);
+        cur_task = NULL;
+        need_resched = 1;
+#ifndef HOST_TEST
+        fpu_switch(NULL);
+#endif
+        pm_set_current(NULL);
+        rq_del(next);
+        pm_exit(next, -1);
+        /* a waiting parent finds it dead; an orphan goes now unless its
+           stack is the one we are on */
+        if (next->flags & PF_AUTOREAP) {
+            if (next == prev) reap_pending = next;
+            else pm_reap(next);
+        }
+        return idle_rsp ? idle_rsp : (uint64_t)saved_regs_ptr;
+    }
+    pm_set_current(next);
+    return next->stack_top;
+}
+
+/* Scheduler tick called from the timer IRQ handler: acknowledge the
+   interrupt and run expired timer events, then switch if the time slice
+   is over or a sleeper was woken.
+*/
+uint64_t scheduler_tick(uint64_t *saved_regs_ptr) {
+    extern int timer_interrupt(void);
+    int slice_over = timer_interrupt();
+
+    if (!slice_over && !need_resched) return (uint64_t)saved_regs_ptr;
+    need_resched = 0;
+    return scheduler_switch(saved_regs_ptr);
+}
+
+/* Make a sleeping task runnable again (called from timer/IPC wakeups with
+   interrupts disabled). */
+void sched_wake(process_t *p) {
+    if (!p || p->state != 2) return;
+    p->state = 0;
+    trace_sched(TRACE_WAKEUP, p->pid, 0);
+    int cpu = sched_select_cpu(p);
+    if (cpu != p->cpu) trace_sched(TRACE_MIGRATE, p->pid, (uint16_t)cpu);
+    p->cpu = cpu;
+    need_resched = 1;
+    timer_sched_update(sched_nr_runnable());
+}
+
+/* Total CPU time spent idle (halted in the boot context), in TSC cycles */
+uint64_t sched_idle_tsc(void) {
+    uint64_t t = idle_tsc;
+    if (!cur_task && last_switch_tsc) t += sched_clock() - last_switch_tsc;
+    return t;
+}
 
-    return tasks[sched_current]->stack_top;
+/* Give up the CPU immediately: raise the yield vector so the ISR builds a
+   full register frame exactly like a timer preemption would. */
+void scheduler_yield(void) {
+    asm volatile ("int $0x81" ::: "memory");
 }
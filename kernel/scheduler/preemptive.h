@@ -8,12 +8,75 @@
 /* Create a kernel task (entry is function pointer). Returns pid or -1. */
 int task_create(void (*entry)(void));
 
+/* Create a ring-3 task entering at entry with stack user_sp in the given
+   address space (NULL = kernel PML4). Returns 0 or -1. */
+int task_create_user(uint64_t entry, uint64_t user_sp, void *page_table);
+
+/* Run an already registered process (e.g. from elf_load) in ring 3 at its
+   entry point on user_sp. The task stays waitable. Returns 0 or -1. */
+int task_start_user(process_t *proc, uint64_t user_sp);
+
 /* Start the scheduler — transfers control to tasks (non-returning) */
 void scheduler_start(void);
 
 /* Called by IRQ handler: pass pointer to saved regs (current RSP). Returns new RSP */
 uint64_t scheduler_tick(uint64_t *saved_regs_ptr);
 
+/* Save the current context and pick the next runnable task (no EOI).
+   Used by the yield vector (isr_0x81). Returns new RSP */
+uint64_t scheduler_switch(uint64_t *saved_regs_ptr);
+
+/* Voluntarily hand the CPU to the next runnable task right now */
+void scheduler_yield(void);
+
+/* Mark a sleeping task runnable; the switch happens at the next IRQ */
+void sched_wake(process_t *p);
+
+/* Idle time accounting (TSC cycles spent in the idle context) */
+uint64_t sched_idle_tsc(void);
+
+/* Number of CR3 writes done by the switch path (address-space changes) */
+uint64_t sched_cr3_loads(void);
+
+/* pml4 is about to be freed: if CR3 still holds it, load the kernel PML4 */
+void sched_forget_mm(void *pml4);
+
+/* Create a thread sharing parent's address space (see preemptive.c).
+   Returns the new thread or NULL. */
+process_t *thread_create(process_t *parent, uint64_t entry, uint64_t stack_top, uint64_t tls);
+
+/* Set a task's FS (which = 0) or GS (which = 1) TLS base */
+void sched_set_tls(process_t *p, int which, uint64_t base);
+
+/* CPU affinity. Masks have one bit per CPU; only CPU 0 is online until
+   APs are brought up. sched_set_affinity returns 0 or -1 (empty mask). */
+int sched_cpu_id(void);
+uint64_t sched_cpus_online(void);
+uint64_t sched_cpus_isolated(void);
+uint64_t sched_default_mask(void);
+int sched_set_affinity(process_t *p, uint64_t mask);
+
+/* Isolated CPUs (isolcpus=<list> on the boot command line) only run
+   tasks whose affinity names them */
+void sched_set_isolated(uint64_t mask);
+uint64_t sched_parse_cpulist(const char *s);
+
+/* Deadline (EDF) class, see deadline.h. sched_setattr takes ns (runtime
+   0 = fair class) and returns -1 when admission control refuses;
+   sched_dl_yield ends the current job of a deadline task. */
+int sched_setattr(process_t *p, uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns);
+void sched_dl_yield(void);
+
+/* Gang scheduling: members of a gang are run together in slots of the
+   gang's slice (default SCHED_GANG_SLICE_NS) instead of being interleaved
+   with other tasks. sched_gang_create returns the gang id or -1;
+   sched_gang_join(p, 0) takes p out of its gang. */
+#define SCHED_MAX_GANGS     16
+#define SCHED_GANG_SLICE_NS (4 * SCHED_SLICE_NS)
+int sched_gang_create(uint64_t slice_ns);
+int sched_gang_join(process_t *p, int gang);
+uint64_t sched_gang_slots(int gang);
+
 /* Test helper: add an existing process to tasks list */
 int sched_add_existing_process(process_t *p);
 
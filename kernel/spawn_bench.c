@@ -0,0 +1,114 @@
+/* kernel/spawn_bench.c
+ * Spawn vs fork+exec benchmark (build with -DRUN_SPAWN_BENCH). The
+ * benchmark task runs on a private PML4 with a heap of 0..64 MiB mapped
+ * in 4 KiB pages. fork+exec clones the task (pt_clone_for_cow walks and
+ * write-protects every heap PTE) and then loads the user_hello image;
+ * spawn builds the same child through elf_spawn without touching the
+ * parent's tables. Children are killed before they can run. Also reports
+ * how many parent pages fork left read-only (future COW faults).
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "mm/pagetable.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+
+extern unsigned char build_user_hello_elf[];
+extern unsigned int build_user_hello_elf_len;
+
+#define ITERS 16
+#define HEAP_VADDR 0x0000008000000000ULL   /* PML4 slot 1, outside the identity map */
+#define HEAP_PHYS  (32ULL * 1024 * 1024)   /* frames only counted, never touched */
+
+static void *map_heap(uint64_t bytes) {
+    void *pml4 = pt_clone_current();
+    if (!pml4) return NULL;
+    for (uint64_t off = 0; off < bytes; off += 4096)
+        if (pt_map_page(pml4, HEAP_VADDR + off, HEAP_PHYS + off, 0x7) < 0) return NULL;
+    return pml4;
+}
+
+static uint64_t readonly_pages(void *pml4, uint64_t bytes) {
+    uint64_t n = 0;
+    for (uint64_t off = 0; off < bytes; off += 4096) {
+        uint64_t *pte = pt_find_pte_for_vaddr(pml4, HEAP_VADDR + off);
+        if (pte && !(*pte & 0x2)) n++;
+    }
+    return n;
+}
+
+static void kill(process_t *p) {
+    if (!p) return;
+    p->state = 3;
+    pm_reap(p);
+}
+
+static void report(const char *name, uint64_t heap_mib, uint64_t cycles, uint64_t ro) {
+    serial_puts("[spawn_bench] ");
+    serial_puts(name);
+    serial_puts(": heap_mib=");
+    serial_put_dec(heap_mib);
+    serial_puts(" cycles_each=");
+    serial_put_dec(cycles / ITERS);
+    serial_puts(" per_sec=");
+    serial_put_dec(timer_tsc_hz() * ITERS / (cycles ? cycles : 1));
+    serial_puts(" parent_cow_pages=");
+    serial_put_dec(ro);
+    serial_putc('\n');
+}
+
+static void run_case(process_t *self, uint64_t heap_mib) {
+    uint64_t bytes = heap_mib * 1024 * 1024;
+    uint64_t *kernel_pt = self->page_table;
+
+    void *pml4 = map_heap(bytes);
+    if (!pml4) {
+        serial_puts("[spawn_bench] cannot map heap\n");
+        return;
+    }
+    self->page_table = pml4;
+
+    /* spawn first, while the heap is still private and writable */
+    uint64_t cycles = 0;
+    for (int i = 0; i < ITERS; i++) {
+        uint64_t flags = irq_save();
+        uint64_t t0 = rdtsc();
+        process_t *c = elf_spawn(build_user_hello_elf, build_user_hello_elf_len, self);
+        cycles += rdtsc() - t0;
+        kill(c);
+        irq_restore(flags);
+    }
+    report("spawn", heap_mib, cycles, readonly_pages(pml4, bytes));
+
+    cycles = 0;
+    for (int i = 0; i < ITERS; i++) {
+        uint64_t flags = irq_save();
+        uint64_t t0 = rdtsc();
+        process_t *c = pm_clone_process(self);
+        process_t *e = elf_load(build_user_hello_elf, build_user_hello_elf_len);
+        cycles += rdtsc() - t0;
+        kill(c);        /* never let the clone resume the copied frame */
+        kill(e);
+        irq_restore(flags);
+    }
+    report("fork+exec", heap_mib, cycles, readonly_pages(pml4, bytes));
+
+    self->page_table = kernel_pt;
+}
+
+static void spawn_bench_task(void) {
+    process_t *self = pm_get_current();
+    run_case(self, 0);
+    run_case(self, 4);
+    run_case(self, 16);
+    run_case(self, 64);
+    serial_puts("[spawn_bench] done\n");
+}
+
+void spawn_bench(void) {
+    serial_puts("[spawn_bench] creating benchmark task\n");
+    task_create(spawn_bench_task);
+}
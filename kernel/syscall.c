@@ -6,7 +6,15 @@
 #include "syscall.h"
 #include "process_manager.h"
 #include "drivers/serial.h"
+#include "klog.h"
 #include "elf_loader.h"
+#include "trace.h"
+#include "uring.h"
+#include "vdso.h"
+#include "futex.h"
+#include "ipc/page_ipc.h"
+#include "arch/x86/cpu.h"
+#include "arch/x86/uaccess.h"
 #include <string.h>
 
 /* Embedded builtin binaries are referenced via extern to avoid multiple
@@ -19,43 +27,47 @@ extern unsigned int build_user_hello_elf_len;
  * Receives syscall number + 3 args in RDI, RSI, RDX (x86-64 calling convention)
  * Returns result in RAX
  */
-void syscall_install(void) {
-    /* TODO: Setup int 0x80 handler (legacy x86 trap)
-     * TODO: Setup syscall/sysret MSR (fast path on x86-64)
-     */
-    serial_puts("[syscall] installed int 0x80 handler\n");
+/* SYSCALL/SYSRET fast path. int 0x80 (isr_0x80, installed by idt.c)
+ * stays available; both paths end in syscall_dispatch with the same
+ * arguments, except that SYSCALL clobbers RCX (return RIP) and R11
+ * (RFLAGS), so the third argument travels in R10 instead of RCX.
+ *
+ * SYSCALL does not switch stacks. syscall_entry (interrupts.S) does
+ * SWAPGS to reach this per-CPU block, parks the user RSP and loads the
+ * running task's kernel stack, then swaps GS back before calling C.
+ */
+#define MSR_EFER           0xC0000080
+#define MSR_STAR           0xC0000081
+#define MSR_LSTAR          0xC0000082
+#define MSR_SFMASK         0xC0000084
+#define MSR_KERNEL_GS_BASE 0xC0000102
+#define EFER_SCE           (1ULL << 0)
+
+/* Field offsets are used by syscall_entry */
+struct syscall_cpu {
+    uint64_t kernel_rsp;    /* 0: top of the running task's kernel stack */
+    uint64_t user_rsp;      /* 8: user RSP while switching stacks */
+};
+
+static struct syscall_cpu syscall_cpu;     /* boot CPU (no APs yet) */
+
+void syscall_set_kstack(uint64_t rsp0) {
+    syscall_cpu.kernel_rsp = rsp0;
 }
 
-/* Dispatcher - routes syscall number to handler */
-syscall_result_t syscall_dispatch(uint64_t num, uint64_t arg1, uint64_t arg2, uint64_t arg3) {
-    switch (num) {
-        case SYS_EXIT:
-            sys_exit((int)arg1);
-            return 0;
-        case SYS_YIELD:
-            sys_yield();
-            return 0;
-        case SYS_LOG:
-            return sys_log((const char *)arg1);
-        case SYS_MMAP:
-            return (int64_t)sys_mmap(arg1, arg2, (int)arg3);
-        case SYS_FORK:
-            return sys_fork();
-        case SYS_EXEC:
-            return sys_exec((const char *)arg1, (char **)arg2);
-        case SYS_WAIT:
-            return sys_wait((int)arg1);
-        case SYS_READ:
-            return sys_read((int)arg1, (void *)arg2, (int)arg3);
-        case SYS_WRITE:
-            return sys_write((int)arg1, (const void *)arg2, (int)arg3);
-        case SYS_OPEN:
-            return sys_open((const char *)arg1, (int)arg2);
-        case SYS_CLOSE:
-            return sys_close((int)arg1);
-        default:
-            return -1; /* EINVAL */
-    }
+void syscall_install(void) {
+#ifndef HOST_TEST
+    extern void syscall_entry(void);
+    /* SYSCALL: CS = 0x08, SS = 0x10. SYSRET (64-bit): SS = 0x10 + 8 = user
+       data 0x1B, CS = 0x10 + 16 = user code 0x23 (see gdt.c). */
+    wrmsr(MSR_STAR, (0x10ULL << 48) | (0x08ULL << 32));
+    wrmsr(MSR_LSTAR, (uint64_t)syscall_entry);
+    /* Enter with IF, TF, DF and AC clear, like the int 0x80 gate */
+    wrmsr(MSR_SFMASK, (1ULL << 8) | (1ULL << 9) | (1ULL << 10) | (1ULL << 18));
+    wrmsr(MSR_KERNEL_GS_BASE, (uint64_t)&syscall_cpu);
+    wrmsr(MSR_EFER, rdmsr(MSR_EFER) | EFER_SCE);
+#endif
+    klog_info("[syscall] installed int 0x80 handler and SYSCALL fast path");
 }
 
 /* ============================================================
@@ -64,34 +76,36 @@ syscall_result_t syscall_dispatch(uint64_t num, uint64_t arg1, uint64_t arg2, ui
  */
 
 void sys_exit(int code) {
-    serial_puts("[sys_exit] called\n");
+    klog_debug("[sys_exit] code=%d", code);
     extern process_t *pm_get_current(void);
     process_t *cur = pm_get_current();
-    if (cur) {
-        /* Close all file descriptors held by process */
-        extern void fs_decref(int fd);
-        for (int i = 0; i < 16; ++i) {
-            if (cur->fds[i] >= 0) fs_decref(cur->fds[i]);
-        }
-        cur->exit_code = code;
-        cur->state = 3; /* dead */
-    }
+    /* Close descriptors, drop rings and FPU state; sys_wait or the
+       scheduler reaps the rest */
+    if (cur) pm_exit(cur, code);
     /* For now busy-yield to let scheduler pick next task */
     while (1) sys_yield();
 }
 
 void sys_yield(void) {
-    /* Yield CPU to next task (triggers round-robin)
-     * TODO: Call scheduler_yield()
+    /* Yield CPU to next task right away (round-robin). The switch goes
+     * through the yield vector so the full register frame is saved just
+     * like a timer preemption; we resume here when picked again.
      */
-    serial_puts("[sys_yield] called\n");
+    extern void scheduler_yield(void);
+    scheduler_yield();
 }
 
+#define SYS_LOG_MAX   256     /* longer messages are truncated */
+#define SYS_PATH_MAX  128
+
 syscall_result_t sys_log(const char *msg) {
     /* Write message to serial port (kernel logging) */
-    if (!msg) return -1;
+    char buf[SYS_LOG_MAX];
+    int64_t n = strncpy_from_user(buf, msg, sizeof(buf) - 1);
+    if (n < 0) return -1;
+    buf[n] = 0;
     serial_puts("[user] ");
-    serial_puts(msg);
+    serial_puts(buf);
     serial_putc('\n');
     return 0;
 }
@@ -101,7 +115,7 @@ void *sys_mmap(uint64_t addr, uint64_t size, int prot) {
      * Prot flags: PROT_READ=0x1, PROT_WRITE=0x2, PROT_EXEC=0x4
      * TODO: Call virtual_memory_alloc(addr, size, prot)
      */
-    serial_puts("[sys_mmap] called\n");
+    klog_debug("[sys_mmap] called (not implemented)");
     return NULL;
 }
 
@@ -119,7 +133,7 @@ int sys_fork(void) {
     if (cur) {
         process_t *child = pm_clone_process(cur);
         if (!child) {
-            serial_puts("[sys_fork] pm_clone failed\n");
+            klog_warn("[sys_fork] pm_clone failed");
             return -1;
         }
         /* Ensure child will see 0 as fork return value */
@@ -131,13 +145,11 @@ int sys_fork(void) {
     extern int process_create(void (*entry)(void));
     int child_pid = process_create(NULL);
     if (child_pid < 0) {
-        serial_puts("[sys_fork] failed: no free process slots\n");
+        klog_warn("[sys_fork] failed: no free process slots");
         return -1;
     }
 
-    serial_puts("[sys_fork] created pid ");
-    serial_put_hex((uint64_t)child_pid);
-    serial_putc('\n');
+    klog_info("[sys_fork] created pid %d", child_pid);
 
     /* Return child's PID to the caller (parent). A real fork would
      * return 0 in the child context but that requires scheduler support
@@ -146,16 +158,33 @@ int sys_fork(void) {
     return child_pid;
 }
 
+/* Resolve a user path to an embedded ELF image (no filesystem yet): NULL,
+   "/hello" and "hello" name the builtin user_hello binary */
+static const uint8_t *builtin_image(const char *upath, size_t *len) {
+    char path[SYS_PATH_MAX];
+    if (upath) {
+        int64_t n = strncpy_from_user(path, upath, sizeof(path));
+        if (n < 0 || n == (int64_t)sizeof(path)) return NULL;
+    }
+    if (!upath || strcmp(path, "/hello") == 0 || strcmp(path, "hello") == 0) {
+        *len = build_user_hello_elf_len;
+        return build_user_hello_elf;
+    }
+    return NULL;
+}
+
 int sys_exec(const char *path, char **argv) {
     /* Minimal sys_exec for Phase1:
-     * - If path is NULL or equals "/hello" or "hello", load embedded user_hello ELF
+     * - Resolve path to an embedded ELF (builtin_image)
      * - Call elf_load() then elf_exec() which performs an iretq to ring-3.
      * This is a Phase1 convenience implementation (no filesystem yet).
      */
-    if (!path || strcmp(path, "/hello") == 0 || strcmp(path, "hello") == 0) {
-        process_t *proc = elf_load(build_user_hello_elf, build_user_hello_elf_len);
+    size_t len;
+    const uint8_t *image = builtin_image(path, &len);
+    if (image) {
+        process_t *proc = elf_load(image, len);
         if (!proc) {
-            serial_puts("[sys_exec] elf_load failed\n");
+            klog_warn("[sys_exec] elf_load failed");
             return -1;
         }
 
@@ -163,26 +192,53 @@ int sys_exec(const char *path, char **argv) {
         return elf_exec(proc, argv, NULL);
     }
 
-    serial_puts("[sys_exec] path not recognized (no FS)\n");
+    klog_warn("[sys_exec] path not recognized (no FS)");
     return -1;
 }
 
+int sys_spawn(const char *path, char **argv) {
+    /* fork+exec in one step: the child is built from the ELF image, the
+       caller's address space is left alone (see elf_spawn) */
+    (void)argv;
+    size_t len;
+    const uint8_t *image = builtin_image(path, &len);
+    if (!image) {
+        klog_warn("[sys_spawn] path not recognized (no FS)");
+        return -1;
+    }
+    extern process_t *pm_get_current(void);
+    process_t *child = elf_spawn(image, len, pm_get_current());
+    if (!child) {
+        klog_warn("[sys_spawn] elf_spawn failed");
+        return -1;
+    }
+    return (int)child->pid;
+}
+
 int sys_wait(int pid) {
-    serial_puts("[sys_wait] waiting for pid= ");
-    serial_put_hex((uint64_t)pid);
-    serial_putc('\n');
+    klog_debug("[sys_wait] waiting for pid=%d", pid);
     extern process_t *pm_find_by_pid(uint64_t pid);
     process_t *p;
     while (1) {
+        int rcu = rcu_read_lock();
         p = pm_find_by_pid((uint64_t)pid);
         if (!p) {
             /* no such pid */
+            rcu_read_unlock(rcu);
             return -1;
         }
         if (p->state == 3) {
-            /* child exited */
-            return p->exit_code;
+            /* child exited: collect it (tasks nobody waits for are
+               reaped by the scheduler on their own) */
+            int code = p->exit_code;
+            if (!(p->flags & PF_AUTOREAP)) {
+                extern void pm_reap(process_t *p);
+                pm_reap(p);
+            }
+            rcu_read_unlock(rcu);
+            return code;
         }
+        rcu_read_unlock(rcu);
         sys_yield();
     }
 }
@@ -191,7 +247,7 @@ int sys_read(int fd, void *buf, int count) {
     /* Read from file descriptor
      * TODO: Route to file system or device driver
      */
-    serial_puts("[sys_read] called (not implemented)\n");
+    klog_debug("[sys_read] called (not implemented)");
     return -1;
 }
 
@@ -199,28 +255,243 @@ int sys_write(int fd, const void *buf, int count) {
     /* Write to file descriptor
      * fd=1 -> stdout (serial), fd=2 -> stderr (serial)
      */
+    if (count < 0 || !access_ok(buf, (uint64_t)count)) return -1;
     if (fd == 1 || fd == 2) {
+        /* through a bounce buffer; output stops at a NUL byte */
+        char chunk[128];
         const char *p = (const char *)buf;
-        for (int i = 0; i < count && p[i]; i++) {
-            serial_putc(p[i]);
+        for (int done = 0; done < count; ) {
+            int n = count - done < (int)sizeof(chunk) ? count - done : (int)sizeof(chunk);
+            if (copy_from_user(chunk, p + done, (uint64_t)n)) return done ? done : -1;
+            int len = 0;
+            while (len < n && chunk[len]) len++;
+            serial_write(chunk, (uint32_t)len);
+            if (len < n) return count;
+            done += n;
         }
         return count;
     }
+    /* Files opened with sys_open have no backing store yet: accept and
+       discard the data */
+    extern int fs_refcount(int fd);
+    if (fd > 2 && fs_refcount(fd) > 0) return count;
     return -1;
 }
 
 int sys_open(const char *path, int flags) {
-    /* Phase1: allocate a simple in-kernel file descriptor; path/flags ignored */
+    /* Phase1: allocate a simple in-kernel file descriptor; the path is
+       only checked for readability, flags are ignored */
+    char kpath[SYS_PATH_MAX];
+    if (strncpy_from_user(kpath, path, sizeof(kpath)) < 0) return -1;
     extern int fs_alloc(void);
     int fd = fs_alloc();
     if (fd < 0) return -1;
-    serial_puts("[sys_open] allocated fd="); serial_put_hex(fd); serial_putc('\n');
+    klog_debug("[sys_open] allocated fd=%d", fd);
     return fd;
 }
 
 int sys_close(int fd) {
     extern void fs_decref(int fd);
     fs_decref(fd);
-    serial_puts("[sys_close] closed fd="); serial_put_hex(fd); serial_putc('\n');
+    klog_debug("[sys_close] closed fd=%d", fd);
+    return 0;
+}
+
+int sys_sleep(uint64_t ns) {
+    /* Block the caller for at least ns nanoseconds (timer heap wakeup) */
+    extern void timer_sleep_ns(uint64_t ns);
+    timer_sleep_ns(ns);
     return 0;
 }
+
+int sys_clone(uint64_t flags, uint64_t entry, uint64_t stack_top, uint64_t tls) {
+    /* Without CLONE_VM this is a plain fork */
+    if (!(flags & CLONE_VM)) return sys_fork();
+
+    extern process_t *pm_get_current(void);
+    extern process_t *thread_create(process_t *parent, uint64_t entry,
+                                    uint64_t stack_top, uint64_t tls);
+    process_t *cur = pm_get_current();
+    if (!cur || !entry) return -1;
+
+    process_t *t = thread_create(cur, entry, stack_top, (flags & CLONE_SETTLS) ? tls : 0);
+    if (!t) {
+        klog_warn("[sys_clone] thread creation failed");
+        return -1;
+    }
+    return (int)t->pid;
+}
+
+int64_t sys_arch_prctl(int code, uint64_t addr) {
+    extern process_t *pm_get_current(void);
+    extern void sched_set_tls(process_t *p, int which, uint64_t base);
+    process_t *cur = pm_get_current();
+    if (!cur) return -1;
+
+    switch (code) {
+        case ARCH_SET_FS: sched_set_tls(cur, 0, addr); return 0;
+        case ARCH_SET_GS: sched_set_tls(cur, 1, addr); return 0;
+        case ARCH_GET_FS: return (int64_t)cur->fs_base;
+        case ARCH_GET_GS: return (int64_t)cur->gs_base;
+        default: return -1;
+    }
+}
+
+/* Affinity of pid (0 = caller) as a CPU bitmask. Like Linux, a mask must
+   name at least one online CPU. */
+int sys_sched_setaffinity(uint64_t pid, uint64_t mask) {
+    extern process_t *pm_get_current(void);
+    extern process_t *pm_find_by_pid(uint64_t pid);
+    extern uint64_t sched_cpus_online(void);
+    extern int sched_set_affinity(process_t *p, uint64_t mask);
+    extern int sched_cpu_id(void);
+
+    if (!(mask & sched_cpus_online())) return -1;
+    process_t *cur = pm_get_current();
+    int rcu = rcu_read_lock();
+    process_t *p = pid ? pm_find_by_pid(pid) : cur;
+    int ret = (p && p->state != 3) ? sched_set_affinity(p, mask) : -1;
+    rcu_read_unlock(rcu);
+    /* Moved off this CPU: leave now rather than at the next tick */
+    if (ret == 0 && p == cur && !(mask & (1ULL << sched_cpu_id()))) sys_yield();
+    return ret;
+}
+
+int64_t sys_sched_getaffinity(uint64_t pid) {
+    extern process_t *pm_get_current(void);
+    extern process_t *pm_find_by_pid(uint64_t pid);
+    int rcu = rcu_read_lock();
+    process_t *p = pid ? pm_find_by_pid(pid) : pm_get_current();
+    int64_t mask = p ? (int64_t)p->cpus_allowed : -1;
+    rcu_read_unlock(rcu);
+    return mask;
+}
+
+/* Deadline class parameters of pid (0 = caller), in ns. runtime 0 moves
+   the task back to the fair class; -1 if admission control refuses. */
+int sys_sched_setattr(uint64_t pid, uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns) {
+    extern process_t *pm_get_current(void);
+    extern process_t *pm_find_by_pid(uint64_t pid);
+    extern int sched_setattr(process_t *p, uint64_t runtime_ns, uint64_t deadline_ns,
+                             uint64_t period_ns);
+    int rcu = rcu_read_lock();
+    process_t *p = pid ? pm_find_by_pid(pid) : pm_get_current();
+    int ret = (p && p->state != 3) ? sched_setattr(p, runtime_ns, deadline_ns, period_ns) : -1;
+    rcu_read_unlock(rcu);
+    return ret;
+}
+
+/* Scheduler tracer control (see trace.h for the TRACE_OP_* codes).
+   TRACE_OP_READ returns the number of events copied. */
+int64_t sys_trace(int op, uint64_t arg1, uint64_t arg2) {
+    switch (op) {
+        case TRACE_OP_START:
+            trace_start();
+            return 0;
+        case TRACE_OP_STOP:
+            trace_stop();
+            return 0;
+        case TRACE_OP_READ: {
+            if ((int64_t)arg2 <= 0 || !access_ok((void *)arg1, arg2 * sizeof(trace_event_t)))
+                return -1;
+            /* drain through a kernel buffer, one chunk at a time */
+            trace_event_t chunk[32];
+            trace_event_t *dst = (trace_event_t *)arg1;
+            int64_t total = 0;
+            while (total < (int64_t)arg2) {
+                int want = arg2 - total < 32 ? (int)(arg2 - total) : 32;
+                int n = trace_read(chunk, want);
+                if (n && copy_to_user(dst + total, chunk, n * sizeof(trace_event_t)))
+                    return -1;
+                total += n;
+                if (n < want) break;
+            }
+            return total;
+        }
+        case TRACE_OP_DUMP:
+            trace_dump_serial();
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+/* Gang scheduling: create a gang or move a task in/out of one */
+int sys_sched_gang(int op, uint64_t arg1, uint64_t arg2) {
+    extern process_t *pm_get_current(void);
+    extern process_t *pm_find_by_pid(uint64_t pid);
+    extern int sched_gang_create(uint64_t slice_ns);
+    extern int sched_gang_join(process_t *p, int gang);
+    if (op == GANG_CREATE) return sched_gang_create(arg1);
+    if (op != GANG_JOIN) return -1;
+
+    int rcu = rcu_read_lock();
+    process_t *p = arg1 ? pm_find_by_pid(arg1) : pm_get_current();
+    int ret = (p && p->state != 3) ? sched_gang_join(p, (int)arg2) : -1;
+    rcu_read_unlock(rcu);
+    return ret;
+}
+
+/* Thread group id of the caller (its own pid for single-threaded tasks);
+   also the null syscall used to time the entry paths */
+int64_t sys_getpid(void) {
+    extern process_t *pm_get_current(void);
+    process_t *cur = pm_get_current();
+    if (!cur) return 0;
+    return (int64_t)(cur->tgid ? cur->tgid : cur->pid);
+}
+
+/* Batched syscall rings (uring.h). setup returns the address of the
+   shared region, 0 on failure. All operations complete inline, so
+   min_complete is always met once enter returns. */
+int64_t sys_uring_setup(uint64_t entries, uint64_t flags) {
+    extern process_t *pm_get_current(void);
+    return (int64_t)uring_setup(pm_get_current(), (uint32_t)entries, (uint32_t)flags);
+}
+
+int64_t sys_uring_enter(uint64_t to_submit, uint64_t min_complete, uint64_t flags) {
+    extern process_t *pm_get_current(void);
+    (void)min_complete;
+    return uring_enter(pm_get_current(), (uint32_t)to_submit, (uint32_t)flags);
+}
+
+/* Kernel-side clock (vdso.h layout). User space normally reads it from
+   the vDSO; this is the fallback and the baseline it is measured against. */
+int sys_clock_gettime(int clk, void *ts) {
+    extern uint64_t timer_now_ns(void);
+    if (clk != CLOCK_REALTIME && clk != CLOCK_MONOTONIC) return -1;
+    uint64_t ns = timer_now_ns();
+    if (clk == CLOCK_REALTIME) ns += vdso_get_data()->realtime_off;
+    vdso_timespec_t t;
+    t.tv_sec = (int64_t)(ns / 1000000000ULL);
+    t.tv_nsec = (int64_t)(ns % 1000000000ULL);
+    return copy_to_user(ts, &t, sizeof(t)) ? -1 : 0;
+}
+
+/* Futexes (futex.h): arg is the FUTEX_WAIT timeout in ns (0 = none) */
+int64_t sys_futex(uint64_t uaddr, int op, uint32_t val, uint64_t arg) {
+    switch (op) {
+        case FUTEX_WAIT: return futex_wait(uaddr, val, arg);
+        case FUTEX_WAKE: return futex_wake(uaddr, val);
+        default:         return -1;
+    }
+}
+
+/* Page-transfer messages (ipc/page_ipc.h) from and into the caller's
+   address space */
+static void *current_pml4(void) {
+    extern process_t *pm_get_current(void);
+    process_t *cur = pm_get_current();
+    return cur ? cur->page_table : NULL;
+}
+
+int sys_ipc_send_pages(uint64_t vaddr, uint64_t len, int mode) {
+    if (!access_ok((const void *)vaddr, len)) return -1;
+    return ipc_send_pages(current_pml4(), vaddr, len, mode);
+}
+
+int64_t sys_ipc_recv_pages(uint64_t vaddr, uint64_t maxlen) {
+    /* the destination is meant to be unmapped: only the range is checked */
+    if (!user_range_ok((const void *)vaddr, maxlen)) return -1;
+    return ipc_recv_pages(current_pml4(), vaddr, maxlen);
+}
@@ -21,6 +21,52 @@
 #define SYS_OPEN       10
 #define SYS_CLOSE      11
 #define SYS_STAT       12
+#define SYS_SLEEP      13
+#define SYS_CLONE      14
+#define SYS_ARCH_PRCTL 15
+#define SYS_SPAWN      16
+#define SYS_SCHED_SETAFFINITY 17
+#define SYS_SCHED_GETAFFINITY 18
+#define SYS_SCHED_SETATTR 19
+#define SYS_TRACE      20
+#define SYS_SCHED_GANG 21
+#define SYS_GETPID     22
+#define SYS_URING_SETUP 23
+#define SYS_URING_ENTER 24
+#define SYS_CLOCK_GETTIME 25
+#define SYS_SYSCALL_STATS 26
+#define SYS_FUTEX      27
+#define SYS_IPC_SEND_PAGES 28
+#define SYS_IPC_RECV_PAGES 29
+
+#define NR_SYSCALLS    30   /* size of the dispatch table (syscall_table.c) */
+
+/* SYS_CLONE flags (Linux values) */
+#define CLONE_VM       0x00000100   /* share the address space: create a thread */
+#define CLONE_SETTLS   0x00080000   /* arg4 is the new thread's FS base */
+
+/* SYS_SCHED_GANG operations */
+#define GANG_CREATE    0   /* arg1 = slice in ns (0 = default), returns the gang id */
+#define GANG_JOIN      1   /* arg1 = pid (0 = caller), arg2 = gang id (0 = leave) */
+
+/* SYS_SYSCALL_STATS: one record per implemented syscall, summed over CPUs */
+#define SYSCALL_HIST_BUCKETS 32     /* bucket b: 2^b <= cycles < 2^(b+1) */
+#define SYSCALL_STATS_RESET  0x1    /* flags: zero the counters after the copy */
+
+typedef struct syscall_stat {
+    uint32_t nr;
+    uint32_t nargs;
+    char     name[24];
+    uint64_t count;
+    uint64_t cycles;                /* TSC cycles spent in the handler */
+    uint64_t hist[SYSCALL_HIST_BUCKETS];
+} syscall_stat_t;
+
+/* SYS_ARCH_PRCTL codes (Linux values) */
+#define ARCH_SET_GS    0x1001
+#define ARCH_SET_FS    0x1002
+#define ARCH_GET_FS    0x1003
+#define ARCH_GET_GS    0x1004
 
 /* Syscall return type */
 typedef int64_t syscall_result_t;
@@ -28,8 +74,14 @@ typedef int64_t syscall_result_t;
 /* Register syscall handler (called from start.S trap handler) */
 void syscall_install(void);
 
-/* Syscall dispatcher (entry point from interrupt handler) */
-syscall_result_t syscall_dispatch(uint64_t num, uint64_t arg1, uint64_t arg2, uint64_t arg3);
+/* Kernel stack SYSCALL entries switch to (set on every task switch) */
+void syscall_set_kstack(uint64_t rsp0);
+
+/* Syscall dispatcher, reached from int 0x80 (isr_0x80) or the SYSCALL
+   instruction (syscall_entry, arg3 moved from R10). arg4 comes in R8,
+   which neither entry stub touches. Table-driven (syscall_table.c). */
+syscall_result_t syscall_dispatch(uint64_t num, uint64_t arg1, uint64_t arg2, uint64_t arg3,
+                                  uint64_t arg4);
 
 /* Individual syscall implementations */
 void sys_exit(int code);
@@ -43,5 +95,26 @@ int sys_read(int fd, void *buf, int count);
 int sys_write(int fd, const void *buf, int count);
 int sys_open(const char *path, int flags);
 int sys_close(int fd);
+int sys_sleep(uint64_t ns);
+int sys_clone(uint64_t flags, uint64_t entry, uint64_t stack_top, uint64_t tls);
+int64_t sys_arch_prctl(int code, uint64_t addr);
+int sys_spawn(const char *path, char **argv);
+int sys_sched_setaffinity(uint64_t pid, uint64_t mask);
+int64_t sys_sched_getaffinity(uint64_t pid);
+int sys_sched_setattr(uint64_t pid, uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns);
+int64_t sys_trace(int op, uint64_t arg1, uint64_t arg2);
+int sys_sched_gang(int op, uint64_t arg1, uint64_t arg2);
+int64_t sys_getpid(void);
+int64_t sys_uring_setup(uint64_t entries, uint64_t flags);
+int64_t sys_uring_enter(uint64_t to_submit, uint64_t min_complete, uint64_t flags);
+int sys_clock_gettime(int clk, void *ts);
+int sys_syscall_stats(void *buf, uint64_t max, uint64_t flags);
+int64_t sys_futex(uint64_t uaddr, int op, uint32_t val, uint64_t arg);
+int sys_ipc_send_pages(uint64_t vaddr, uint64_t len, int mode);
+int64_t sys_ipc_recv_pages(uint64_t vaddr, uint64_t maxlen);
+
+/* Per-syscall counters and latency histograms (syscall_table.c) */
+int syscall_stats_snapshot(syscall_stat_t *out, int max);
+void syscall_stats_reset(void);
 
 #endif /* SYSCALL_H */
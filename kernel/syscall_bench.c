@@ -0,0 +1,42 @@
+/* kernel/syscall_bench.c
+ * Null-syscall round trip from ring 3 (build with -DRUN_SYSCALL_BENCH).
+ * Spawns user/syscall_bench, which times SYS_GETPID through the SYSCALL
+ * fast path and through int 0x80, and returns cycles per call for both in
+ * its exit code; this task converts them to ns and reports them.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+#include "syscall.h"
+#include "user_syscall_bench_bin.h"
+
+static void report(const char *name, uint64_t cycles) {
+    serial_puts("[syscall_bench] ");
+    serial_puts(name);
+    serial_puts(": cycles=");
+    serial_put_dec(cycles);
+    serial_puts(" ns=");
+    serial_put_dec(timer_tsc_to_ns(cycles));
+    serial_putc('\n');
+}
+
+static void syscall_bench_task(void) {
+    process_t *child = elf_spawn(build_user_syscall_bench_elf,
+                                 build_user_syscall_bench_elf_len, pm_get_current());
+    if (!child) {
+        serial_puts("[syscall_bench] cannot spawn user/syscall_bench\n");
+        return;
+    }
+    uint64_t code = (uint64_t)sys_wait((int)child->pid);
+    report("syscall", code & 0xFFFF);
+    report("int80", (code >> 16) & 0xFFFF);
+    serial_puts("[syscall_bench] done\n");
+}
+
+void syscall_bench(void) {
+    serial_puts("[syscall_bench] creating benchmark task\n");
+    task_create(syscall_bench_task);
+}
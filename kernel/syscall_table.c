@@ -0,0 +1,191 @@
+/* kernel/syscall_table.c - syscall dispatch table and per-CPU statistics
+ *
+ * syscall_dispatch indexes a constant table by syscall number. Each entry
+ * records how many arguments the call takes; registers past that count
+ * are passed as 0, so no handler ever sees stale user register contents.
+ *
+ * Every call is counted and timed with the TSC into per-CPU counters and
+ * a log2 latency histogram (bucket b holds calls of 2^b..2^(b+1)-1
+ * cycles). A CPU only updates its own block, with interrupts masked
+ * around the update: a call that sleeps (sys_wait, futex_wait, chan_wait,
+ * timer_sleep_ns) may come back with them on, and a preemption in the
+ * middle of the read-modify-write would let another task on this CPU
+ * update the same block. No atomics are needed. SYS_SYSCALL_STATS sums the
+ * blocks into a snapshot.
+ */
+#include "syscall.h"
+#include "arch/x86/cpu.h"
+#include "arch/x86/uaccess.h"
+
+#define SYSCALL_MAX_CPUS 8
+
+typedef syscall_result_t (*syscall_fn_t)(const uint64_t *a);
+
+typedef struct syscall_desc {
+    syscall_fn_t fn;
+    uint8_t nargs;
+    uint8_t noreturn;       /* never comes back to the dispatcher */
+    const char *name;
+} syscall_desc_t;
+
+/* Adapters from the raw argument registers to the typed handlers */
+static syscall_result_t sc_exit(const uint64_t *a) { sys_exit((int)a[0]); return 0; }
+static syscall_result_t sc_yield(const uint64_t *a) {
+    (void)a;
+    /* from a deadline task this also ends its current job */
+    extern void sched_dl_yield(void);
+    sched_dl_yield();
+    return 0;
+}
+static syscall_result_t sc_log(const uint64_t *a) { return sys_log((const char *)a[0]); }
+static syscall_result_t sc_mmap(const uint64_t *a) { return (int64_t)sys_mmap(a[0], a[1], (int)a[2]); }
+static syscall_result_t sc_fork(const uint64_t *a) { (void)a; return sys_fork(); }
+static syscall_result_t sc_exec(const uint64_t *a) { return sys_exec((const char *)a[0], (char **)a[1]); }
+static syscall_result_t sc_wait(const uint64_t *a) { return sys_wait((int)a[0]); }
+static syscall_result_t sc_read(const uint64_t *a) { return sys_read((int)a[0], (void *)a[1], (int)a[2]); }
+static syscall_result_t sc_write(const uint64_t *a) { return sys_write((int)a[0], (const void *)a[1], (int)a[2]); }
+static syscall_result_t sc_open(const uint64_t *a) { return sys_open((const char *)a[0], (int)a[1]); }
+static syscall_result_t sc_close(const uint64_t *a) { return sys_close((int)a[0]); }
+static syscall_result_t sc_sleep(const uint64_t *a) { return sys_sleep(a[0]); }
+static syscall_result_t sc_clone(const uint64_t *a) { return sys_clone(a[0], a[1], a[2], a[3]); }
+static syscall_result_t sc_arch_prctl(const uint64_t *a) { return sys_arch_prctl((int)a[0], a[1]); }
+static syscall_result_t sc_spawn(const uint64_t *a) { return sys_spawn((const char *)a[0], (char **)a[1]); }
+static syscall_result_t sc_setaffinity(const uint64_t *a) { return sys_sched_setaffinity(a[0], a[1]); }
+static syscall_result_t sc_getaffinity(const uint64_t *a) { return sys_sched_getaffinity(a[0]); }
+static syscall_result_t sc_setattr(const uint64_t *a) { return sys_sched_setattr(a[0], a[1], a[2], a[3]); }
+static syscall_result_t sc_trace(const uint64_t *a) { return sys_trace((int)a[0], a[1], a[2]); }
+static syscall_result_t sc_gang(const uint64_t *a) { return sys_sched_gang((int)a[0], a[1], a[2]); }
+static syscall_result_t sc_getpid(const uint64_t *a) { (void)a; return sys_getpid(); }
+static syscall_result_t sc_uring_setup(const uint64_t *a) { return sys_uring_setup(a[0], a[1]); }
+static syscall_result_t sc_uring_enter(const uint64_t *a) { return sys_uring_enter(a[0], a[1], a[2]); }
+static syscall_result_t sc_clock_gettime(const uint64_t *a) { return sys_clock_gettime((int)a[0], (void *)a[1]); }
+static syscall_result_t sc_syscall_stats(const uint64_t *a) { return sys_syscall_stats((void *)a[0], a[1], a[2]); }
+static syscall_result_t sc_futex(const uint64_t *a) { return sys_futex(a[0], (int)a[1], (uint32_t)a[2], a[3]); }
+static syscall_result_t sc_ipc_send_pages(const uint64_t *a) { return sys_ipc_send_pages(a[0], a[1], (int)a[2]); }
+static syscall_result_t sc_ipc_recv_pages(const uint64_t *a) { return sys_ipc_recv_pages(a[0], a[1]); }
+
+static const syscall_desc_t syscall_table[NR_SYSCALLS] = {
+    [SYS_EXIT]              = { sc_exit,           1, 1, "exit" },
+    [SYS_YIELD]             = { sc_yield,          0, 0, "yield" },
+    [SYS_LOG]               = { sc_log,            1, 0, "log" },
+    [SYS_MMAP]              = { sc_mmap,           3, 0, "mmap" },
+    [SYS_FORK]              = { sc_fork,           0, 0, "fork" },
+    [SYS_EXEC]              = { sc_exec,           2, 0, "exec" },
+    [SYS_WAIT]              = { sc_wait,           1, 0, "wait" },
+    [SYS_READ]              = { sc_read,           3, 0, "read" },
+    [SYS_WRITE]             = { sc_write,          3, 0, "write" },
+    [SYS_OPEN]              = { sc_open,           2, 0, "open" },
+    [SYS_CLOSE]             = { sc_close,          1, 0, "close" },
+    [SYS_SLEEP]             = { sc_sleep,          1, 0, "sleep" },
+    [SYS_CLONE]             = { sc_clone,          4, 0, "clone" },
+    [SYS_ARCH_PRCTL]        = { sc_arch_prctl,     2, 0, "arch_prctl" },
+    [SYS_SPAWN]             = { sc_spawn,          2, 0, "spawn" },
+    [SYS_SCHED_SETAFFINITY] = { sc_setaffinity,    2, 0, "sched_setaffinity" },
+    [SYS_SCHED_GETAFFINITY] = { sc_getaffinity,    1, 0, "sched_getaffinity" },
+    [SYS_SCHED_SETATTR]     = { sc_setattr,        4, 0, "sched_setattr" },
+    [SYS_TRACE]             = { sc_trace,          3, 0, "trace" },
+    [SYS_SCHED_GANG]        = { sc_gang,           3, 0, "sched_gang" },
+    [SYS_GETPID]            = { sc_getpid,         0, 0, "getpid" },
+    [SYS_URING_SETUP]       = { sc_uring_setup,    2, 0, "uring_setup" },
+    [SYS_URING_ENTER]       = { sc_uring_enter,    3, 0, "uring_enter" },
+    [SYS_CLOCK_GETTIME]     = { sc_clock_gettime,  2, 0, "clock_gettime" },
+    [SYS_SYSCALL_STATS]     = { sc_syscall_stats,  3, 0, "syscall_stats" },
+    [SYS_FUTEX]             = { sc_futex,          4, 0, "futex" },
+    [SYS_IPC_SEND_PAGES]    = { sc_ipc_send_pages, 3, 0, "ipc_send_pages" },
+    [SYS_IPC_RECV_PAGES]    = { sc_ipc_recv_pages, 2, 0, "ipc_recv_pages" },
+};
+
+typedef struct syscall_cpu_stats {
+    uint64_t count[NR_SYSCALLS];
+    uint64_t cycles[NR_SYSCALLS];
+    uint64_t hist[NR_SYSCALLS][SYSCALL_HIST_BUCKETS];
+} __attribute__((aligned(64))) syscall_cpu_stats_t;
+
+static syscall_cpu_stats_t stats[SYSCALL_MAX_CPUS];
+
+static inline int syscall_hist_bucket(uint64_t cycles) {
+    int b = 63 - __builtin_clzll(cycles | 1);
+    return b < SYSCALL_HIST_BUCKETS ? b : SYSCALL_HIST_BUCKETS - 1;
+}
+
+syscall_result_t syscall_dispatch(uint64_t num, uint64_t arg1, uint64_t arg2, uint64_t arg3,
+                                  uint64_t arg4) {
+    extern int sched_cpu_id(void);
+    if (num >= NR_SYSCALLS || !syscall_table[num].fn)
+        return -1; /* EINVAL */
+    const syscall_desc_t *d = &syscall_table[num];
+
+    uint64_t a[4] = { arg1, arg2, arg3, arg4 };
+    for (int i = d->nargs; i < 4; i++) a[i] = 0;
+
+    if (d->noreturn) {
+        uint64_t flags = irq_save();
+        stats[sched_cpu_id()].count[num]++;
+        irq_restore(flags);
+        return d->fn(a);
+    }
+    uint64_t t0 = rdtsc();
+    syscall_result_t ret = d->fn(a);
+    uint64_t dt = rdtsc() - t0;
+
+    /* Counted on completion, so every counted call is in the histogram
+       and a reset from SYS_SYSCALL_STATS keeps them consistent. A
+       blocking call may come back on another CPU: charge that one. */
+    uint64_t flags = irq_save();
+    syscall_cpu_stats_t *s = &stats[sched_cpu_id()];
+    s->count[num]++;
+    s->cycles[num] += dt;
+    s->hist[num][syscall_hist_bucket(dt)]++;
+    irq_restore(flags);
+    return ret;
+}
+
+/* Sum the per-CPU blocks of one implemented syscall into *o */
+static void syscall_stat_fill(int nr, syscall_stat_t *o) {
+    const syscall_desc_t *d = &syscall_table[nr];
+    o->nr = (uint32_t)nr;
+    o->nargs = d->nargs;
+    int i = 0;
+    for (; d->name[i] && i < (int)sizeof(o->name) - 1; i++) o->name[i] = d->name[i];
+    for (; i < (int)sizeof(o->name); i++) o->name[i] = 0;
+    o->count = o->cycles = 0;
+    for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) o->hist[b] = 0;
+    for (int c = 0; c < SYSCALL_MAX_CPUS; c++) {
+        o->count += stats[c].count[nr];
+        o->cycles += stats[c].cycles[nr];
+        for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++)
+            o->hist[b] += stats[c].hist[nr][b];
+    }
+}
+
+int syscall_stats_snapshot(syscall_stat_t *out, int max) {
+    int n = 0;
+    for (int nr = 0; nr < NR_SYSCALLS && n < max; nr++)
+        if (syscall_table[nr].fn) syscall_stat_fill(nr, &out[n++]);
+    return n;
+}
+
+void syscall_stats_reset(void) {
+    uint64_t flags = irq_save();
+    uint8_t *p = (uint8_t *)stats;
+    for (uint64_t i = 0; i < sizeof(stats); i++) p[i] = 0;
+    irq_restore(flags);
+}
+
+/* Snapshot of every implemented syscall into a user array of max
+   entries; SYSCALL_STATS_RESET zeroes the counters afterwards. Returns
+   the number of entries written. */
+int sys_syscall_stats(void *buf, uint64_t max, uint64_t flags) {
+    if (max > NR_SYSCALLS) max = NR_SYSCALLS;
+    if (max && !access_ok(buf, max * sizeof(syscall_stat_t))) return -1;
+    syscall_stat_t *dst = (syscall_stat_t *)buf;
+    syscall_stat_t rec;
+    int n = 0;
+    for (int nr = 0; nr < NR_SYSCALLS && n < (int)max; nr++) {
+        if (!syscall_table[nr].fn) continue;
+        syscall_stat_fill(nr, &rec);
+        if (copy_to_user(&dst[n++], &rec, sizeof(rec))) return -1;
+    }
+    if (flags & SYSCALL_STATS_RESET) syscall_stats_reset();
+    return n;
+}
@@ -1,14 +1,21 @@
-/* kernel/tasks/process.c - a tiny process abstraction (stub) */
+/* kernel/tasks/process.c - bare process slots (legacy sys_fork fallback)
+ * Processes live in the process manager registry; this only creates an
+ * empty registered PCB for callers that have no parent to clone.
+ */
 #include <stdint.h>
-#include "../elf_loader.h"
+#include "../process_manager.h"
 
-process_t proc_table[16];
-int proc_count = 0;
+int proc_count = 0; /* processes created through process_create */
 
 int process_create(void (*entry)(void)) {
-    if (proc_count >= 16) return -1;
-    proc_table[proc_count].pid = proc_count;
-    proc_table[proc_count].entry_point = (uint64_t)entry;
-    proc_table[proc_count].stack_top = 0; /* simple stub */
-    return proc_count++;
+    process_t *p = pm_alloc_process();
+    if (!p) return -1;
+    p->entry_point = (uint64_t)entry;
+    uint64_t pid = pm_register_process(p);
+    if (!pid) {
+        pm_free_process(p);
+        return -1;
+    }
+    proc_count++;
+    return (int)pid;
 }
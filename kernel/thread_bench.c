@@ -0,0 +1,98 @@
+/* kernel/thread_bench.c
+ * Thread vs fork benchmark (build with -DRUN_THREAD_BENCH).
+ * Creation: THREADS kernel threads via thread_create (shared mm, no page
+ * table work) against the same number of pm_clone_process forks (PML4
+ * clone, stack copy). Fork children are killed before they can run, so only
+ * the creation path is timed. Both paths log one registration line.
+ * Switch: a ping-pong between two threads of one mm, then between two
+ * tasks in different address spaces (a fork-style PML4 clone).
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "arch/x86/cpu.h"
+#include "mm/pagetable.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+#include "syscall.h"
+
+#define THREADS 64
+#define ROUNDS 10000
+
+static volatile int turn = 0;
+static volatile int stop_pong = 0;
+static uint64_t tids[THREADS];
+
+static void report(const char *name, uint64_t cycles, uint64_t n) {
+    serial_puts("[thread_bench] ");
+    serial_puts(name);
+    serial_puts(": n=");
+    serial_put_dec(n);
+    serial_puts(" cycles_each=");
+    serial_put_dec(cycles / n);
+    serial_putc('\n');
+}
+
+static void empty_thread(void) { }
+
+static void pong(void) {
+    while (!stop_pong) {
+        while (turn != 1 && !stop_pong) scheduler_yield();
+        turn = 0;
+    }
+}
+
+static uint64_t ping_rounds(void) {
+    uint64_t t0 = rdtsc();
+    for (int i = 0; i < ROUNDS; i++) {
+        turn = 1;
+        while (turn != 0) scheduler_yield();
+    }
+    return rdtsc() - t0;
+}
+
+static void thread_bench_task(void) {
+    process_t *self = pm_get_current();
+
+    /* Thread creation */
+    uint64_t t0 = rdtsc();
+    for (int i = 0; i < THREADS; i++) {
+        process_t *t = thread_create(self, (uint64_t)empty_thread, 0, 0);
+        tids[i] = t ? t->pid : 0;
+    }
+    report("thread create", rdtsc() - t0, THREADS);
+    for (int i = 0; i < THREADS; i++)
+        if (tids[i]) sys_wait((int)tids[i]);
+
+    /* Fork creation */
+    uint64_t fork_cycles = 0;
+    for (int i = 0; i < THREADS; i++) {
+        uint64_t flags = irq_save();
+        t0 = rdtsc();
+        process_t *c = pm_clone_process(self);
+        fork_cycles += rdtsc() - t0;
+        if (c) {
+            c->state = 3;      /* never let it resume the copied frame */
+            pm_reap(c);
+        }
+        irq_restore(flags);
+    }
+    report("fork create", fork_cycles, THREADS);
+
+    /* Switch: thread <-> thread */
+    process_t *p = thread_create(self, (uint64_t)pong, 0, 0);
+    report("thread switch", ping_rounds() / 2, ROUNDS);
+
+    /* Switch: process <-> process (peer gets its own PML4 like a fork child) */
+    p->page_table = (uint64_t *)pt_clone_for_cow(self->page_table);
+    report("process switch", ping_rounds() / 2, ROUNDS);
+
+    stop_pong = 1;
+    sys_wait((int)p->pid);
+    serial_puts("[thread_bench] done\n");
+}
+
+void thread_bench(void) {
+    serial_puts("[thread_bench] creating benchmark task\n");
+    task_create(thread_bench_task);
+}
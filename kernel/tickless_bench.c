@@ -0,0 +1,59 @@
+/* kernel/tickless_bench.c
+ * Timer interrupt rate with and without dynamic ticks (build with
+ * -DRUN_TICKLESS_BENCH). Measures interrupts per second for an idle node
+ * (the only task sleeps) and for a single busy task, first with the
+ * periodic slice tick forced on, then with tickless mode.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "scheduler/preemptive.h"
+
+static void measure(const char *name, int busy) {
+    uint64_t hz = timer_tsc_hz();
+    uint64_t irq0 = timer_irq_count();
+    uint64_t idle0 = sched_idle_tsc();
+    uint64_t t0 = rdtsc();
+
+    if (busy) {
+        while (rdtsc() - t0 < hz)
+            asm volatile ("pause");
+    } else {
+        timer_sleep_ns(1000000000ULL);
+    }
+
+    uint64_t dt = rdtsc() - t0;
+    uint64_t irqs = timer_irq_count() - irq0;
+    uint64_t idle = sched_idle_tsc() - idle0;
+
+    serial_puts("[tickless_bench] ");
+    serial_puts(name);
+    serial_puts(timer_tickless() ? " tickless" : " periodic");
+    serial_puts(": irq_per_sec=");
+    serial_put_dec(irqs * hz / dt);
+    serial_puts(" idle_pct=");
+    serial_put_dec(idle * 100 / dt);
+    serial_putc('\n');
+}
+
+static void tickless_bench_task(void) {
+    if (timer_mode() == TIMER_MODE_PIT)
+        serial_puts("[tickless_bench] PIT fallback: ticks cannot be stopped\n");
+
+    timer_set_tickless(0);
+    measure("idle", 0);
+    measure("busy", 1);
+
+    timer_set_tickless(1);
+    measure("idle", 0);
+    measure("busy", 1);
+
+    serial_puts("[tickless_bench] done\n");
+}
+
+void tickless_bench(void) {
+    serial_puts("[tickless_bench] creating measurement task\n");
+    task_create(tickless_bench_task);
+}
@@ -0,0 +1,74 @@
+/* kernel/timer_bench.c
+ * Sleep-accuracy benchmark for the timer subsystem (build with
+ * -DRUN_TIMER_BENCH). A kernel task sleeps for several requested durations
+ * and reports how late each wakeup was as p50/p90/p99/max percentiles.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "scheduler/preemptive.h"
+
+#define SAMPLES 200
+
+static uint64_t lateness[SAMPLES];
+
+static void sort_u64(uint64_t *v, int n) {
+    for (int i = 1; i < n; i++) {
+        uint64_t x = v[i];
+        int j = i - 1;
+        while (j >= 0 && v[j] > x) { v[j + 1] = v[j]; j--; }
+        v[j + 1] = x;
+    }
+}
+
+static void run_case(uint64_t sleep_ns) {
+    for (int i = 0; i < SAMPLES; i++) {
+        uint64_t t0 = rdtsc();
+        timer_sleep_ns(sleep_ns);
+        uint64_t slept = timer_tsc_to_ns(rdtsc() - t0);
+        lateness[i] = slept > sleep_ns ? slept - sleep_ns : 0;
+    }
+    sort_u64(lateness, SAMPLES);
+
+    serial_puts("[timer_bench] sleep_us=");
+    serial_put_dec(sleep_ns / 1000);
+    serial_puts(" late_ns p50=");
+    serial_put_dec(lateness[SAMPLES / 2]);
+    serial_puts(" p90=");
+    serial_put_dec(lateness[SAMPLES * 90 / 100]);
+    serial_puts(" p99=");
+    serial_put_dec(lateness[SAMPLES * 99 / 100]);
+    serial_puts(" max=");
+    serial_put_dec(lateness[SAMPLES - 1]);
+    serial_putc('\n');
+}
+
+static void timer_bench_task(void) {
+    static const char *modes[] = { "pit", "lapic-oneshot", "tsc-deadline" };
+    serial_puts("[timer_bench] mode=");
+    serial_puts(modes[timer_mode()]);
+    serial_puts(" tsc_khz=");
+    serial_put_dec(timer_tsc_hz() / 1000);
+    serial_putc('\n');
+
+    run_case(50000);      /* 50 us */
+    run_case(200000);     /* 200 us */
+    run_case(1000000);    /* 1 ms */
+    run_case(5000000);    /* 5 ms */
+
+    serial_puts("[timer_bench] done\n");
+}
+
+/* A second task keeps the CPU busy so wakeups have to preempt someone */
+static void timer_bench_spinner(void) {
+    for (;;)
+        asm volatile ("pause");
+}
+
+void timer_bench(void) {
+    serial_puts("[timer_bench] creating sleeper + spinner tasks\n");
+    task_create(timer_bench_task);
+    task_create(timer_bench_spinner);
+}
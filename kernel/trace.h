@@ -0,0 +1,66 @@
+/* kernel/trace.h
+ * Scheduler event tracer. Each CPU owns a ring of fixed-size binary
+ * records (TSC timestamp, PID, event type, one argument) that overwrites
+ * its oldest entries when full. Recording is a handful of stores with
+ * interrupts briefly disabled; when tracing is off the hooks cost one
+ * predictable branch. The rings are drained with SYS_TRACE or dumped over
+ * serial, and tools/schedtrace2json turns a dump into Chrome trace JSON.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/* Event types */
+#define TRACE_SWITCH   1    /* pid = previous task, arg = next task (0 = idle) */
+#define TRACE_WAKEUP   2    /* pid = woken task */
+#define TRACE_BLOCK    3    /* pid = task that went to sleep */
+#define TRACE_MIGRATE  4    /* pid = task, arg = new CPU (0xFFFF = parked) */
+#define TRACE_FORK     5    /* pid = parent, arg = child */
+#define TRACE_EXIT     6    /* pid = task, arg = exit code */
+
+#define TRACE_MAX_CPUS     8
+#define TRACE_RING_EVENTS  4096     /* per CPU, power of two */
+
+typedef struct trace_event {
+    uint64_t tsc;
+    uint32_t pid;
+    uint32_t arg;
+    uint16_t type;
+    uint16_t cpu;
+    uint32_t reserved;
+} trace_event_t;
+
+/* SYS_TRACE operations */
+#define TRACE_OP_START  0
+#define TRACE_OP_STOP   1
+#define TRACE_OP_READ   2   /* arg1 = trace_event_t buffer, arg2 = capacity */
+#define TRACE_OP_DUMP   3   /* write every buffered event to serial */
+
+extern volatile int trace_enabled;
+
+void trace_record(int type, uint64_t pid, uint64_t arg);
+
+/* Hook used by the scheduler paths */
+static inline void trace_sched(int type, uint64_t pid, uint64_t arg) {
+    if (__builtin_expect(trace_enabled, 0)) trace_record(type, pid, arg);
+}
+
+void trace_start(void);
+void trace_stop(void);
+
+/* Move up to max buffered events (oldest first, CPU by CPU) into buf;
+   returns how many were copied */
+int trace_read(trace_event_t *buf, int max);
+
+/* Events lost to ring overwrites since trace_start */
+uint64_t trace_dropped(void);
+
+/* Drain everything to serial in the text form read by schedtrace2json:
+     [trace] begin tsc_hz=<dec> dropped=<dec>
+     [trace] <tsc> <cpu> <type> <pid> <arg>     (decimal fields)
+     [trace] end */
+void trace_dump_serial(void);
+
+#endif /* TRACE_H */
@@ -0,0 +1,76 @@
+/* kernel/trace_bench.c
+ * Scheduler tracer overhead (build with -DRUN_TRACE_BENCH). Times
+ * trace_record back to back with tracing on, and the disabled hook, against
+ * the 50 ns per event budget. Then traces a short workload of sleeping and
+ * yielding tasks and dumps it over serial for tools/schedtrace2json.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "arch/x86/cpu.h"
+#include "scheduler/preemptive.h"
+#include "trace.h"
+
+#define ITERS 1000000
+#define BUDGET_NS 50
+#define MS 1000000ULL
+
+static volatile int workers_done = 0;
+
+static void report(const char *name, uint64_t cycles) {
+    /* tenths of a ns per event, so sub-ns disabled hooks still show up */
+    uint64_t dns = timer_tsc_to_ns(cycles * 10) / ITERS;
+    serial_puts("[trace_bench] ");
+    serial_puts(name);
+    serial_puts(": ns_per_event=");
+    serial_put_dec(dns / 10);
+    serial_putc('.');
+    serial_put_dec(dns % 10);
+    serial_puts(dns <= BUDGET_NS * 10 ? " (within " : " (OVER ");
+    serial_put_dec(BUDGET_NS);
+    serial_puts(" ns budget)\n");
+}
+
+static void worker(void) {
+    for (int i = 0; i < 20; i++) {
+        timer_sleep_ns(1 * MS);
+        uint64_t t0 = rdtsc();
+        while (rdtsc() - t0 < timer_ns_to_tsc(MS / 2))
+            asm volatile ("pause");
+        scheduler_yield();
+    }
+    __atomic_fetch_add(&workers_done, 1, __ATOMIC_SEQ_CST);
+}
+
+static void trace_bench_task(void) {
+    trace_start();
+    uint64_t t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++)
+        trace_sched(TRACE_WAKEUP, i, 0);
+    report("enabled", rdtsc() - t0);
+
+    trace_stop();
+    t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++) {
+        trace_sched(TRACE_WAKEUP, i, 0);
+        asm volatile ("" ::: "memory");     /* keep the loop */
+    }
+    report("disabled", rdtsc() - t0);
+
+    /* Traced workload: three tasks sleeping, spinning and yielding */
+    trace_start();
+    for (int i = 0; i < 3; i++)
+        task_create(worker);
+    while (workers_done < 3)
+        timer_sleep_ns(5 * MS);
+    trace_stop();
+    trace_dump_serial();
+
+    serial_puts("[trace_bench] done\n");
+}
+
+void trace_bench(void) {
+    serial_puts("[trace_bench] creating measurement task\n");
+    task_create(trace_bench_task);
+}
@@ -0,0 +1,301 @@
+/* kernel/uring.c - batched syscall submission/completion rings */
+#include "uring.h"
+#include "elf_loader.h"
+#include "syscall.h"
+#include "mm/slab.h"
+#include "mm/page.h"
+#include "mm/pagetable.h"
+#include "mm/physical_memory.h"
+#include "drivers/serial.h"
+#include "arch/x86/cpu.h"
+#include "arch/x86/uaccess.h"
+#include <stddef.h>
+#ifdef HOST_TEST
+#include <stdlib.h>
+#endif
+
+#define URING_SQPOLL_SPINS 64      /* idle passes before the poller sleeps */
+
+typedef struct uring {
+    uring_shm_t *shm;
+    uring_sqe_t *sqes;
+    uring_cqe_t *cqes;
+    /* Kernel copies: the shared fields are writable by user space */
+    uint32_t sq_entries, cq_entries;
+    uint32_t sq_head, cq_tail;
+    uint64_t region, size;         /* kernel (identity) address of the frames */
+    int sqpoll;
+    volatile int dead;             /* owner exited: the poller frees the ring */
+    process_t *poller;
+} uring_t;
+
+static kmem_cache_t uring_cache = KMEM_CACHE_INIT("uring", sizeof(uring_t), 16);
+
+/* The ring lives in physically contiguous frames. The kernel works on it
+   through the identity map, never through the user mapping (SMAP);
+   user space sees the same frames at URING_VADDR, mapped U|W into its
+   own page table. The PTEs carry PTE_NOFORK: a fork child has no ring
+   and must not get the frames copy-on-write. Host tests have no user
+   page tables, so there both sides use the allocation itself. */
+static uint64_t region_alloc(uint64_t size) {
+#ifdef HOST_TEST
+    return (uint64_t)aligned_alloc(4096, size);
+#else
+    return alloc_frames((uint32_t)(size / PAGE_SIZE));
+#endif
+}
+
+static void region_free(uint64_t addr, uint64_t size) {
+#ifdef HOST_TEST
+    (void)size;
+    free((void *)addr);
+#else
+    for (uint64_t off = 0; off < size; off += PAGE_SIZE)
+        frame_decref((uint32_t)(addr + off));
+#endif
+}
+
+static void region_unmap(void *pml4, uint64_t size) {
+#ifdef HOST_TEST
+    (void)pml4; (void)size;
+#else
+    for (uint64_t off = 0; off < size; off += PAGE_SIZE)
+        pt_unmap_page(pml4, URING_VADDR + off);
+#endif
+}
+
+/* Map r's frames at URING_VADDR in p's address space; returns the user
+   address, 0 if p has none of its own or the window is taken (another
+   thread of p has a ring) */
+static uint64_t region_map(process_t *p, uring_t *r) {
+#ifdef HOST_TEST
+    (void)p;
+    return r->region;
+#else
+    void *pml4 = p->page_table;
+    if (!pml4 || pml4 == pt_get_kernel_pml4() || pt_virt_to_phys(pml4, URING_VADDR) != PT_NO_PHYS)
+        return 0;
+    for (uint64_t off = 0; off < r->size; off += PAGE_SIZE) {
+        if (pt_map_page(pml4, URING_VADDR + off, r->region + off, 0x7 | PTE_NOFORK) < 0) {
+            region_unmap(pml4, off);
+            return 0;
+        }
+    }
+    return URING_VADDR;
+#endif
+}
+
+static void uring_free(uring_t *r) {
+    region_free(r->region, r->size);
+    kmem_cache_free(&uring_cache, r);
+}
+
+#define URING_MSG_MAX 128          /* IPC messages bounce through the kernel stack */
+
+/* Run one operation. The entry was copied out of the shared SQ first, so
+   user space cannot change it underneath us. */
+static int64_t uring_do(const uring_sqe_t *e) {
+    extern int ipc_send(const char *s);
+    extern int ipc_recv(char *buf, int buflen);
+    char msg[URING_MSG_MAX];
+    int64_t n;
+    switch (e->opcode) {
+        case URING_OP_NOP:
+            return 0;
+        case URING_OP_READ:
+            return sys_read(e->fd, (void *)e->addr, (int)e->len);
+        case URING_OP_WRITE:
+            return sys_write(e->fd, (const void *)e->addr, (int)e->len);
+        case URING_OP_OPEN:
+            return sys_open((const char *)e->addr, (int)e->len);
+        case URING_OP_CLOSE:
+            return sys_close(e->fd);
+        case URING_OP_IPC_SEND:
+            n = strncpy_from_user(msg, (const char *)e->addr, sizeof(msg) - 1);
+            if (n < 0) return -1;
+            msg[n] = 0;
+            return ipc_send(msg);
+        case URING_OP_IPC_RECV:
+            n = e->len < sizeof(msg) ? e->len : sizeof(msg);
+            if (!n || !access_ok((void *)e->addr, (uint64_t)n) || ipc_recv(msg, (int)n) < 0)
+                return -1;
+            for (int64_t i = 0; i < n; i++) {
+                if (msg[i]) continue;
+                n = i + 1;
+                break;
+            }
+            return copy_to_user((void *)e->addr, msg, (uint64_t)n) ? -1 : 0;
+        default:
+            return -1;
+    }
+}
+
+/* Consume up to max SQ entries, stopping early when the CQ is full.
+   Indices are published once per batch. Returns entries consumed. */
+static uint32_t uring_submit(uring_t *r, uint32_t max) {
+    uring_shm_t *s = r->shm;
+    uint32_t tail = __atomic_load_n(&s->sq_tail, __ATOMIC_ACQUIRE);
+    uint32_t avail = tail - r->sq_head;
+    if (avail > r->sq_entries) avail = r->sq_entries;   /* bogus tail */
+    if (avail > max) avail = max;
+
+    uint32_t cq_head = __atomic_load_n(&s->cq_head, __ATOMIC_ACQUIRE);
+    uint32_t n = 0;
+    while (n < avail && r->cq_tail - cq_head < r->cq_entries) {
+        uring_sqe_t e = r->sqes[r->sq_head & (r->sq_entries - 1)];
+        uring_cqe_t *c = &r->cqes[r->cq_tail & (r->cq_entries - 1)];
+        c->user_data = e.user_data;
+        c->res = uring_do(&e);
+        r->sq_head++;
+        r->cq_tail++;
+        n++;
+    }
+    if (n) {
+        __atomic_store_n(&s->sq_head, r->sq_head, __ATOMIC_RELEASE);
+        __atomic_store_n(&s->cq_tail, r->cq_tail, __ATOMIC_RELEASE);
+    }
+    return n;
+}
+
+/* SQPOLL: one kernel task per ring. It adopts the owner's address space
+   (buffers in the entries are user pointers), consumes entries as they
+   appear and, after URING_SQPOLL_SPINS idle passes, sets NEED_WAKEUP and
+   sleeps until the owner calls enter(URING_ENTER_SQ_WAKEUP). */
+static uring_t *sqpoll_pending = NULL;
+static void *sqpoll_pending_pt = NULL;
+
+static void uring_sqpoll_task(void) {
+    extern process_t *pm_get_current(void);
+    extern void scheduler_yield(void);
+    process_t *self = pm_get_current();
+
+    uint64_t flags = irq_save();
+    uring_t *r = sqpoll_pending;
+    self->page_table = sqpoll_pending_pt;
+    sqpoll_pending = NULL;
+    r->poller = self;
+    irq_restore(flags);
+    scheduler_yield();              /* come back with the owner's CR3 */
+
+    int idle = 0;
+    while (!r->dead) {
+        if (uring_submit(r, r->sq_entries)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < URING_SQPOLL_SPINS) {
+            scheduler_yield();
+            continue;
+        }
+        flags = irq_save();
+        __atomic_or_fetch(&r->shm->sq_flags, URING_SQ_NEED_WAKEUP, __ATOMIC_SEQ_CST);
+        /* re-check after publishing the flag: a submission racing with it
+           either sees NEED_WAKEUP or is seen here */
+        if (__atomic_load_n(&r->shm->sq_tail, __ATOMIC_SEQ_CST) == r->sq_head && !r->dead) {
+            self->state = 2;
+            scheduler_yield();
+        }
+        __atomic_and_fetch(&r->shm->sq_flags, ~URING_SQ_NEED_WAKEUP, __ATOMIC_SEQ_CST);
+        irq_restore(flags);
+        idle = 0;
+    }
+    uring_free(r);
+}
+
+uint64_t uring_setup(process_t *p, uint32_t entries, uint32_t flags) {
+    if (p && !entries) {
+        uring_release(p);
+        return 0;
+    }
+    if (!p || p->uring || !entries || entries > URING_MAX_ENTRIES ||
+        (entries & (entries - 1)))
+        return 0;
+
+    uint32_t cq = entries * 2;
+    uint64_t sqes_off = sizeof(uring_shm_t);
+    uint64_t cqes_off = sqes_off + (uint64_t)entries * sizeof(uring_sqe_t);
+    uint64_t size = (cqes_off + (uint64_t)cq * sizeof(uring_cqe_t) + 0xFFF) & ~0xFFFULL;
+
+    uring_t *r = (uring_t *)kmem_cache_zalloc(&uring_cache);
+    if (!r) return 0;
+    r->region = region_alloc(size);
+    if (!r->region) {
+        kmem_cache_free(&uring_cache, r);
+        return 0;
+    }
+    r->size = size;
+    r->sq_entries = entries;
+    r->cq_entries = cq;
+    r->shm = (uring_shm_t *)r->region;
+    r->sqes = (uring_sqe_t *)(r->region + sqes_off);
+    r->cqes = (uring_cqe_t *)(r->region + cqes_off);
+
+    uint8_t *b = (uint8_t *)r->region;
+    for (uint64_t i = 0; i < size; i++) b[i] = 0;
+    r->shm->sq_entries = entries;
+    r->shm->cq_entries = cq;
+    r->shm->sqes_off = (uint32_t)sqes_off;
+    r->shm->cqes_off = (uint32_t)cqes_off;
+
+    uint64_t uaddr = region_map(p, r);
+    if (!uaddr) {
+        uring_free(r);
+        return 0;
+    }
+
+    if (flags & URING_SETUP_SQPOLL) {
+        extern int task_create(void (*entry)(void));
+        extern void scheduler_yield(void);
+        /* one hand-off slot: wait for a previous poller to pick its ring */
+        while (__atomic_load_n(&sqpoll_pending, __ATOMIC_SEQ_CST))
+            scheduler_yield();
+        r->sqpoll = 1;
+        sqpoll_pending_pt = p->page_table;
+        sqpoll_pending = r;
+        if (task_create(uring_sqpoll_task) < 0) {
+            sqpoll_pending = NULL;
+            region_unmap(p->page_table, size);
+            uring_free(r);
+            return 0;
+        }
+    }
+    p->uring = r;
+    return uaddr;
+}
+
+int64_t uring_enter(process_t *p, uint32_t to_submit, uint32_t flags) {
+    uring_t *r = p ? p->uring : NULL;
+    if (!r) return -1;
+    if (r->sqpoll) {
+        extern void sched_wake(process_t *p);
+        if ((flags & URING_ENTER_SQ_WAKEUP) && r->poller) {
+            uint64_t f = irq_save();
+            sched_wake(r->poller);
+            irq_restore(f);
+        }
+        return 0;
+    }
+    return uring_submit(r, to_submit);
+}
+
+void uring_release(process_t *p) {
+    uring_t *r = p ? p->uring : NULL;
+    if (!r) return;
+    p->uring = NULL;
+    region_unmap(p->page_table, r->size);
+    if (!r->sqpoll) {
+        uring_free(r);
+        return;
+    }
+    extern void sched_wake(process_t *p);
+    uint64_t f = irq_save();
+    r->dead = 1;
+    /* the owner's page table may be freed before the poller runs again */
+    if (r->poller) {
+        r->poller->page_table = pt_get_kernel_pml4();
+        sched_wake(r->poller);
+    } else if (sqpoll_pending == r) {
+        sqpoll_pending_pt = pt_get_kernel_pml4();
+    }
+    irq_restore(f);
+}
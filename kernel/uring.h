@@ -0,0 +1,95 @@
+/* kernel/uring.h
+ * Batched asynchronous syscalls (io_uring-style). A process sets up a
+ * region shared with the kernel holding a submission queue (SQ) of
+ * operations and a completion queue (CQ) of results. User space appends
+ * entries to the SQ and advances sq_tail; the kernel consumes them either
+ * on SYS_URING_ENTER (one ring transition for a whole batch) or from a
+ * per-ring polling kernel task (URING_SETUP_SQPOLL), which needs no
+ * syscall at all while it is awake. Each consumed entry posts one CQE
+ * carrying the entry's user_data and the operation's return value.
+ *
+ * Operations run inline when consumed and complete in submission order.
+ * The kernel stops consuming while the CQ is full, so completions are
+ * never lost; user space must drain the CQ to make progress.
+ *
+ * The layout below is shared with user space (user/libc/uring.h).
+ */
+
+#ifndef URING_H
+#define URING_H
+
+#include <stdint.h>
+
+/* Operations */
+#define URING_OP_NOP       0
+#define URING_OP_READ      1   /* fd, addr = buffer, len */
+#define URING_OP_WRITE     2   /* fd, addr = buffer, len */
+#define URING_OP_OPEN      3   /* addr = path, len = flags */
+#define URING_OP_CLOSE     4   /* fd */
+#define URING_OP_IPC_SEND  5   /* addr = NUL-terminated message */
+#define URING_OP_IPC_RECV  6   /* addr = buffer, len */
+
+/* SYS_URING_SETUP flags */
+#define URING_SETUP_SQPOLL   0x1
+
+/* SYS_URING_ENTER flags */
+#define URING_ENTER_SQ_WAKEUP 0x1  /* wake a sleeping SQPOLL task */
+
+/* uring_shm_t.sq_flags */
+#define URING_SQ_NEED_WAKEUP  0x1  /* SQPOLL task sleeps: enter(SQ_WAKEUP) */
+
+#define URING_MAX_ENTRIES 4096
+
+typedef struct uring_sqe {
+    uint8_t  opcode;
+    uint8_t  flags;
+    uint16_t reserved;
+    int32_t  fd;
+    uint64_t addr;
+    uint32_t len;
+    uint32_t reserved2;
+    uint64_t user_data;        /* returned untouched in the CQE */
+} uring_sqe_t;
+
+typedef struct uring_cqe {
+    uint64_t user_data;
+    int64_t  res;              /* return value of the operation */
+} uring_cqe_t;
+
+/* Head of the shared region. Each side only writes its own index; the
+   SQ and CQ indices live on separate cache lines. Entries follow at
+   sqes_off and cqes_off (bytes from the start of the region). */
+typedef struct uring_shm {
+    uint32_t sq_head;          /* written by the kernel */
+    uint32_t sq_tail;          /* written by user space */
+    uint32_t sq_entries;
+    uint32_t sq_flags;         /* URING_SQ_NEED_WAKEUP */
+    uint32_t sqes_off;
+    uint32_t pad0[11];
+    uint32_t cq_head;          /* written by user space */
+    uint32_t cq_tail;          /* written by the kernel */
+    uint32_t cq_entries;
+    uint32_t cqes_off;
+    uint32_t pad1[12];
+} uring_shm_t;
+
+struct process;
+
+/* User address of the shared region: a private mapping in the owner's
+   page table (PML4 slot 253, below the vDSO) */
+#define URING_VADDR 0x00007E8000000000ULL
+
+/* SYS_URING_SETUP: create p's ring with entries SQ slots (power of two,
+   CQ twice as large). Returns the user address of the shared region
+   (URING_VADDR), or 0 if p already has a ring, runs on the kernel page
+   table or memory is short. entries = 0 releases p's ring instead. */
+uint64_t uring_setup(struct process *p, uint32_t entries, uint32_t flags);
+
+/* SYS_URING_ENTER: consume up to to_submit entries of p's ring. Returns
+   how many were consumed, -1 without a ring. */
+int64_t uring_enter(struct process *p, uint32_t to_submit, uint32_t flags);
+
+/* Drop p's ring (process exit) */
+void uring_release(struct process *p);
+
+#endif /* URING_H */
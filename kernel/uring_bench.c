@@ -0,0 +1,29 @@
+/* kernel/uring_bench.c
+ * Batched syscall rings vs plain syscalls (build with -DRUN_URING_BENCH).
+ * Spawns user/uring_bench, which does 1-byte writes to an open file with
+ * one SYSCALL each, through a ring with one SYS_URING_ENTER per batch of
+ * 32, and through an SQPOLL ring, and logs ops/sec for each mode.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+#include "syscall.h"
+#include "user_uring_bench_bin.h"
+
+static void uring_bench_task(void) {
+    process_t *child = elf_spawn(build_user_uring_bench_elf,
+                                 build_user_uring_bench_elf_len, pm_get_current());
+    if (!child) {
+        serial_puts("[uring_bench] cannot spawn user/uring_bench\n");
+        return;
+    }
+    sys_wait((int)child->pid);
+    serial_puts("[uring_bench] done\n");
+}
+
+void uring_bench(void) {
+    serial_puts("[uring_bench] creating benchmark task\n");
+    task_create(uring_bench_task);
+}
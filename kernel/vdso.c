@@ -0,0 +1,113 @@
+/* kernel/vdso.c - vDSO setup, clock rebase and per-process mapping */
+#include "vdso.h"
+#include "drivers/timer.h"
+#include "drivers/serial.h"
+#include "mm/pagetable.h"
+#include "arch/x86/cpu.h"
+
+#define MSR_TSC_AUX 0xC0000103
+#define VDSO_SHIFT  32
+
+extern vdso_data_t vdso_page;       /* vdso_text.c, first page of .vdso */
+
+#ifdef HOST_TEST
+#define VDSO_IMAGE_START ((uint64_t)&vdso_page)
+#define VDSO_IMAGE_END   (VDSO_IMAGE_START + 4096)
+#else
+extern char __vdso_start[], __vdso_end[];   /* linker.ld */
+#define VDSO_IMAGE_START ((uint64_t)__vdso_start)
+#define VDSO_IMAGE_END   ((uint64_t)__vdso_end)
+#endif
+
+static timer_event_t rebase_event;
+
+const vdso_data_t *vdso_get_data(void) { return &vdso_page; }
+
+/* Writer side of the seqlock: readers never block us, they retry */
+static void vdso_rebase(uint64_t tsc) {
+    vdso_data_t *d = &vdso_page;
+    uint64_t hz = timer_tsc_hz();
+    uint64_t flags = irq_save();
+
+    __atomic_store_n(&d->seq, d->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    d->tsc_base = tsc;
+    d->ns_base = timer_tsc_to_ns(tsc);
+    d->mult = hz ? (1000000000ULL << VDSO_SHIFT) / hz : 0;
+    d->shift = VDSO_SHIFT;
+    d->tsc_hz = hz;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&d->seq, d->seq + 1, __ATOMIC_RELAXED);
+
+    irq_restore(flags);
+}
+
+void vdso_update(void) {
+    vdso_rebase(rdtsc());
+}
+
+/* Rebasing bounds the truncation error of mult (well under 1 ns/s) and
+   only ever moves the clock forward, since mult rounds down */
+static void rebase_fire(void *arg) {
+    (void)arg;
+    uint64_t now = rdtsc();
+    vdso_rebase(now);
+    timer_add(&rebase_event, now + timer_ns_to_tsc(VDSO_UPDATE_NS), rebase_fire, 0);
+}
+
+void vdso_init(void) {
+    vdso_data_t *d = &vdso_page;
+    uint32_t a, b, c, dx;
+
+    d->cpu = 0;
+    d->cpu_mode = VDSO_CPU_PAGE;
+    cpuid(0x80000000, 0, &a, &b, &c, &dx);
+    int has_rdtscp = 0, has_rdpid = 0;
+    if (a >= 0x80000001) {
+        cpuid(0x80000001, 0, &a, &b, &c, &dx);
+        has_rdtscp = (dx >> 27) & 1;
+    }
+    cpuid(0, 0, &a, &b, &c, &dx);
+    if (a >= 7) {
+        cpuid(7, 0, &a, &b, &c, &dx);
+        has_rdpid = (c >> 22) & 1;
+    }
+    if (has_rdtscp || has_rdpid) {
+        extern int sched_cpu_id(void);
+#ifndef HOST_TEST
+        wrmsr(MSR_TSC_AUX, (uint64_t)sched_cpu_id());
+#endif
+        d->cpu_mode = has_rdpid ? VDSO_CPU_RDPID : VDSO_CPU_RDTSCP;
+    }
+
+    d->clock_gettime_off = (uint32_t)((uint64_t)vdso_clock_gettime - VDSO_IMAGE_START);
+    d->time_ns_off = (uint32_t)((uint64_t)vdso_time_ns - VDSO_IMAGE_START);
+    d->getcpu_off = (uint32_t)((uint64_t)vdso_getcpu - VDSO_IMAGE_START);
+    /* no RTC driver yet: the real-time clock counts from boot */
+    d->realtime_off = 0;
+
+    rebase_fire(0);
+
+    static const char *modes[] = { "page", "rdtscp", "rdpid" };
+    serial_puts("[vdso] mapped at 0x");
+    serial_put_hex(VDSO_BASE);
+    serial_puts(" pages=");
+    serial_put_dec((VDSO_IMAGE_END - VDSO_IMAGE_START) / 4096);
+    serial_puts(" getcpu=");
+    serial_puts(modes[d->cpu_mode]);
+    serial_putc('\n');
+}
+
+int vdso_contains(uint64_t vaddr) {
+    return vaddr >= VDSO_BASE && vaddr < VDSO_BASE + (VDSO_IMAGE_END - VDSO_IMAGE_START);
+}
+
+int vdso_map(void *pml4) {
+    if (!pml4) return -1;
+    for (uint64_t off = 0; VDSO_IMAGE_START + off < VDSO_IMAGE_END; off += 4096) {
+        /* present | user, read-only */
+        if (pt_map_page(pml4, VDSO_BASE + off, VDSO_IMAGE_START + off, 0x4) < 0)
+            return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+/* kernel/vdso.h
+ * vDSO: a page of clock data plus the code that reads it, mapped
+ * read-only at VDSO_BASE into every process the ELF loader builds. User
+ * space reads the monotonic/real-time clock and its CPU number straight
+ * from there instead of entering the kernel.
+ *
+ * The data page comes first, the code right after it. The code is built
+ * position-independent (vdso_text.c), so it runs the same at its kernel
+ * address and at VDSO_BASE. Entry points are published as offsets from
+ * VDSO_BASE in the data page.
+ *
+ * The kernel rebases the clock every VDSO_UPDATE_NS under a sequence
+ * counter: readers retry while seq is odd or changed during the read.
+ *
+ * The layout below is shared with user space (user/libc/vdso.h).
+ */
+
+#ifndef VDSO_H
+#define VDSO_H
+
+#include <stdint.h>
+
+#define VDSO_BASE        0x00007F0000000000ULL   /* PML4 slot 254 */
+#define VDSO_UPDATE_NS   1000000000ULL
+
+#define CLOCK_REALTIME   0
+#define CLOCK_MONOTONIC  1
+
+/* How vdso_getcpu finds the CPU number */
+#define VDSO_CPU_PAGE    0   /* vdso_data_t.cpu (single CPU) */
+#define VDSO_CPU_RDTSCP  1   /* IA32_TSC_AUX via RDTSCP */
+#define VDSO_CPU_RDPID   2   /* IA32_TSC_AUX via RDPID */
+
+typedef struct vdso_timespec {
+    int64_t tv_sec;
+    int64_t tv_nsec;
+} vdso_timespec_t;
+
+typedef struct vdso_data {
+    uint32_t seq;              /* odd while the kernel rewrites the page */
+    uint32_t cpu_mode;         /* VDSO_CPU_* */
+    uint64_t tsc_base;         /* TSC at the last rebase */
+    uint64_t ns_base;          /* CLOCK_MONOTONIC at tsc_base */
+    uint64_t realtime_off;     /* CLOCK_REALTIME - CLOCK_MONOTONIC, in ns */
+    uint64_t mult;             /* ns = ns_base + ((tsc - tsc_base) * mult >> shift) */
+    uint32_t shift;
+    uint32_t cpu;
+    uint64_t tsc_hz;           /* 0 until the TSC is calibrated */
+    /* Entry points, bytes from VDSO_BASE (0 = not available) */
+    uint32_t clock_gettime_off;   /* int (int clk, vdso_timespec_t *ts) */
+    uint32_t time_ns_off;         /* uint64_t (int clk), 0 on error */
+    uint32_t getcpu_off;          /* int (uint32_t *cpu, uint32_t *node) */
+    uint32_t pad;
+} vdso_data_t;
+
+/* Code run from VDSO_BASE (vdso_text.c). They return -1 / 0 when the
+   clock is not calibrated or clk is unknown; callers then fall back to
+   SYS_CLOCK_GETTIME. */
+int vdso_clock_gettime(int clk, vdso_timespec_t *ts);
+uint64_t vdso_time_ns(int clk);
+int vdso_getcpu(uint32_t *cpu, uint32_t *node);
+
+/* Fill the data page from the calibrated TSC, program IA32_TSC_AUX and
+   start the periodic rebase (after timer_install) */
+void vdso_init(void);
+
+/* Rebase the clock at the current TSC */
+void vdso_update(void);
+
+/* Map the vDSO at VDSO_BASE in a process PML4 (read-only, user) */
+int vdso_map(void *pml4);
+
+/* vaddr lies in a process's vDSO mapping */
+int vdso_contains(uint64_t vaddr);
+
+/* The kernel's view of the data page */
+const vdso_data_t *vdso_get_data(void);
+
+#endif /* VDSO_H */
@@ -0,0 +1,42 @@
+/* kernel/vdso_bench.c
+ * Clock reads from ring 3 with and without entering the kernel (build with
+ * -DRUN_VDSO_BENCH). Spawns user/vdso_bench, which times clock_gettime
+ * through the vDSO and through SYS_CLOCK_GETTIME and returns cycles per
+ * call for both in its exit code; this task converts them to ns.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "drivers/timer.h"
+#include "process_manager.h"
+#include "scheduler/preemptive.h"
+#include "syscall.h"
+#include "user_vdso_bench_bin.h"
+
+static void report(const char *name, uint64_t cycles) {
+    serial_puts("[vdso_bench] ");
+    serial_puts(name);
+    serial_puts(": cycles=");
+    serial_put_dec(cycles);
+    serial_puts(" ns=");
+    serial_put_dec(timer_tsc_to_ns(cycles));
+    serial_putc('\n');
+}
+
+static void vdso_bench_task(void) {
+    process_t *child = elf_spawn(build_user_vdso_bench_elf,
+                                 build_user_vdso_bench_elf_len, pm_get_current());
+    if (!child) {
+        serial_puts("[vdso_bench] cannot spawn user/vdso_bench\n");
+        return;
+    }
+    uint64_t code = (uint64_t)sys_wait((int)child->pid);
+    report("vdso clock_gettime", code & 0xFFFF);
+    report("syscall clock_gettime", (code >> 16) & 0xFFFF);
+    serial_puts("[vdso_bench] done\n");
+}
+
+void vdso_bench(void) {
+    serial_puts("[vdso_bench] creating benchmark task\n");
+    task_create(vdso_bench_task);
+}
@@ -0,0 +1,84 @@
+/* kernel/vdso_text.c - vDSO code, executed in ring 3 at VDSO_BASE
+ *
+ * Built with -fpic (see Makefile) and linked into the page-aligned .vdso
+ * section together with the data page, so every access to vdso_page is
+ * RIP-relative and works at either mapping. Nothing here may call into
+ * the rest of the kernel or use its data.
+ */
+#include "vdso.h"
+
+/* Hidden: a default-visibility symbol would be reached through the GOT */
+__attribute__((section(".vdso.data"), aligned(4096), visibility("hidden")))
+vdso_data_t vdso_page;
+
+#ifdef HOST_TEST
+extern uint64_t host_tsc;
+extern uint32_t host_tsc_aux;
+static inline uint64_t vdso_rdtsc(void) { return host_tsc; }
+static inline uint32_t vdso_rdtscp_aux(void) { return host_tsc_aux; }
+static inline uint32_t vdso_rdpid(void) { return host_tsc_aux; }
+#else
+static inline uint64_t vdso_rdtsc(void) {
+    uint32_t lo, hi;
+    /* lfence: do not let the read float above the seq load */
+    asm volatile ("lfence; rdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline uint32_t vdso_rdtscp_aux(void) {
+    uint32_t lo, hi, aux;
+    asm volatile ("rdtscp" : "=a"(lo), "=d"(hi), "=c"(aux));
+    return aux;
+}
+
+static inline uint32_t vdso_rdpid(void) {
+    uint64_t aux;
+    asm volatile ("rdpid %0" : "=r"(aux));
+    return (uint32_t)aux;
+}
+#endif
+
+/* Seqlock read of the clock. Returns 0 if not calibrated or clk unknown. */
+static inline uint64_t vdso_read_ns(int clk) {
+    volatile vdso_data_t *d = &vdso_page;
+    uint32_t seq;
+    uint64_t ns;
+    do {
+        seq = __atomic_load_n(&d->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            asm volatile ("pause");
+            continue;
+        }
+        if (!d->tsc_hz) return 0;
+        uint64_t delta = vdso_rdtsc() - d->tsc_base;
+        ns = d->ns_base + (uint64_t)(((unsigned __int128)delta * d->mult) >> d->shift);
+        if (clk == CLOCK_REALTIME) ns += d->realtime_off;
+        else if (clk != CLOCK_MONOTONIC) return 0;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || __atomic_load_n(&d->seq, __ATOMIC_RELAXED) != seq);
+    return ns;
+}
+
+int vdso_clock_gettime(int clk, vdso_timespec_t *ts) {
+    uint64_t ns = vdso_read_ns(clk);
+    if (!ns) return -1;
+    ts->tv_sec = (int64_t)(ns / 1000000000ULL);
+    ts->tv_nsec = (int64_t)(ns % 1000000000ULL);
+    return 0;
+}
+
+uint64_t vdso_time_ns(int clk) {
+    return vdso_read_ns(clk);
+}
+
+int vdso_getcpu(uint32_t *cpu, uint32_t *node) {
+    uint32_t c;
+    switch (vdso_page.cpu_mode) {
+        case VDSO_CPU_RDPID:  c = vdso_rdpid() & 0xFFF; break;
+        case VDSO_CPU_RDTSCP: c = vdso_rdtscp_aux() & 0xFFF; break;
+        default:              c = vdso_page.cpu; break;
+    }
+    if (cpu) *cpu = c;
+    if (node) *node = 0;
+    return 0;
+}
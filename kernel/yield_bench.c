@@ -0,0 +1,83 @@
+/* kernel/yield_bench.c
+ * Ping-pong latency benchmark for sys_yield (build with -DRUN_YIELD_BENCH).
+ * Two kernel tasks bounce a token back and forth; each round trip is two
+ * context switches. The same exchange is then repeated without yielding so
+ * the hand-off only happens on a PIT preemption, for comparison.
+ */
+
+#include <stdint.h>
+#include "drivers/serial.h"
+#include "arch/x86/cpu.h"
+#include "scheduler/preemptive.h"
+
+#define YIELD_ROUNDS 10000
+#define TICK_ROUNDS  20
+
+static volatile int turn = 0;     /* 0 = ping's turn, 1 = pong's turn */
+static volatile int use_yield = 1;
+static volatile int bench_done = 0;
+
+static void report(const char *name, uint64_t rounds, uint64_t total,
+                   uint64_t min, uint64_t max) {
+    serial_puts("[yield_bench] ");
+    serial_puts(name);
+    serial_puts(": rounds=");
+    serial_put_dec(rounds);
+    serial_puts(" avg_cycles=");
+    serial_put_dec(total / rounds);
+    serial_puts(" min=");
+    serial_put_dec(min);
+    serial_puts(" max=");
+    serial_put_dec(max);
+    serial_puts(" per_switch=");
+    serial_put_dec(total / rounds / 2);
+    serial_putc('\n');
+}
+
+static uint64_t run_rounds(int rounds, uint64_t *min, uint64_t *max) {
+    uint64_t total = 0;
+    *min = ~0ULL;
+    *max = 0;
+    for (int i = 0; i < rounds; i++) {
+        uint64_t t0 = rdtsc();
+        turn = 1;
+        while (turn != 0) {
+            if (use_yield) scheduler_yield();
+        }
+        uint64_t dt = rdtsc() - t0;
+        total += dt;
+        if (dt < *min) *min = dt;
+        if (dt > *max) *max = dt;
+    }
+    return total;
+}
+
+static void ping_task(void) {
+    uint64_t min, max, total;
+
+    use_yield = 1;
+    total = run_rounds(YIELD_ROUNDS, &min, &max);
+    report("yield ping-pong", YIELD_ROUNDS, total, min, max);
+
+    use_yield = 0;
+    total = run_rounds(TICK_ROUNDS, &min, &max);
+    report("timer-tick ping-pong", TICK_ROUNDS, total, min, max);
+
+    bench_done = 1;
+    serial_puts("[yield_bench] done\n");
+}
+
+static void pong_task(void) {
+    while (!bench_done) {
+        while (turn != 1 && !bench_done) {
+            if (use_yield) scheduler_yield();
+        }
+        turn = 0;
+    }
+}
+
+void yield_bench(void) {
+    serial_puts("[yield_bench] creating ping/pong tasks\n");
+    task_create(ping_task);
+    task_create(pong_task);
+}
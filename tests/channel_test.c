@@ -0,0 +1,126 @@
+/* tests/channel_test.c - host-side test for the SPSC and MPMC channels
+   (kernel/ipc/channel.c): named lookup, bad opens, FIFO across many
+   wraps, every message length, full and empty rings, truncated
+   receives, partial batches and a blocking receive fed by another
+   thread. */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#define HOST_TEST
+
+#include "../kernel/ipc/channel.c"
+
+static int fail(const char *what) {
+    printf("FAIL: %s\n", what);
+    return 1;
+}
+
+/* fill and drain a ring of 8 a thousand times: every cell goes round
+   with its turn numbers and the masked indices wrapping */
+static int fifo_laps(ipc_chan_t *ch) {
+    uint32_t next_in = 0, next_out = 0, v;
+    for (int lap = 0; lap < 1000; lap++) {
+        while (ipc_chan_send(ch, &next_in, sizeof(next_in)) == 0) next_in++;
+        if (next_in - next_out != 8) return -1;
+        while (ipc_chan_recv(ch, &v, sizeof(v), IPC_NONBLOCK) == sizeof(v)) {
+            if (v != next_out++) return -1;
+        }
+        if (next_out != next_in) return -1;
+    }
+    return 0;
+}
+
+/* each length from 0 to IPC_MSG_SIZE arrives intact, with nothing
+   written past its end */
+static int lengths(ipc_chan_t *ch) {
+    char out[IPC_MSG_SIZE], in[IPC_MSG_SIZE + 8];
+    for (uint32_t n = 0; n <= IPC_MSG_SIZE; n++) {
+        for (uint32_t i = 0; i < n; i++) out[i] = (char)(n + i * 3 + 1);
+        memset(in, 0x5A, sizeof(in));
+        if (ipc_chan_send(ch, out, n) != 0 || ipc_chan_recv(ch, in, sizeof(in), IPC_NONBLOCK) != (int)n ||
+            memcmp(in, out, n))
+            return -1;
+        for (uint32_t i = n; i < sizeof(in); i++)
+            if (in[i] != 0x5A) return -1;
+    }
+    return 0;
+}
+
+static int batches(ipc_chan_t *ch) {
+    ipc_msg_t out[12], in[12];
+    for (int i = 0; i < 12; i++) {
+        out[i].len = (uint32_t)i + 1;
+        memset(out[i].data, 'a' + i, sizeof(out[i].data));
+    }
+    /* 8 cells: the first 8 go in, the rest are left for the caller */
+    if (ipc_chan_send_batch(ch, out, 12) != 8 || ipc_chan_send_batch(ch, out, 1) != 0) return -1;
+    if (ipc_chan_recv_batch(ch, in, 3, IPC_NONBLOCK) != 3) return -1;
+    if (ipc_chan_send_batch(ch, out + 8, 4) != 3) return -1;
+    int got = 3 + ipc_chan_recv_batch(ch, in + 3, 12, 0);
+    if (got != 11 || ipc_chan_recv_batch(ch, in, 12, IPC_NONBLOCK) != 0) return -1;
+    for (int i = 0; i < 11; i++)
+        if (in[i].len != out[i].len || in[i].data[0] != 'a' + i || in[i].data[in[i].len - 1] != 'a' + i) return -1;
+    /* a batch stops in front of an oversized message */
+    out[2].len = IPC_MSG_SIZE + 1;
+    if (ipc_chan_send_batch(ch, out, 4) != 2 || ipc_chan_recv_batch(ch, in, 12, IPC_NONBLOCK) != 2) return -1;
+    return 0;
+}
+
+static ipc_chan_t *late;
+
+static void *late_sender(void *arg) {
+    (void)arg;
+    struct timespec ts = { 0, 20 * 1000 * 1000 };
+    nanosleep(&ts, NULL);
+    ipc_chan_send(late, "late", 4);
+    return NULL;
+}
+
+int main(void) {
+    ipc_chan_t *s = ipc_chan_open("spsc", IPC_CHAN_SPSC, 5);     /* rounded to 8 */
+    ipc_chan_t *m = ipc_chan_open("mpmc", IPC_CHAN_MPMC, 8);
+    if (!s || !m || s->mask != 7 || m->mask != 7) return fail("open");
+    if (ipc_chan_open("spsc", IPC_CHAN_SPSC, 64) != s || ipc_chan_find("mpmc") != m || ipc_chan_find("none"))
+        return fail("lookup by name");
+    if (ipc_chan_open("spsc", IPC_CHAN_MPMC, 8) || ipc_chan_open("", IPC_CHAN_MPMC, 8) ||
+        ipc_chan_open("x", 7, 8) || ipc_chan_open("x", IPC_CHAN_MPMC, 0) ||
+        ipc_chan_open("x", IPC_CHAN_MPMC, IPC_CHAN_CELLS + 1))
+        return fail("a bad open succeeded");
+    if ((uintptr_t)&s->head - (uintptr_t)&s->tail < 64) return fail("indices share a cache line");
+
+    char buf[IPC_MSG_SIZE + 8];
+    char big[IPC_MSG_SIZE + 1];
+    memset(big, 'x', sizeof(big));
+    ipc_chan_t *both[2] = { s, m };
+    for (int c = 0; c < 2; c++) {
+        ipc_chan_t *ch = both[c];
+        if (ipc_chan_recv(ch, buf, sizeof(buf), IPC_NONBLOCK) != -1) return fail("receive from an empty ring");
+        if (ipc_chan_send(ch, big, sizeof(big)) != -1) return fail("oversized send");
+        if (fifo_laps(ch) < 0) return fail(c ? "mpmc FIFO" : "spsc FIFO");
+        if (lengths(ch) < 0) return fail(c ? "mpmc message lengths" : "spsc message lengths");
+        /* a short buffer gets the head of the message and its full length */
+        if (ipc_chan_send(ch, "truncated", 9) != 0 || ipc_chan_send(ch, "", 0) != 0 ||
+            ipc_chan_recv(ch, buf, 4, IPC_NONBLOCK) != 9 || memcmp(buf, "trun", 4) ||
+            ipc_chan_recv(ch, buf, sizeof(buf), 0) != 0)
+            return fail("truncated or empty message");
+        if (batches(ch) < 0) return fail(c ? "mpmc batches" : "spsc batches");
+    }
+
+    /* the cell arena runs out cleanly */
+    if (!ipc_chan_open("half", IPC_CHAN_MPMC, IPC_CHAN_CELLS / 2) ||
+        ipc_chan_open("more", IPC_CHAN_MPMC, IPC_CHAN_CELLS / 2) || ipc_chan_find("more"))
+        return fail("cell arena");
+
+    /* a receiver with nothing to read waits for the sender */
+    late = m;
+    pthread_t t;
+    pthread_create(&t, NULL, late_sender, NULL);
+    int n = ipc_chan_recv(m, buf, sizeof(buf), 0);
+    pthread_join(t, NULL);
+    if (n != 4 || memcmp(buf, "late", 4) || m->nwaiters) return fail("blocking receive");
+
+    printf("PASS: named SPSC/MPMC channels, FIFO over wraps, all lengths, full/empty rings, batches, blocking receive\n");
+    return 0;
+}
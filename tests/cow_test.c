@@ -6,8 +6,13 @@
 
 #include "../kernel/mm/virtual_memory.c"
 #include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
 #include "../kernel/mm/pagetable.c"
 #include "../kernel/scheduler/preemptive.c"
+#include "../kernel/scheduler/deadline.c"
+#include "../kernel/trace.c"
 
 void serial_puts(const char *s) { if (s) printf("%s", s); }
 void serial_putc(char c) { putchar(c); }
@@ -15,7 +20,17 @@ void serial_put_hex(uint64_t v) { printf("%llx", (unsigned long long)v); }
 
 /* Host stubs for scheduler/hardware interactions */
 void enable_interrupts(void) { }
-void pic_send_eoi(int irq) { (void)irq; }
+int timer_interrupt(void) { return 1; } /* every tick ends the slice */
+void timer_sched_update(int nr_runnable) { (void)nr_runnable; }
+/* Deadline-class timers are not exercised here */
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    (void)ev; (void)deadline; (void)fn; (void)arg;
+    return 0;
+}
+void timer_cancel(timer_event_t *ev) { (void)ev; }
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns; }
+uint64_t timer_tsc_hz(void) { return 1000000000ULL; }
+void serial_put_dec(uint64_t v) { printf("%llu", (unsigned long long)v); }
 
 int main(void) {
     /* Allocate a region (parent) */
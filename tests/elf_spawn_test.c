@@ -0,0 +1,203 @@
+/* tests/elf_spawn_test.c - host-side test for elf_load/elf_spawn
+   (kernel/elf_loader.c) on an emulated boot identity map: the parent's
+   own image at the segment addresses stays intact, so it keeps running
+   after spawning; each child gets private frames holding its segments
+   (text, data sharing a page with it, zeroed BSS) and a private user
+   stack while the rest of the identity map stays visible; the kernel
+   tables are not touched; reaping returns the frames; a truncated image
+   leaks nothing. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define HOST_TEST
+
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/elf_loader.c"
+
+#define TEXT_VA   0x400000ULL
+#define TEXT_SZ   0x1800ULL                     /* ends inside the second page */
+#define DATA_VA   (TEXT_VA + TEXT_SZ)
+#define DATA_SZ   0x100ULL
+#define DATA_MEM  0x2000ULL                     /* BSS runs on into a third page */
+#define ARENA     (128ULL * 1024 * 1024)         /* every frame the allocator hands out */
+
+/* physical memory */
+static uint8_t *arena;
+void *host_phys_to_virt(uint64_t pa) { return arena + pa; }
+
+void *kmalloc(unsigned int size) { return malloc(size); }
+void clear_page(void *dst) { memset(dst, 0, PAGE_SIZE); }
+int vdso_map(void *pml4) { (void)pml4; return 0; }
+volatile int trace_enabled;
+void trace_record(int type, uint64_t pid, uint64_t arg) { (void)type; (void)pid; (void)arg; }
+void sched_forget_mm(void *pml4) { (void)pml4; }
+
+/* process manager and scheduler */
+static uint64_t next_pid = 1;
+static int started;
+process_t *pm_alloc_process(void) {
+    process_t *p = calloc(1, sizeof(*p));
+    if (p) p->flags = PF_SLAB;
+    return p;
+}
+void pm_free_process(process_t *p) { free(p); }
+uint64_t pm_register_process(process_t *p) {
+    p->pid = next_pid++;
+    p->page_table = pt_get_kernel_pml4();
+    for (int i = 0; i < 16; i++) p->fds[i] = -1;
+    return p->pid;
+}
+void pm_reap(process_t *p) {
+    elf_free_process(p);
+    free(p);
+}
+static uint64_t start_sp;
+int task_start_user(process_t *p, uint64_t user_sp) {
+    (void)p;
+    start_sp = user_sp;
+    started++;
+    return 0;
+}
+
+static struct {
+    elf64_hdr_t h;
+    elf64_phdr_t ph[2];
+    uint8_t text[TEXT_SZ];
+    uint8_t data[DATA_SZ];
+} image;
+
+static void build_image(void) {
+    memcpy(image.h.e_ident, "\x7f" "ELF", 4);
+    image.h.e_ident[EI_CLASS] = ELFCLASS64;
+    image.h.e_ident[EI_DATA] = ELFDATA2LSB;
+    image.h.e_type = ET_EXEC;
+    image.h.e_entry = TEXT_VA;
+    image.h.e_phoff = offsetof(typeof(image), ph);
+    image.h.e_phentsize = sizeof(elf64_phdr_t);
+    image.h.e_phnum = 2;
+    image.ph[0] = (elf64_phdr_t){ PT_LOAD, 0x5, offsetof(typeof(image), text), TEXT_VA, TEXT_VA,
+                                  TEXT_SZ, TEXT_SZ, 0x1000 };
+    image.ph[1] = (elf64_phdr_t){ PT_LOAD, 0x6, offsetof(typeof(image), data), DATA_VA, DATA_VA,
+                                  DATA_SZ, DATA_MEM, 0x1000 };
+    for (uint64_t i = 0; i < TEXT_SZ; i++) image.text[i] = (uint8_t)(i * 7 + 1);
+    memset(image.data, 0xDA, DATA_SZ);
+}
+
+/* start.S: PML4[0] -> PDPT[0] -> one PD of 512 2 MiB supervisor pages */
+static uint64_t *boot_pd;
+static void boot_identity_map(void) {
+    uint64_t *pdpt = aligned_alloc(4096, 4096);
+    boot_pd = aligned_alloc(4096, 4096);
+    memset(pdpt, 0, 4096);
+    for (int i = 0; i < 512; i++) boot_pd[i] = ((uint64_t)i << 21) | 0x83;
+    pdpt[0] = (uint64_t)boot_pd | 0x3;
+    host_pml4[0] = (uint64_t)pdpt | 0x3;
+}
+
+/* ring 3 can reach va: U set at every level of the walk */
+static int user_ok(void *pml4, uint64_t va) {
+    uint64_t *t = pml4;
+    for (int shift = 39; shift >= 12; shift -= 9) {
+        uint64_t e = t[(va >> shift) & 0x1FF];
+        if ((e & 0x5) != 0x5) return 0;
+        if (shift == 12 || (e & 0x80)) return 1;
+        t = (uint64_t *)(e & PT_ADDR_MASK);
+    }
+    return 1;
+}
+
+static uint8_t *at(void *pml4, uint64_t va) {
+    uint64_t pa = pt_virt_to_phys(pml4, va);
+    return pa == PT_NO_PHYS ? NULL : (uint8_t *)host_phys_to_virt(pa);
+}
+
+static int fail(const char *what) {
+    printf("FAIL: %s\n", what);
+    return 1;
+}
+
+int main(void) {
+    arena = calloc(1, ARENA);
+    physical_memory_init();
+    boot_identity_map();
+    build_image();
+
+    /* the parent runs from the identity map at the very addresses the
+       child is linked at */
+    void *kpml4 = pt_get_kernel_pml4();
+    process_t parent = { .page_table = kpml4 };
+    for (int i = 0; i < 16; i++) parent.fds[i] = -1;
+    memset(arena + TEXT_VA, 0xCC, 4 * PAGE_SIZE);
+
+    uint32_t free_before = first_free_frame();
+    process_t *a = elf_spawn((const uint8_t *)&image, sizeof(image), &parent);
+    process_t *b = elf_spawn((const uint8_t *)&image, sizeof(image), &parent);
+    if (!a || !b || started != 2 || !(a->flags & PF_IMAGE) || start_sp != USER_STACK_TOP)
+        return fail("spawn");
+
+    /* the parent's code is still its own */
+    for (uint64_t off = 0; off < 4 * PAGE_SIZE; off++)
+        if (at(kpml4, TEXT_VA + off) != arena + TEXT_VA + off || arena[TEXT_VA + off] != 0xCC)
+            return fail("spawn overwrote the parent's image");
+    if (boot_pd[TEXT_VA >> 21] != (TEXT_VA | 0x83)) return fail("kernel page directory changed");
+
+    /* children: private frames with text, data and zeroed BSS */
+    process_t *kids[2] = { a, b };
+    for (int k = 0; k < 2; k++) {
+        void *pml4 = kids[k]->page_table;
+        if (pml4 == kpml4 || (uint64_t)pml4 & 0xFFF) return fail("child has no page table of its own");
+        for (uint64_t off = 0; off < TEXT_SZ; off++)
+            if (!user_ok(pml4, TEXT_VA + off) || *at(pml4, TEXT_VA + off) != image.text[off])
+                return fail("child text");
+        for (uint64_t off = 0; off < DATA_MEM; off++)
+            if (*at(pml4, DATA_VA + off) != (off < DATA_SZ ? 0xDA : 0))
+                return fail("child data or BSS");
+        for (uint64_t va = TEXT_VA; va < DATA_VA + DATA_MEM; va += PAGE_SIZE) {
+            uint64_t pa = pt_virt_to_phys(pml4, va);
+            if (pa < FRAME_POOL_START || pa == va) return fail("segment page not in a private frame");
+        }
+        /* text alone is read-only; the page text shares with data is not */
+        if ((*pt_find_pte_for_vaddr(pml4, TEXT_VA) & 0x2) ||
+            !(*pt_find_pte_for_vaddr(pml4, DATA_VA) & 0x2))
+            return fail("segment permissions");
+        /* the rest of the identity map is untouched, also next to the segments */
+        if (pt_virt_to_phys(pml4, TEXT_VA - PAGE_SIZE) != TEXT_VA - PAGE_SIZE ||
+            pt_virt_to_phys(pml4, DATA_VA + DATA_MEM + PAGE_SIZE) != DATA_VA + DATA_MEM + PAGE_SIZE ||
+            pt_virt_to_phys(pml4, 0x100000) != 0x100000 || pt_virt_to_phys(pml4, 0x3FF00000) != 0x3FF00000)
+            return fail("identity map lost in the child");
+        /* and stays out of ring 3's reach */
+        if (user_ok(pml4, TEXT_VA - PAGE_SIZE) || user_ok(pml4, DATA_VA + DATA_MEM + PAGE_SIZE) ||
+            user_ok(pml4, 0x100000))
+            return fail("kernel memory user-accessible in the child");
+        /* a zeroed, writable user stack of its own */
+        for (uint64_t va = USER_STACK_TOP - USER_STACK_SIZE; va < USER_STACK_TOP; va += PAGE_SIZE) {
+            uint64_t *pte = pt_find_pte_for_vaddr(pml4, va);
+            if (!pte || !user_ok(pml4, va) || !(*pte & 0x2) || (*pte & PT_ADDR_MASK) < FRAME_POOL_START ||
+                *at(pml4, va) || *at(pml4, va + PAGE_SIZE - 1))
+                return fail("child user stack");
+        }
+    }
+    if (pt_virt_to_phys(a->page_table, USER_STACK_TOP - 8) == pt_virt_to_phys(b->page_table, USER_STACK_TOP - 8))
+        return fail("children share a stack");
+    if (pt_virt_to_phys(a->page_table, TEXT_VA) == pt_virt_to_phys(b->page_table, TEXT_VA))
+        return fail("children share a frame");
+
+    /* a child writing its data leaves the parent and its sibling alone */
+    *at(a->page_table, DATA_VA) = 0x11;
+    if (*at(b->page_table, DATA_VA) != 0xDA || arena[DATA_VA] != 0xCC) return fail("data write leaked");
+
+    /* reaping hands the frames back */
+    uint32_t fa = (uint32_t)pt_virt_to_phys(a->page_table, TEXT_VA);
+    pm_reap(a);
+    pm_reap(b);
+    if (frame_refcount_get(fa) || first_free_frame() != free_before) return fail("frames not released");
+
+    /* a segment running past the end of the file is refused without leaks */
+    image.ph[1].p_filesz = sizeof(image);
+    if (elf_load((const uint8_t *)&image, sizeof(image)) || first_free_frame() != free_before)
+        return fail("truncated image");
+
+    printf("PASS: spawned children load into private frames, parent image and kernel tables untouched, frames freed on reap\n");
+    return 0;
+}
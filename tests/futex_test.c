@@ -0,0 +1,176 @@
+/* tests/futex_test.c - host-side test for futex wait/wake: physical-address
+   keys, value check, FIFO wake-N and timeouts. scheduler_yield runs a
+   scripted step, standing in for whatever other task would run while the
+   caller sleeps. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define HOST_TEST
+
+#include "../kernel/arch/x86/uaccess.c"
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/futex.c"
+
+void serial_puts(const char *s) { (void)s; }
+void serial_putc(char c) { (void)c; }
+void *kmalloc(unsigned int size) { return malloc(size); }
+
+static process_t task[3];
+static process_t *current = &task[0];
+process_t *pm_get_current(void) { return current; }
+
+static int wake_order[8], nwoken;
+void sched_wake(process_t *p) {
+    if (p->state != 2) return;
+    p->state = 0;
+    wake_order[nwoken++] = (int)(p - task);
+}
+
+static timer_event_t *armed;
+static void (*armed_fn)(void *);
+static void *armed_arg;
+static int timers_full;
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    (void)deadline;
+    if (timers_full) return -1;
+    armed = ev;
+    armed_fn = fn;
+    armed_arg = arg;
+    return 0;
+}
+void timer_cancel(timer_event_t *ev) { if (ev == armed) armed = NULL; }
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns; }
+
+/* Two host pages mapped to the same "physical" frame, like a page shared
+   between two address spaces (or mapped twice in one) */
+#define FRAME 0x5000000ULL
+static uint32_t *va1, *va2;
+
+static void (*on_yield)(int step);
+static int yields;
+void scheduler_yield(void) {
+    process_t *self = current;
+    on_yield(yields++);
+    current = self;
+}
+
+static int64_t r_wake, r_wait_b, r_wait_c;
+
+/* A waits; B and C queue behind it; then wake 2 (A, B) and the rest (C) */
+static void wake_n_script(int step) {
+    switch (step) {
+        case 0:
+            current = &task[1];
+            r_wait_b = futex_wait((uint64_t)va1, 0, 0);
+            break;
+        case 1:
+            current = &task[2];
+            r_wait_c = futex_wait((uint64_t)va2, 0, 0);
+            break;
+        case 2:
+            r_wake = futex_wake((uint64_t)va2, 2);
+            break;
+        case 3:
+            r_wake += futex_wake((uint64_t)va1, 5);
+            break;
+    }
+}
+
+static void wake_alias_script(int step) {
+    (void)step;
+    r_wake = futex_wake((uint64_t)va2, 1);
+}
+
+static void timeout_script(int step) {
+    (void)step;
+    if (armed) armed_fn(armed_arg);
+}
+
+int main(void) {
+    uint8_t *pages = aligned_alloc(4096, 2 * 4096);
+    memset(pages, 0, 2 * 4096);
+    va1 = (uint32_t *)(pages + 0x40);
+    va2 = (uint32_t *)(pages + 4096 + 0x40);
+
+    void *pml4 = pt_clone_current();
+    pt_map_page(pml4, (uint64_t)pages, FRAME, 0x7);
+    pt_map_page(pml4, (uint64_t)pages + 4096, FRAME, 0x7);
+    for (int i = 0; i < 3; i++) task[i].page_table = pml4;
+
+    /* keys come from the frame, not the virtual address */
+    if (futex_key((uint64_t)va1) != FRAME + 0x40 || futex_key((uint64_t)va2) != FRAME + 0x40 ||
+        futex_key((uint64_t)pages + 3 * 4096) != 0) {
+        printf("FAIL: key translation\n");
+        return 1;
+    }
+    /* and a 2 MiB page resolves with its in-page offset */
+    pt_map_page(pml4, 0x1000, 0x1000, 0x7);
+    uint64_t *pdpt = (uint64_t *)(((uint64_t *)pml4)[0] & PT_ADDR_MASK);
+    uint64_t *pd = aligned_alloc(4096, 4096);
+    memset(pd, 0, 4096);
+    pdpt[1] = (uint64_t)pd | 0x7;
+    pd[3] = 0x40000000ULL | 0x80 | 0x7;
+    if (pt_virt_to_phys(pml4, 0x40600000ULL + 0x12345) != 0x40000000ULL + 0x12345) {
+        printf("FAIL: 2 MiB translation\n");
+        return 1;
+    }
+
+    /* value changed before sleeping: no sleep, EAGAIN */
+    *va1 = 5;
+    on_yield = wake_alias_script;
+    yields = 0;
+    if (futex_wait((uint64_t)va1, 4, 0) != FUTEX_EAGAIN || yields) {
+        printf("FAIL: value mismatch must not sleep\n");
+        return 1;
+    }
+
+    /* bad arguments */
+    if (futex_wait((uint64_t)va1 + 1, 5, 0) != -1 || futex_wake((uint64_t)pages + 3 * 4096, 1) != -1 ||
+        futex_wake(0, 1) != -1) {
+        printf("FAIL: bad addresses accepted\n");
+        return 1;
+    }
+
+    /* wake through the alias mapping */
+    if (futex_wake((uint64_t)va1, 1) != 0) {
+        printf("FAIL: wake with no waiters\n");
+        return 1;
+    }
+    if (futex_wait((uint64_t)va1, 5, 0) != 0 || r_wake != 1 || task[0].state != 0) {
+        printf("FAIL: wait/wake via alias\n");
+        return 1;
+    }
+
+    /* wake-N is FIFO and wakes at most N */
+    *va1 = 0;
+    on_yield = wake_n_script;
+    yields = 0;
+    nwoken = 0;
+    int64_t r_wait_a = futex_wait((uint64_t)va1, 0, 0);
+    if (r_wait_a != 0 || r_wait_b != 0 || r_wait_c != 0 || r_wake != 3 || nwoken != 3 ||
+        wake_order[0] != 0 || wake_order[1] != 1 || wake_order[2] != 2 || yields != 4) {
+        printf("FAIL: wake-N (woken=%d yields=%d)\n", nwoken, yields);
+        return 1;
+    }
+
+    /* timeout: the waiter leaves the queue */
+    on_yield = timeout_script;
+    if (futex_wait((uint64_t)va2, 0, 1000) != FUTEX_ETIMEDOUT || armed ||
+        futex_wake((uint64_t)va1, 1) != 0) {
+        printf("FAIL: timeout\n");
+        return 1;
+    }
+
+    /* no timer left: the wait is refused and leaves nothing queued */
+    timers_full = 1;
+    yields = 0;
+    if (futex_wait((uint64_t)va2, 0, 1000) != FUTEX_ENOMEM || yields ||
+        futex_wake((uint64_t)va1, 1) != 0) {
+        printf("FAIL: timed wait without a timer\n");
+        return 1;
+    }
+
+    printf("PASS: futex keys, value check, FIFO wake-N, timeout and timer exhaustion\n");
+    return 0;
+}
@@ -0,0 +1,109 @@
+/* tests/gang_test.c - host-side test for gang scheduling slots */
+
+#include <stdio.h>
+#include <string.h>
+#define HOST_TEST
+
+#include "../kernel/mm/virtual_memory.c"
+#include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/scheduler/preemptive.c"
+#include "../kernel/scheduler/deadline.c"
+#include "../kernel/trace.c"
+
+void serial_puts(const char *s) { (void)s; }
+void serial_putc(char c) { (void)c; }
+void serial_put_hex(uint64_t v) { (void)v; }
+void serial_put_dec(uint64_t v) { (void)v; }
+
+void enable_interrupts(void) { }
+int timer_interrupt(void) { return 1; }
+void timer_sched_update(int nr_runnable) { (void)nr_runnable; }
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    (void)ev; (void)deadline; (void)fn; (void)arg;
+    return 0;
+}
+void timer_cancel(timer_event_t *ev) { (void)ev; }
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns; }   /* 1 tick = 1 ns */
+uint64_t timer_tsc_hz(void) { return 1000000000ULL; }
+
+static uint64_t vclock = 100;
+static uint64_t now(void) { return vclock; }
+
+static uint64_t frame[32];
+static process_t *p[4];
+
+/* Advance the clock by dt, switch, and check who got the CPU */
+static int step(uint64_t dt, process_t *want, const char *what) {
+    vclock += dt;
+    scheduler_switch(frame);
+    if (pm_get_current() == want) return 1;
+    process_t *got = pm_get_current();
+    printf("FAIL: %s: got pid %llu at t=%llu\n", what,
+           got ? (unsigned long long)got->pid : 0ULL, (unsigned long long)vclock);
+    return 0;
+}
+
+int main(void) {
+    sched_clock_hook = now;
+    for (int i = 0; i < 4; ++i) {
+        p[i] = (process_t *)kmalloc(sizeof(process_t));
+        memset(p[i], 0, sizeof(process_t));
+        p[i]->stack_top = 0x1000 * (i + 1);
+        pm_register_process(p[i]);
+        sched_add_existing_process(p[i]);
+    }
+    process_t *a = p[0], *c = p[1], *b = p[2], *d = p[3];
+
+    /* No gang: plain round robin interleaves everyone */
+    if (!step(0, a, "rr 1") || !step(10, c, "rr 2") || !step(10, b, "rr 3") ||
+        !step(10, d, "rr 4"))
+        return 1;
+
+    /* a and b form a gang with a 50-tick slot */
+    int g = sched_gang_create(50);
+    if (g <= 0 || sched_gang_join(a, g) || sched_gang_join(b, g)) {
+        printf("FAIL: gang setup\n");
+        return 1;
+    }
+    if (sched_gang_join(a, SCHED_MAX_GANGS) != -1) {
+        printf("FAIL: joined a gang that does not exist\n");
+        return 1;
+    }
+
+    /* Picking a opens the slot: only members run until it expires */
+    if (!step(10, a, "slot open") || !step(10, b, "member 2") ||
+        !step(10, a, "member 1 again") || !step(10, b, "member 2 again"))
+        return 1;
+    /* Slot over (opened at t=140, ends at t=190): c and d get one turn
+       each, then the gang gets its next slot */
+    if (!step(20, d, "after slot") || !step(10, c, "after slot 2") ||
+        !step(10, b, "next slot"))
+        return 1;
+    if (sched_gang_slots(g) != 2) {
+        printf("FAIL: slots=%llu\n", (unsigned long long)sched_gang_slots(g));
+        return 1;
+    }
+
+    /* Every member waiting ends the slot early */
+    a->state = 2;
+    b->state = 2;
+    if (!step(1, d, "gang blocked")) return 1;
+    a->state = 0;
+    b->state = 0;
+
+    /* Leaving the gang puts a task back into plain round robin; the gang
+       is released with its last member */
+    sched_gang_join(a, 0);
+    sched_gang_join(b, 0);
+    if (gangs[g].slice_tsc != 0) { printf("FAIL: empty gang not released\n"); return 1; }
+    if (!step(10, a, "rr again 1") || !step(10, c, "rr again 2") ||
+        !step(10, b, "rr again 3"))
+        return 1;
+
+    printf("PASS: gang members share slots, others run between them\n");
+    return 0;
+}
@@ -3,6 +3,8 @@
 #include <string.h>
 
 /* Include IPC from kernel */
+#define HOST_TEST
+#include "../kernel/ipc/channel.c"
 #include "../kernel/ipc/message.c"
 
 /* Include scheduler logic */
@@ -2,6 +2,8 @@
 #include <string.h>
 
 /* Pull in the kernel IPC implementation for host-side unit test. */
+#define HOST_TEST
+#include "../kernel/ipc/channel.c"
 #include "../kernel/ipc/message.c"
 
 int main(void) {
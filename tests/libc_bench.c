@@ -0,0 +1,199 @@
+/* tests/libc_bench.c - host-side check and microbenchmark for the kernel
+   memcpy/memset/strlen/strcmp variants (kernel/libc.c). Every variant is
+   checked against a plain loop over all small sizes and alignments, then
+   timed from 8 B to 4 MiB. Build with -O2 -fno-tree-loop-distribute-patterns
+   for meaningful numbers, like the kernel. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#define HOST_TEST
+
+/* keep the kernel's definitions apart from the host C library */
+#define memcpy  kmemcpy
+#define memset  kmemset
+#define strlen  kstrlen
+#define strcmp  kstrcmp
+#define strcpy  kstrcpy
+#include "../kernel/libc.c"
+#undef memcpy
+#undef memset
+#undef strlen
+#undef strcmp
+#undef strcpy
+
+static int has_avx2(void) {
+    uint32_t a, b, c, d;
+    cpuid(1, 0, &a, &b, &c, &d);
+    if (!((c >> 28) & 1) || !((c >> 27) & 1)) return 0;
+    cpuid(7, 0, &a, &b, &c, &d);
+    return (b >> 5) & 1;
+}
+
+static int has_erms(void) {
+    uint32_t a, b, c, d;
+    cpuid(7, 0, &a, &b, &c, &d);
+    return (b >> 9) & 1;
+}
+
+static void copy_sse2_v(uint8_t *d, const uint8_t *s, size_t n) { copy_vec(d, s, n, 0); }
+static void copy_avx2_v(uint8_t *d, const uint8_t *s, size_t n) { copy_vec(d, s, n, 1); }
+static void copy_dispatch(uint8_t *d, const uint8_t *s, size_t n) { kmemcpy(d, s, n); }
+static void set_sse2_v(uint8_t *d, uint8_t c, size_t n) { set_vec(d, c, n, 0); }
+static void set_avx2_v(uint8_t *d, uint8_t c, size_t n) { set_vec(d, c, n, 1); }
+static void set_dispatch(uint8_t *d, uint8_t c, size_t n) { kmemset(d, c, n); }
+
+typedef struct {
+    const char *name;
+    void (*copy)(uint8_t *, const uint8_t *, size_t);
+    void (*set)(uint8_t *, uint8_t, size_t);
+    int usable;
+} variant_t;
+
+static variant_t variants[] = {
+    { "bytes",    copy_bytes,    set_bytes,    1 },
+    { "words",    copy_words,    set_words,    1 },
+    { "movsb",    copy_movsb,    set_stosb,    1 },
+    { "sse2",     copy_sse2_v,   set_sse2_v,   1 },
+    { "avx2",     copy_avx2_v,   set_avx2_v,   0 },
+    { "dispatch", copy_dispatch, set_dispatch, 1 },
+};
+#define NVARIANTS (int)(sizeof(variants) / sizeof(variants[0]))
+
+static double now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+#define GUARD 64
+
+static int check_copy(const variant_t *v, uint8_t *src, uint8_t *dst) {
+    for (size_t n = 0; n <= 600; n += (n < 140 ? 1 : 37)) {
+        for (int sa = 0; sa < 8; sa++) {
+            for (int da = 0; da < 8; da += 3) {
+                memset(dst, 0xEE, n + 2 * GUARD);
+                v->copy(dst + GUARD + da, src + sa, n);
+                if (memcmp(dst + GUARD + da, src + sa, n) ||
+                    dst[GUARD + da - 1] != 0xEE || dst[GUARD + da + n] != 0xEE) {
+                    printf("FAIL: %s memcpy n=%zu src+%d dst+%d\n", v->name, n, sa, da);
+                    return 0;
+                }
+            }
+        }
+    }
+    /* past the vector threshold and chunk size, odd tail */
+    size_t big = 3 * LIBC_VEC_CHUNK + 4096 + 13;
+    uint8_t *bs = malloc(big), *bd = malloc(big + 1);
+    for (size_t i = 0; i < big; i++) bs[i] = (uint8_t)(i * 7 + 3);
+    bd[big] = 0x5A;
+    v->copy(bd, bs, big);
+    int ok = !memcmp(bd, bs, big) && bd[big] == 0x5A;
+    if (!ok) printf("FAIL: %s memcpy n=%zu\n", v->name, big);
+    free(bs);
+    free(bd);
+    return ok;
+}
+
+static int check_set(const variant_t *v, uint8_t *dst) {
+    for (size_t n = 0; n <= 600; n += (n < 140 ? 1 : 37)) {
+        for (int da = 0; da < 8; da++) {
+            memset(dst, 0xEE, n + 2 * GUARD);
+            v->set(dst + GUARD + da, (uint8_t)(n + 1), n);
+            for (size_t i = 0; i < n; i++) {
+                if (dst[GUARD + da + i] != (uint8_t)(n + 1)) {
+                    printf("FAIL: %s memset n=%zu dst+%d\n", v->name, n, da);
+                    return 0;
+                }
+            }
+            if (dst[GUARD + da - 1] != 0xEE || dst[GUARD + da + n] != 0xEE) {
+                printf("FAIL: %s memset overrun n=%zu dst+%d\n", v->name, n, da);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static int sign(int x) { return (x > 0) - (x < 0); }
+
+static int check_strings(void) {
+    char a[256], b[256];
+    for (int off = 0; off < 8; off++) {
+        for (int len = 0; len < 100; len++) {
+            memset(a, 'x', sizeof(a));
+            a[off + len] = 0;
+            if (kstrlen(a + off) != (size_t)len) {
+                printf("FAIL: strlen len=%d off=%d\n", len, off);
+                return 0;
+            }
+            for (int boff = 0; boff < 8; boff++) {
+                memcpy(b + boff, a + off, (size_t)len + 1);
+                for (int pos = -1; pos < len; pos += 3) {
+                    if (pos >= 0) b[boff + pos] = (char)(pos & 1 ? 'y' : 0x90);
+                    int want = sign(strcmp(a + off, b + boff));
+                    int got = sign(kstrcmp(a + off, b + boff));
+                    if (want != got) {
+                        printf("FAIL: strcmp len=%d off=%d/%d diff=%d\n", len, off, boff, pos);
+                        return 0;
+                    }
+                    if (pos >= 0) b[boff + pos] = a[off + pos];
+                }
+            }
+        }
+    }
+    /* prefix: shorter string sorts first */
+    return sign(kstrcmp("abcdefghij", "abcdefghijk")) == -1 &&
+           sign(kstrcmp("abcdefghijk", "abcdefghij")) == 1 && kstrcmp("", "") == 0;
+}
+
+static double bench(const variant_t *v, int set, uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t total = 16ULL << 20;
+    int iters = (int)(total / n);
+    if (iters > 200000) iters = 200000;
+    if (iters < 4) iters = 4;
+    double t0 = now_ns();
+    for (int i = 0; i < iters; i++) {
+        if (set) v->set(dst, (uint8_t)i, n);
+        else v->copy(dst, src, n);
+        asm volatile ("" : : "r"(dst) : "memory");
+    }
+    return (double)n * iters / (now_ns() - t0);   /* GB/s */
+}
+
+int main(void) {
+    libc_init();
+    variants[4].usable = has_avx2();
+
+    size_t buf = (4u << 20) + 2 * GUARD;
+    uint8_t *src = aligned_alloc(64, buf), *dst = aligned_alloc(64, buf);
+    for (size_t i = 0; i < buf; i++) src[i] = (uint8_t)(i * 31 + 1);
+
+    for (int i = 0; i < NVARIANTS; i++) {
+        if (!variants[i].usable) continue;
+        if (!check_copy(&variants[i], src, dst) || !check_set(&variants[i], dst)) return 1;
+    }
+    if (!check_strings()) {
+        printf("FAIL: string functions\n");
+        return 1;
+    }
+
+    printf("host: erms=%d fsrm=%d vec=%s\n", has_erms(), libc_fsrm,
+           libc_vec == LIBC_VEC_AVX2 ? "avx2" : libc_vec == LIBC_VEC_SSE2 ? "sse2" : "none");
+    for (int set = 0; set < 2; set++) {
+        printf("%s GB/s %10s", set ? "memset" : "memcpy", "size");
+        for (int i = 0; i < NVARIANTS; i++)
+            if (variants[i].usable) printf(" %9s", variants[i].name);
+        printf("\n");
+        for (size_t n = 8; n <= (4u << 20); n *= 2) {
+            printf("            %10zu", n);
+            for (int i = 0; i < NVARIANTS; i++)
+                if (variants[i].usable) printf(" %9.2f", bench(&variants[i], set, dst, src, n));
+            printf("\n");
+        }
+    }
+
+    printf("PASS: memcpy/memset variants and word-at-a-time strlen/strcmp\n");
+    return 0;
+}
@@ -1,11 +1,79 @@
-/* tests/pagetable_test.c - host-side test for page table clone helpers */
+/* tests/pagetable_test.c - host-side test for page table clone helpers:
+   pt_clone_for_cow copies every user table, shares the kernel's, and
+   turns user pages read-only with an extra reference on both sides;
+   PTE_NOFORK pages stay with the parent */
 
 #define HOST_TEST
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 #include "../kernel/mm/pagetable.c"
 
+static uint64_t *table(void) {
+    uint64_t *t = aligned_alloc(4096, 4096);
+    memset(t, 0, 4096);
+    return t;
+}
+
+static uint64_t *next(uint64_t *t, int i) { return (uint64_t *)(t[i] & PT_ADDR_MASK); }
+
+static int cow_clone(void) {
+    physical_memory_init();
+    uint64_t *k = pt_get_kernel_pml4();
+    /* kernel half: PML4[0] -> identity PD of 2 MiB supervisor pages */
+    uint64_t *kpdpt = table(), *kpd = table();
+    for (int i = 0; i < 512; i++) kpd[i] = ((uint64_t)i << 21) | 0x83;
+    kpdpt[0] = (uint64_t)kpd | 0x3;
+    k[0] = (uint64_t)kpdpt | 0x3;
+
+    /* a process with a user page at 0x400000 (private PDPT/PD/PT under
+       PML4[0]) and one in a user-only PML4 slot */
+    uint64_t *pml4 = pt_clone_current();
+    uint32_t f1 = alloc_frame(), f2 = alloc_frame(), ring = alloc_frames(2);
+    if (pt_map_page(pml4, 0x400000, f1, 0x7) || pt_map_page(pml4, 0x7F0000000000ULL, f2, 0x7) ||
+        pt_map_page(pml4, 0x402000, ring, 0x7 | PTE_NOFORK))
+        return printf("FAIL: map user pages\n"), 1;
+    if (next(pml4, 0) == kpdpt) return printf("FAIL: map wrote into kernel tables\n"), 1;
+
+    uint64_t *c = pt_clone_for_cow(pml4);
+    if (!c || c == pml4) return printf("FAIL: cow clone\n"), 1;
+    for (int i = 0; i < 512; i++)
+        if ((pml4[i] & 1) && next(c, i) == next(pml4, i)) return printf("FAIL: user PDPT %d shared\n", i), 1;
+    if (next(next(c, 0), 0) == next(next(pml4, 0), 0)) return printf("FAIL: user PD shared\n"), 1;
+    uint64_t *pp = pt_find_pte_for_vaddr(pml4, 0x400000), *cp = pt_find_pte_for_vaddr(c, 0x400000);
+    if (!pp || !cp || pp == cp) return printf("FAIL: user PT shared\n"), 1;
+    if ((*pp & 0x2) || (*cp & 0x2) || (*cp & PT_ADDR_MASK) != f1 || frame_refcount_get(f1) != 2)
+        return printf("FAIL: COW page state\n"), 1;
+    if (frame_refcount_get(f2) != 2) return printf("FAIL: COW page in user slot\n"), 1;
+    /* a kernel object's page stays with the parent only */
+    if (pt_virt_to_phys(c, 0x402000) != PT_NO_PHYS || pt_virt_to_phys(pml4, 0x402000) != ring ||
+        frame_refcount_get(ring) != 1 || frame_refcount_get(ring + 4096) != 1)
+        return printf("FAIL: PTE_NOFORK page passed on\n"), 1;
+    /* identity map still reaches the kernel next to the user page */
+    if (pt_virt_to_phys(c, 0x600000) != 0x600000 || pt_virt_to_phys(c, 0x100000) != 0x100000)
+        return printf("FAIL: identity map lost\n"), 1;
+
+    /* a write into the child's tables stays in the child */
+    uint32_t f3 = alloc_frame();
+    if (pt_map_page(c, 0x401000, f3, 0x7)) return printf("FAIL: map in child\n"), 1;
+    if (pt_virt_to_phys(pml4, 0x401000) != 0x401000 || pt_virt_to_phys(c, 0x401000) != f3)
+        return printf("FAIL: child mapping visible in parent\n"), 1;
+
+    /* ring 3 reaches user pages only, up to the first kernel page */
+    if (pt_user_bytes(c, 0x400000, 0x2000) != 0x2000 || pt_user_bytes(pml4, 0x400800, 0x1000) != 0x800 ||
+        pt_user_bytes(c, 0x100000, 16) != 0 || pt_user_bytes(c, 0x7F0000000000ULL + 8, 8) != 8)
+        return printf("FAIL: user reach\n"), 1;
+
+    /* destroying the child drops exactly its references */
+    pt_destroy(c);
+    if (frame_refcount_get(f1) != 1 || frame_refcount_get(f2) != 1 || frame_refcount_get(f3))
+        return printf("FAIL: release\n"), 1;
+    if (pt_unmap_page(pml4, 0x402000) != (ring | 0x7 | PTE_NOFORK) || pt_virt_to_phys(pml4, 0x402000) != PT_NO_PHYS)
+        return printf("FAIL: unmap\n"), 1;
+    return 0;
+}
+
 int main(void) {
     void *k = pt_get_kernel_pml4();
     if (!k) { printf("FAIL: kernel pml4 is NULL\n"); return 1; }
@@ -15,6 +83,8 @@ int main(void) {
 
     if (c == k) { printf("FAIL: clone returned same pointer as kernel pml4\n"); return 1; }
 
-    printf("PASS: pagetable clone works (kernel=%p clone=%p)\n", k, c);
+    if (cow_clone()) return 1;
+
+    printf("PASS: pagetable clone and COW clone work (kernel=%p clone=%p)\n", k, c);
     return 0;
 }
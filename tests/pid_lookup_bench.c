@@ -0,0 +1,97 @@
+/* tests/pid_lookup_bench.c - host benchmark: pm_find_by_pid with 100, 10k and 100k live processes
+ * Compares the radix PID index against walking the registry list (what the
+ * old linear pm_proc_table scan amounted to).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#define HOST_TEST
+
+#include "../kernel/mm/virtual_memory.c"
+#include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/scheduler/preemptive.c"
+#include "../kernel/scheduler/deadline.c"
+#include "../kernel/trace.c"
+
+void serial_puts(const char *s) { (void)s; }
+void serial_putc(char c) { (void)c; }
+void serial_put_hex(uint64_t v) { (void)v; }
+
+void enable_interrupts(void) { }
+int timer_interrupt(void) { return 1; }
+void timer_sched_update(int nr_runnable) { (void)nr_runnable; }
+/* Deadline-class timers are not exercised here */
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    (void)ev; (void)deadline; (void)fn; (void)arg;
+    return 0;
+}
+void timer_cancel(timer_event_t *ev) { (void)ev; }
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns; }
+uint64_t timer_tsc_hz(void) { return 1000000000ULL; }
+void serial_put_dec(uint64_t v) { printf("%llu", (unsigned long long)v); }
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng = 2463534242u;
+static uint32_t xorshift(void) {
+    rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+    return rng;
+}
+
+static process_t *list_find(uint64_t pid) {
+    for (process_t *p = pm_head; p; p = p->pm_next)
+        if (p->pid == pid) return p;
+    return NULL;
+}
+
+static int run(int live) {
+    static process_t *procs[100000];
+    for (int i = 0; i < live; ++i) {
+        procs[i] = pm_alloc_process();
+        if (!procs[i] || !pm_register_process(procs[i])) return -1;
+    }
+
+    const int lookups = 1000000;
+    uint64_t t0 = now_ns();
+    int idx = rcu_read_lock();
+    for (int i = 0; i < lookups; ++i) {
+        process_t *want = procs[xorshift() % live];
+        if (pm_find_by_pid(want->pid) != want) { rcu_read_unlock(idx); return -1; }
+    }
+    rcu_read_unlock(idx);
+    uint64_t index_ns = now_ns() - t0;
+
+    /* the list walk is O(n): scale the number of lookups down */
+    int walks = live >= 10000 ? 2000 : 100000;
+    t0 = now_ns();
+    for (int i = 0; i < walks; ++i) {
+        process_t *want = procs[xorshift() % live];
+        if (list_find(want->pid) != want) return -1;
+    }
+    uint64_t walk_ns = now_ns() - t0;
+
+    printf("[pid_bench] live=%d index_ns_per_lookup=%.1f list_walk_ns_per_lookup=%.1f\n",
+           live, (double)index_ns / lookups, (double)walk_ns / walks);
+
+    for (int i = 0; i < live; ++i) pm_reap(procs[i]);
+    rcu_poll();
+    return 0;
+}
+
+int main(void) {
+    int sizes[] = { 100, 10000, 100000 };
+    for (int i = 0; i < 3; ++i) {
+        if (run(sizes[i]) < 0) { printf("FAIL: lookup mismatch with %d live\n", sizes[i]); return 1; }
+    }
+    printf("PASS: pid lookup benchmark done\n");
+    return 0;
+}
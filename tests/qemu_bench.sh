@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Build the kernel with a RUN_*_BENCH define, boot it in QEMU and print the
+# benchmark lines it reports over serial.
+# Usage: tests/qemu_bench.sh RUN_YIELD_BENCH [seconds] [extra qemu args...]
+# KERNEL_ARGS is appended to the kernel command line (e.g. isolcpus=1).
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+cd "$ROOT"
+
+BENCH="${1:?usage: $0 RUN_<NAME>_BENCH [seconds] [qemu args...]}"
+SECS="${2:-15}"
+shift $(( $# >= 2 ? 2 : 1 ))
+
+echo "Building kernel with -D$BENCH..."
+make -C kernel clean >/dev/null
+make -C kernel DEFS="-D$BENCH" all >/dev/null
+
+rm -rf isodir
+mkdir -p isodir/boot/grub
+cp kernel.elf isodir/boot/kernel.elf
+printf '%s\n' 'set timeout=0' 'set default=0' '' 'menuentry "myos" {' "  multiboot2 /boot/kernel.elf ${KERNEL_ARGS:-}" '  boot' '}' > isodir/boot/grub/grub.cfg
+grub-mkrescue -o myos.iso isodir 2>/dev/null || xorriso -as mkisofs -R -J -o myos.iso isodir
+
+if ! command -v qemu-system-x86_64 >/dev/null 2>&1; then
+  echo "qemu-system-x86_64 not found in PATH — please install QEMU to run this benchmark."
+  exit 2
+fi
+
+mkdir -p tmp
+SERIAL_LOG="tmp/qemu_bench_serial.log"
+rm -f "$SERIAL_LOG"
+
+echo "Running QEMU for ${SECS}s (capturing serial to $SERIAL_LOG)"
+timeout "${SECS}s" qemu-system-x86_64 -cdrom myos.iso -m 512M -serial file:$SERIAL_LOG "$@" >/dev/null 2>&1 || true
+
+if grep -q "_bench\] done" "$SERIAL_LOG"; then
+  grep "_bench\]" "$SERIAL_LOG"
+  exit 0
+else
+  echo "FAIL: benchmark did not finish"
+  tail -n 50 "$SERIAL_LOG" || true
+  exit 1
+fi
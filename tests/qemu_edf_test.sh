@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+# QEMU test for the deadline class: periodic tasks under batch load must
+# not miss any deadline (kernel built with RUN_EDF_BENCH).
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+cd "$ROOT"
+
+OUT="$(bash tests/qemu_bench.sh RUN_EDF_BENCH 15)" || { echo "$OUT"; exit 1; }
+echo "$OUT"
+if echo "$OUT" | grep -q "total_misses=0$"; then
+  echo "PASS: no deadline misses"
+  exit 0
+else
+  echo "FAIL: deadline misses reported"
+  exit 1
+fi
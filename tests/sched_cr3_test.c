@@ -0,0 +1,97 @@
+/* tests/sched_cr3_test.c - host-side test for address-space switching in scheduler_switch */
+
+#include <stdio.h>
+#include <string.h>
+#define HOST_TEST
+
+#include "../kernel/mm/virtual_memory.c"
+#include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/scheduler/preemptive.c"
+#include "../kernel/scheduler/deadline.c"
+#include "../kernel/trace.c"
+
+void serial_puts(const char *s) { if (s) printf("%s", s); }
+void serial_putc(char c) { putchar(c); }
+void serial_put_hex(uint64_t v) { printf("%llx", (unsigned long long)v); }
+
+void enable_interrupts(void) { }
+int timer_interrupt(void) { return 1; } /* every tick ends the slice */
+void timer_sched_update(int nr_runnable) { (void)nr_runnable; }
+/* Deadline-class timers are not exercised here */
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    (void)ev; (void)deadline; (void)fn; (void)arg;
+    return 0;
+}
+void timer_cancel(timer_event_t *ev) { (void)ev; }
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns; }
+uint64_t timer_tsc_hz(void) { return 1000000000ULL; }
+void serial_put_dec(uint64_t v) { printf("%llu", (unsigned long long)v); }
+
+int main(void) {
+    process_t *p[3];
+    for (int i = 0; i < 3; ++i) {
+        p[i] = (process_t *)kmalloc(sizeof(process_t));
+        memset(p[i], 0, sizeof(process_t));
+        p[i]->stack_top = 0x1000 * (i + 1);
+        pm_register_process(p[i]);
+        sched_add_existing_process(p[i]);
+    }
+    /* Tasks 0 and 1 share the kernel PML4 (threads); task 2 has its own */
+    p[2]->page_table = (uint64_t *)pt_clone_current();
+
+    uint64_t area[32];
+
+    scheduler_switch(area);                       /* idle -> 0: first load */
+    if (sched_cr3_loads() != 1) { printf("FAIL: first switch did not load CR3\n"); return 1; }
+
+    scheduler_switch(area);                       /* 0 -> 1: same PML4 */
+    if (sched_cr3_loads() != 1) { printf("FAIL: CR3 reloaded for same address space\n"); return 1; }
+
+    scheduler_switch(area);                       /* 1 -> 2: new PML4 */
+    if (sched_cr3_loads() != 2) { printf("FAIL: CR3 not loaded for other process\n"); return 1; }
+
+    /* Everyone but task 2 asleep: staying on it must not touch CR3, and a
+       trip through idle keeps the last address space loaded */
+    p[0]->state = 2;
+    p[1]->state = 2;
+    scheduler_switch(area);
+    p[2]->state = 2;
+    scheduler_switch(area);
+    p[2]->state = 0;
+    scheduler_switch(area);
+    if (sched_cr3_loads() != 2) { printf("FAIL: redundant CR3 loads (%llu)\n",
+                                         (unsigned long long)sched_cr3_loads()); return 1; }
+
+    /* Back to a kernel-PML4 task */
+    p[2]->state = 2;
+    p[0]->state = 0;
+    scheduler_switch(area);
+    if (sched_cr3_loads() != 3) { printf("FAIL: CR3 not restored for kernel PML4 task\n"); return 1; }
+
+    /* An unaligned root is never loaded: the task is dropped instead */
+    p[0]->state = 2;
+    p[2]->state = 0;
+    p[2]->page_table = (uint64_t *)((uint8_t *)pt_clone_current() + 8);
+    scheduler_switch(area);
+    if (sched_cr3_loads() != 3 || p[2]->state != 3 || p[2]->exit_code != -1 || pm_get_current()) {
+        printf("FAIL: unaligned PML4 was loaded or its task kept running\n");
+        return 1;
+    }
+    /* nobody waits for an orphan: it is reaped on the spot */
+    uint64_t pid1 = p[1]->pid;
+    p[1]->flags |= PF_AUTOREAP;
+    p[1]->state = 0;
+    p[1]->page_table = p[2]->page_table;
+    scheduler_switch(area);
+    if (pm_find_by_pid(pid1) || pm_get_current()) {
+        printf("FAIL: orphan with an unaligned PML4 was not reaped\n");
+        return 1;
+    }
+
+    printf("PASS: scheduler_switch loads CR3 only when the address space changes\n");
+    return 0;
+}
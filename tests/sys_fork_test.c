@@ -9,7 +9,10 @@
 #include "../kernel/tasks/process.c"
 
 #include "../kernel/mm/virtual_memory.c"
-#include "../kernel/process_manager.c"
+#include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
 
 /* minimal serial stubs used by syscall.c for host tests */
 #include <inttypes.h>
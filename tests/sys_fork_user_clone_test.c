@@ -6,7 +6,10 @@
 /* Include only the user-space process path implementations: virtual memory, process manager, elf loader and syscall */
 #include "../kernel/mm/virtual_memory.c"
 #include "../kernel/tasks/process.c"
-#include "../kernel/process_manager.c"
+#include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
 #include "../kernel/elf_loader.c"
 #include "../kernel/syscall.c"
 
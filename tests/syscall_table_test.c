@@ -0,0 +1,134 @@
+/* tests/syscall_table_test.c - host-side test for table-driven syscall
+   dispatch and the per-syscall counters/histograms */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#define HOST_TEST
+
+#include "../kernel/arch/x86/uaccess.c"
+#include "../kernel/syscall_table.c"
+
+void serial_puts(const char *s) { (void)s; }
+void serial_putc(char c) { (void)c; }
+int sched_cpu_id(void) { return 0; }
+void sched_dl_yield(void) { }
+
+/* Handlers: record what they were called with */
+static int last_nr;
+static uint64_t last_args[4];
+#define RECORD(nr, a0, a1, a2, a3) \
+    (last_nr = (nr), last_args[0] = (a0), last_args[1] = (a1), last_args[2] = (a2), last_args[3] = (a3))
+
+void sys_exit(int code) { RECORD(SYS_EXIT, code, 0, 0, 0); }
+syscall_result_t sys_log(const char *msg) { RECORD(SYS_LOG, (uint64_t)msg, 0, 0, 0); return 0; }
+void *sys_mmap(uint64_t addr, uint64_t size, int prot) { RECORD(SYS_MMAP, addr, size, prot, 0); return (void *)addr; }
+int sys_fork(void) { RECORD(SYS_FORK, 0, 0, 0, 0); return 7; }
+int sys_exec(const char *path, char **argv) { RECORD(SYS_EXEC, (uint64_t)path, (uint64_t)argv, 0, 0); return -1; }
+int sys_wait(int pid) { RECORD(SYS_WAIT, pid, 0, 0, 0); return 0; }
+int sys_read(int fd, void *buf, int count) { RECORD(SYS_READ, fd, (uint64_t)buf, count, 0); return count; }
+int sys_write(int fd, const void *buf, int count) { RECORD(SYS_WRITE, fd, (uint64_t)buf, count, 0); return count; }
+int sys_open(const char *path, int flags) { RECORD(SYS_OPEN, (uint64_t)path, flags, 0, 0); return 3; }
+int sys_close(int fd) { RECORD(SYS_CLOSE, fd, 0, 0, 0); return 0; }
+int sys_sleep(uint64_t ns) { RECORD(SYS_SLEEP, ns, 0, 0, 0); return 0; }
+int sys_clone(uint64_t f, uint64_t e, uint64_t s, uint64_t t) { RECORD(SYS_CLONE, f, e, s, t); return 9; }
+int64_t sys_arch_prctl(int code, uint64_t addr) { RECORD(SYS_ARCH_PRCTL, code, addr, 0, 0); return 0; }
+int sys_spawn(const char *path, char **argv) { RECORD(SYS_SPAWN, (uint64_t)path, (uint64_t)argv, 0, 0); return 0; }
+int sys_sched_setaffinity(uint64_t pid, uint64_t mask) { RECORD(SYS_SCHED_SETAFFINITY, pid, mask, 0, 0); return 0; }
+int64_t sys_sched_getaffinity(uint64_t pid) { RECORD(SYS_SCHED_GETAFFINITY, pid, 0, 0, 0); return 1; }
+int sys_sched_setattr(uint64_t pid, uint64_t r, uint64_t d, uint64_t p) { RECORD(SYS_SCHED_SETATTR, pid, r, d, p); return 0; }
+int64_t sys_trace(int op, uint64_t a1, uint64_t a2) { RECORD(SYS_TRACE, op, a1, a2, 0); return 0; }
+int sys_sched_gang(int op, uint64_t a1, uint64_t a2) { RECORD(SYS_SCHED_GANG, op, a1, a2, 0); return 0; }
+int64_t sys_getpid(void) { RECORD(SYS_GETPID, 0, 0, 0, 0); return 42; }
+int64_t sys_uring_setup(uint64_t e, uint64_t f) { RECORD(SYS_URING_SETUP, e, f, 0, 0); return 0; }
+int64_t sys_uring_enter(uint64_t s, uint64_t m, uint64_t f) { RECORD(SYS_URING_ENTER, s, m, f, 0); return 0; }
+int sys_clock_gettime(int clk, void *ts) { RECORD(SYS_CLOCK_GETTIME, clk, (uint64_t)ts, 0, 0); return 0; }
+int64_t sys_futex(uint64_t u, int op, uint32_t v, uint64_t a) { RECORD(SYS_FUTEX, u, op, v, a); return 0; }
+int sys_ipc_send_pages(uint64_t v, uint64_t l, int m) { RECORD(SYS_IPC_SEND_PAGES, v, l, m, 0); return 0; }
+int64_t sys_ipc_recv_pages(uint64_t v, uint64_t m) { RECORD(SYS_IPC_RECV_PAGES, v, m, 0, 0); return 0; }
+
+static syscall_stat_t snap[NR_SYSCALLS];
+
+static const syscall_stat_t *find(int n, int nr) {
+    for (int i = 0; i < n; i++)
+        if ((int)snap[i].nr == nr) return &snap[i];
+    return NULL;
+}
+
+int main(void) {
+    int ok = 1;
+
+    /* routing and argument passing */
+    ok &= syscall_dispatch(SYS_GETPID, 1, 2, 3, 4) == 42 && last_nr == SYS_GETPID;
+    ok &= syscall_dispatch(SYS_CLONE, 1, 2, 3, 4) == 9 && last_nr == SYS_CLONE &&
+          last_args[0] == 1 && last_args[1] == 2 && last_args[2] == 3 && last_args[3] == 4;
+    ok &= syscall_dispatch(SYS_WRITE, 1, 0x1000, 5, 99) == 5 && last_nr == SYS_WRITE &&
+          last_args[0] == 1 && last_args[1] == 0x1000 && last_args[2] == 5;
+    if (!ok) { printf("FAIL: dispatch routing\n"); return 1; }
+
+    /* unknown and unimplemented numbers */
+    last_nr = -1;
+    if (syscall_dispatch(0, 0, 0, 0, 0) != -1 || syscall_dispatch(SYS_STAT, 0, 0, 0, 0) != -1 ||
+        syscall_dispatch(NR_SYSCALLS, 0, 0, 0, 0) != -1 || syscall_dispatch(~0ULL, 0, 0, 0, 0) != -1 ||
+        last_nr != -1) {
+        printf("FAIL: invalid syscall numbers reached a handler\n");
+        return 1;
+    }
+
+    /* histogram buckets are floor(log2(cycles)), clamped */
+    if (syscall_hist_bucket(0) != 0 || syscall_hist_bucket(1) != 0 || syscall_hist_bucket(2) != 1 ||
+        syscall_hist_bucket(1023) != 9 || syscall_hist_bucket(1024) != 10 ||
+        syscall_hist_bucket(~0ULL) != SYSCALL_HIST_BUCKETS - 1) {
+        printf("FAIL: histogram bucket mapping\n");
+        return 1;
+    }
+
+    /* counters and snapshot */
+    syscall_stats_reset();
+    for (int i = 0; i < 1000; i++) syscall_dispatch(SYS_GETPID, 0, 0, 0, 0);
+    for (int i = 0; i < 10; i++) syscall_dispatch(SYS_YIELD, 0, 0, 0, 0);
+    syscall_dispatch(SYS_EXIT, 3, 0, 0, 0);
+
+    int n = sys_syscall_stats(snap, NR_SYSCALLS, 0);
+    const syscall_stat_t *gp = find(n, SYS_GETPID), *y = find(n, SYS_YIELD), *w = find(n, SYS_WRITE);
+    if (n != 28 || !gp || !y || !w || find(n, SYS_STAT)) {
+        printf("FAIL: snapshot lists %d syscalls\n", n);
+        return 1;
+    }
+    uint64_t sum = 0;
+    for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) sum += gp->hist[b];
+    if (gp->count != 1000 || sum != 1000 || gp->nargs != 0 || strcmp(gp->name, "getpid") ||
+        y->count != 10 || w->count != 0 || find(n, SYS_EXIT)->count != 1 ||
+        find(n, SYS_CLONE)->nargs != 4 || strcmp(find(n, SYS_SCHED_SETAFFINITY)->name, "sched_setaffinity")) {
+        printf("FAIL: snapshot counters/metadata (getpid count=%llu hist=%llu)\n",
+               (unsigned long long)gp->count, (unsigned long long)sum);
+        return 1;
+    }
+
+    /* the stats syscall itself is counted, bounded by max, and can reset */
+    if (syscall_dispatch(SYS_SYSCALL_STATS, (uint64_t)snap, 3, SYSCALL_STATS_RESET, 0) != 3 ||
+        snap[0].nr != SYS_EXIT || snap[2].nr != SYS_LOG) {
+        printf("FAIL: bounded snapshot\n");
+        return 1;
+    }
+    n = sys_syscall_stats(snap, NR_SYSCALLS, 0);
+    if (find(n, SYS_GETPID)->count != 0 || find(n, SYS_SYSCALL_STATS)->count != 1) {
+        printf("FAIL: reset\n");
+        return 1;
+    }
+    if (sys_syscall_stats(NULL, 4, 0) != -1) {
+        printf("FAIL: NULL buffer accepted\n");
+        return 1;
+    }
+
+    /* dispatch overhead including the accounting */
+    const int iters = 10000000;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < iters; i++) syscall_dispatch(SYS_GETPID, 0, 0, 0, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / iters;
+
+    printf("PASS: table dispatch, per-syscall counters and latency histograms (%.1f ns/call on host)\n", ns);
+    return 0;
+}
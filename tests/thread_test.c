@@ -0,0 +1,88 @@
+/* tests/thread_test.c - host-side test for thread_create (shared mm, own stack/TLS) */
+
+#include <stdio.h>
+#include <string.h>
+#define HOST_TEST
+
+#include "../kernel/mm/virtual_memory.c"
+#include "../kernel/process_manager.c"
+#include "../kernel/mm/slab.c"
+#include "../kernel/rcu.c"
+#include "../kernel/mm/mm.c"
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/scheduler/preemptive.c"
+#include "../kernel/scheduler/deadline.c"
+#include "../kernel/trace.c"
+
+void serial_puts(const char *s) { if (s) printf("%s", s); }
+void serial_putc(char c) { putchar(c); }
+void serial_put_hex(uint64_t v) { printf("%llx", (unsigned long long)v); }
+
+void enable_interrupts(void) { }
+int timer_interrupt(void) { return 1; } /* every tick ends the slice */
+void timer_sched_update(int nr_runnable) { (void)nr_runnable; }
+/* Deadline-class timers are not exercised here */
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    (void)ev; (void)deadline; (void)fn; (void)arg;
+    return 0;
+}
+void timer_cancel(timer_event_t *ev) { (void)ev; }
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns; }
+uint64_t timer_tsc_hz(void) { return 1000000000ULL; }
+void serial_put_dec(uint64_t v) { printf("%llu", (unsigned long long)v); }
+
+static void thread_fn(void) { }
+
+int main(void) {
+    process_t *parent = pm_alloc_process();
+    pm_register_process(parent);
+    parent->page_table = (uint64_t *)pt_clone_current();   /* a process with its own PML4 */
+    parent->flags |= PF_IMAGE;
+    parent->fs_base = 0x7000;
+    sched_add_existing_process(parent);
+
+    uint64_t area[32];
+    scheduler_switch(area);                 /* parent running */
+    uint64_t loads = sched_cr3_loads();
+
+    process_t *t1 = thread_create(parent, (uint64_t)thread_fn, 0, 0);
+    process_t *t2 = thread_create(parent, (uint64_t)thread_fn, 0, 0x9000);
+    if (!t1 || !t2) { printf("FAIL: thread_create\n"); return 1; }
+
+    if (!parent->mm || t1->mm != parent->mm || t2->mm != parent->mm || parent->mm->users != 3) {
+        printf("FAIL: threads do not share one mm\n");
+        return 1;
+    }
+    if (!parent->mm->image || (parent->flags & PF_IMAGE) || (t1->flags & PF_IMAGE)) {
+        printf("FAIL: address space not handed to the mm\n");
+        return 1;
+    }
+    if (t1->page_table != parent->page_table || t1->tgid != parent->pid || t2->tgid != parent->pid) {
+        printf("FAIL: wrong address space or thread group\n");
+        return 1;
+    }
+    if (t1->stack_base == t2->stack_base || t1->stack_base == parent->stack_base) {
+        printf("FAIL: threads share a kernel stack\n");
+        return 1;
+    }
+    if (t1->fs_base != 0x7000 || t2->fs_base != 0x9000) {
+        printf("FAIL: TLS base not inherited/set\n");
+        return 1;
+    }
+
+    /* Switching among the threads never reloads CR3 */
+    scheduler_switch(area);
+    scheduler_switch(area);
+    scheduler_switch(area);
+    if (sched_cr3_loads() != loads) { printf("FAIL: CR3 reloaded between threads\n"); return 1; }
+
+    /* Threads are joinable: a dead thread stays until reaped, then drops its mm ref */
+    t1->state = 3;
+    scheduler_switch(area);
+    if (!pm_find_by_pid(t1->pid)) { printf("FAIL: dead thread reaped before join\n"); return 1; }
+    pm_reap(t1);
+    if (parent->mm->users != 2) { printf("FAIL: mm reference not dropped\n"); return 1; }
+
+    printf("PASS: threads share the mm and page table, own stacks and TLS\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+/* tests/timer_heap_test.c - host-side test for the timer event heap */
+
+#include <stdio.h>
+#include <string.h>
+#define HOST_TEST
+
+#include "../kernel/drivers/timer.c"
+
+void serial_puts(const char *s) { if (s) printf("%s", s); }
+void serial_putc(char c) { putchar(c); }
+void serial_put_hex(uint64_t v) { printf("%llx", (unsigned long long)v); }
+void serial_put_dec(uint64_t v) { printf("%llu", (unsigned long long)v); }
+void serial_poll(void) { }
+
+/* Hardware/scheduler stubs (never reached in PIT mode with tsc_hz == 0) */
+int lapic_init(void) { return -1; }
+uint32_t lapic_read(uint32_t reg) { (void)reg; return 0; }
+void lapic_write(uint32_t reg, uint32_t val) { (void)reg; (void)val; }
+void lapic_eoi(void) { }
+void pic_send_eoi(int irq) { (void)irq; }
+void pic_mask_irq(int irq) { (void)irq; }
+void sched_wake(process_t *p) { (void)p; }
+process_t *pm_get_current(void) { return NULL; }
+void scheduler_yield(void) { }
+
+static int fired[16];
+static int nfired = 0;
+
+static void record(void *arg) { fired[nfired++] = (int)(intptr_t)arg; }
+
+static timer_event_t rearm_ev;
+static int rearm_count = 0;
+static void rearm(void *arg) {
+    (void)arg;
+    if (++rearm_count < 3) timer_add(&rearm_ev, rearm_ev.deadline + 10, rearm, NULL);
+}
+
+int main(void) {
+    timer_event_t ev[5];
+    uint64_t deadlines[5] = { 50, 10, 30, 20, 40 };
+    for (int i = 0; i < 5; ++i) {
+        ev[i].heap_idx = -1;
+        if (timer_add(&ev[i], deadlines[i], record, (void *)(intptr_t)deadlines[i]) != 0) {
+            printf("FAIL: timer_add failed\n");
+            return 1;
+        }
+    }
+
+    timer_cancel(&ev[2]); /* deadline 30 */
+    /* re-arming moves an event: 50 -> 5 */
+    timer_add(&ev[0], 5, record, (void *)(intptr_t)5);
+
+    timer_run_expired(25);
+    if (nfired != 3 || fired[0] != 5 || fired[1] != 10 || fired[2] != 20) {
+        printf("FAIL: expected 5,10,20 fired first (got %d events)\n", nfired);
+        return 1;
+    }
+
+    timer_run_expired(100);
+    if (nfired != 4 || fired[3] != 40) {
+        printf("FAIL: cancelled event fired or 40 missing (nfired=%d)\n", nfired);
+        return 1;
+    }
+    if (heap_size != 0) { printf("FAIL: heap not empty (%d)\n", heap_size); return 1; }
+
+    /* An event may re-arm itself from its callback */
+    rearm_ev.heap_idx = -1;
+    timer_add(&rearm_ev, 100, rearm, NULL);
+    timer_run_expired(1000);
+    if (rearm_count != 3) { printf("FAIL: self re-arm ran %d times\n", rearm_count); return 1; }
+
+    /* Heap capacity is bounded */
+    static timer_event_t many[TIMER_MAX_EVENTS + 1];
+    int rc = 0;
+    for (int i = 0; i <= TIMER_MAX_EVENTS; ++i) {
+        many[i].heap_idx = -1;
+        rc = timer_add(&many[i], 2000 + i, record, NULL);
+    }
+    if (rc != -1) { printf("FAIL: expected overflow to be rejected\n"); return 1; }
+
+    printf("PASS: timer heap orders, cancels and re-arms events\n");
+    return 0;
+}
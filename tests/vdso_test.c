@@ -0,0 +1,135 @@
+/* tests/vdso_test.c - host-side test for the vDSO clock and mapping */
+
+#include <stdio.h>
+#include <pthread.h>
+#define HOST_TEST
+
+#include "../kernel/mm/pagetable.c"
+#include "../kernel/vdso_text.c"
+#include "../kernel/vdso.c"
+
+void serial_puts(const char *s) { (void)s; }
+void serial_putc(char c) { (void)c; }
+void serial_put_hex(uint64_t v) { (void)v; }
+void serial_put_dec(uint64_t v) { (void)v; }
+void *kmalloc(unsigned int size) { return malloc(size); }
+int sched_cpu_id(void) { return 0; }
+
+/* Virtual TSC read by vdso_text.c */
+uint64_t host_tsc;
+uint32_t host_tsc_aux;
+
+static uint64_t hz;
+uint64_t timer_tsc_hz(void) { return hz; }
+uint64_t timer_tsc_to_ns(uint64_t tsc) {
+    if (!hz) return 0;
+    return (tsc / hz) * 1000000000ULL + (tsc % hz) * 1000000000ULL / hz;
+}
+uint64_t timer_ns_to_tsc(uint64_t ns) { return ns * hz / 1000000000ULL; }
+
+static uint64_t armed_at;
+int timer_add(timer_event_t *ev, uint64_t deadline, void (*fn)(void *), void *arg) {
+    ev->deadline = deadline;
+    ev->fn = fn;
+    ev->arg = arg;
+    armed_at = deadline;
+    return 0;
+}
+
+static int failures;
+#define CHECK(c, msg) do { if (!(c)) { printf("FAIL: %s\n", msg); failures++; } } while (0)
+
+static uint64_t absdiff(uint64_t a, uint64_t b) { return a > b ? a - b : b - a; }
+
+/* Writer rebases at varying TSC values while host_tsc stays put: every
+   consistent snapshot yields the same time, a torn one does not */
+static volatile int stop;
+static void *writer(void *arg) {
+    (void)arg;
+    for (uint64_t i = 0; !stop; i++)
+        vdso_rebase(host_tsc - (i % 1000) * hz / 1000);
+    return NULL;
+}
+
+int main(void) {
+    vdso_timespec_t ts;
+
+    /* not calibrated: callers must fall back to the syscall */
+    CHECK(vdso_clock_gettime(CLOCK_MONOTONIC, &ts) == -1, "uncalibrated clock read succeeded");
+
+    hz = 2500000000ULL;
+    host_tsc = 1000ULL * hz + 12345;
+    vdso_init();
+    CHECK(vdso_page.seq == 2, "seq not even after init");
+    CHECK(armed_at && rebase_event.deadline == armed_at, "rebase timer not armed");
+    CHECK(vdso_page.getcpu_off && vdso_page.clock_gettime_off, "entry points not published");
+
+    /* init rebased at the host's real TSC: redo it on the virtual one */
+    vdso_rebase(host_tsc);
+    CHECK(vdso_time_ns(CLOCK_MONOTONIC) == timer_tsc_to_ns(host_tsc), "clock wrong at rebase point");
+
+    /* within a rebase interval the error stays under a nanosecond and the
+       vDSO never runs ahead of the kernel clock */
+    uint64_t base = host_tsc;
+    int ok = 1;
+    for (uint64_t d = 1; d <= hz; d = d * 3 + 7) {
+        host_tsc = base + d;
+        uint64_t v = vdso_time_ns(CLOCK_MONOTONIC), k = timer_tsc_to_ns(host_tsc);
+        if (v > k || k - v > 1) ok = 0;
+    }
+    CHECK(ok, "conversion drifts from the kernel clock");
+
+    /* rebasing only moves the clock forward */
+    host_tsc = base + hz - 1;
+    uint64_t before = vdso_time_ns(CLOCK_MONOTONIC);
+    vdso_rebase(host_tsc);
+    CHECK(vdso_time_ns(CLOCK_MONOTONIC) >= before, "clock went backwards across a rebase");
+    CHECK(vdso_page.seq == 6, "rebase did not bump seq twice");
+
+    CHECK(vdso_clock_gettime(CLOCK_MONOTONIC, &ts) == 0, "clock_gettime failed");
+    CHECK((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec ==
+          vdso_time_ns(CLOCK_MONOTONIC), "timespec split wrong");
+    CHECK(ts.tv_nsec < 1000000000, "tv_nsec out of range");
+    CHECK(vdso_clock_gettime(7, &ts) == -1, "unknown clock accepted");
+    vdso_page.realtime_off = 5000;
+    CHECK(vdso_time_ns(CLOCK_REALTIME) == vdso_time_ns(CLOCK_MONOTONIC) + 5000,
+          "realtime offset not applied");
+    vdso_page.realtime_off = 0;
+
+    /* getcpu: page fallback and TSC_AUX */
+    uint32_t cpu = 99, node = 99;
+    vdso_page.cpu_mode = VDSO_CPU_PAGE;
+    vdso_page.cpu = 0;
+    vdso_getcpu(&cpu, &node);
+    CHECK(cpu == 0 && node == 0, "getcpu from the page");
+    vdso_page.cpu_mode = VDSO_CPU_RDTSCP;
+    host_tsc_aux = 3;
+    vdso_getcpu(&cpu, NULL);
+    CHECK(cpu == 3, "getcpu from TSC_AUX");
+
+    /* concurrent rebases never expose a torn snapshot */
+    host_tsc = base + 10 * hz;
+    vdso_rebase(host_tsc);
+    uint64_t expect = timer_tsc_to_ns(host_tsc);
+    pthread_t w;
+    pthread_create(&w, NULL, writer, NULL);
+    int torn = 0;
+    for (int i = 0; i < 2000000; i++)
+        if (absdiff(vdso_time_ns(CLOCK_MONOTONIC), expect) > 1) torn++;
+    stop = 1;
+    pthread_join(w, NULL);
+    CHECK(torn == 0, "reader saw a torn snapshot");
+    CHECK((vdso_page.seq & 1) == 0, "seq left odd");
+
+    /* mapping: the vDSO pages appear read-only, user-accessible */
+    void *pml4 = pt_clone_current();
+    CHECK(vdso_map(pml4) == 0, "vdso_map failed");
+    uint64_t *pte = pt_find_pte_for_vaddr(pml4, VDSO_BASE);
+    CHECK(pte && (*pte & 0x7) == 0x5, "vDSO PTE not present/user/read-only");
+    CHECK(pte && (*pte & ~0xFFFULL) == (uint64_t)&vdso_page, "vDSO PTE points elsewhere");
+    CHECK(vdso_map(NULL) == -1, "vdso_map accepted a NULL PML4");
+
+    if (failures) return 1;
+    printf("PASS: vDSO clock conversion, seqlock snapshots, getcpu and mapping\n");
+    return 0;
+}
@@ -0,0 +1,272 @@
+/* tools/klogdump.c
+ * Decode the binary kernel log (kernel/klog.h) in a captured serial log.
+ * The kernel only writes "[klog] <cpu> <tsc> <id> <arg>..." in hex; the
+ * format strings stay in the image. This reads the site table from the
+ * __klog_sites section of kernel.elf (id = index, 16 bytes per site),
+ * looks each format up in the section that holds it and prints
+ *
+ *     [    1.234567] [pm] registered process pid=3
+ *
+ * with the time in seconds from the "[klog] hz" line. Every other line
+ * of the log is copied through unchanged. The ELF has to be the one the
+ * log came from: a rebuild renumbers the sites.
+ *
+ * Build: gcc -O2 -o klogdump tools/klogdump.c
+ * Usage: klogdump kernel.elf [serial.log]   (stdin if no log)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <elf.h>
+
+#define KD_MAX_ARGS 6
+
+typedef struct kd_site {
+    const char *fmt;
+    int level;
+    int nargs;
+    int line;
+} kd_site_t;
+
+static kd_site_t *kd_sites;
+static int kd_nsites;
+static uint64_t kd_hz;
+static uint64_t kd_dropped;
+
+/* %s arguments are kernel addresses; the tool maps them into the ELF */
+static const char *(*kd_str)(uint64_t addr);
+
+/* Render fmt with the record's raw arguments into out (always terminated) */
+static void kd_format(char *out, size_t n, const char *fmt, const uint64_t *arg, int nargs) {
+    size_t len = 0;
+    int a = 0;
+#define KD_PUT(...) do {                                                \
+        int w_ = snprintf(out + len, n - len, __VA_ARGS__);             \
+        if (w_ > 0) len = len + (size_t)w_ < n ? len + (size_t)w_ : n - 1; \
+    } while (0)
+
+    out[0] = 0;
+    for (const char *p = fmt; *p && len + 1 < n; ) {
+        if (*p != '%') {
+            out[len++] = *p++;
+            out[len] = 0;
+            continue;
+        }
+        const char *start = p++;
+        if (*p == '%') {
+            KD_PUT("%%");
+            p++;
+            continue;
+        }
+        char spec[32];
+        size_t sl = 0;
+        spec[sl++] = '%';
+        while (*p && strchr("-+ #0", *p) && sl < 8) spec[sl++] = *p++;
+        while (*p >= '0' && *p <= '9' && sl < 16) spec[sl++] = *p++;
+        if (*p == '.') {
+            spec[sl++] = *p++;
+            while (*p >= '0' && *p <= '9' && sl < 24) spec[sl++] = *p++;
+        }
+        while (*p && strchr("hljzt", *p)) p++;      /* every argument is a u64 */
+        char c = *p ? *p++ : 0;
+        spec[sl] = 0;
+
+        if (!c || !strchr("diuxXocps", c)) {
+            KD_PUT("%.*s", (int)(p - start), start);
+            continue;
+        }
+        if (a >= nargs) {
+            KD_PUT("<missing>");
+            continue;
+        }
+        uint64_t v = arg[a++];
+        switch (c) {
+        case 'd': case 'i':
+            strcat(spec, "lld");
+            KD_PUT(spec, (long long)v);
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            sl = strlen(spec);
+            spec[sl++] = 'l';
+            spec[sl++] = 'l';
+            spec[sl++] = c;
+            spec[sl] = 0;
+            KD_PUT(spec, (unsigned long long)v);
+            break;
+        case 'c':
+            strcat(spec, "c");
+            KD_PUT(spec, (int)(char)v);
+            break;
+        case 'p':
+            KD_PUT("0x%" PRIx64, v);
+            break;
+        case 's': {
+            const char *s = kd_str ? kd_str(v) : NULL;
+            strcat(spec, "s");
+            if (s) KD_PUT(spec, s);
+            else KD_PUT("<0x%" PRIx64 ">", v);
+            break;
+        }
+        }
+    }
+#undef KD_PUT
+}
+
+/* One "[klog] ..." line, p just past the tag. Returns 1 with the decoded
+   text in out, 0 for the hz/dropped lines, -1 if it does not parse. */
+static int kd_decode(const char *p, char *out, size_t n) {
+    uint64_t v[3 + KD_MAX_ARGS];
+    int cnt = 0;
+
+    if (sscanf(p, "hz %" SCNu64, &kd_hz) == 1) return 0;
+    if (sscanf(p, "dropped %" SCNu64, &v[0]) == 1) {
+        kd_dropped += v[0];
+        snprintf(out, n, "(%" PRIu64 " klog records lost)", v[0]);
+        return 1;
+    }
+    while (cnt < 3 + KD_MAX_ARGS) {
+        char *end;
+        while (*p == ' ') p++;
+        if (!*p || *p == '\n' || *p == '\r') break;
+        v[cnt] = strtoull(p, &end, 16);
+        if (end == p) return -1;
+        p = end;
+        cnt++;
+    }
+    if (cnt < 3) return -1;
+
+    uint64_t cpu = v[0], tsc = v[1], id = v[2];
+    char text[512];
+    if (id >= (uint64_t)kd_nsites) {
+        snprintf(text, sizeof(text), "<unknown klog site %" PRIu64 ">", id);
+    } else {
+        const kd_site_t *s = &kd_sites[id];
+        kd_format(text, sizeof(text), s->fmt, v + 3, cnt - 3);
+        if (cnt - 3 != s->nargs) strncat(text, " <argument count mismatch>", sizeof(text) - strlen(text) - 1);
+    }
+    /* records from CPUs other than 0 carry their number */
+    char where[32] = "";
+    if (cpu) snprintf(where, sizeof(where), " (cpu%" PRIu64 ")", cpu);
+    if (kd_hz)
+        snprintf(out, n, "[%5" PRIu64 ".%06" PRIu64 "] %s%s", tsc / kd_hz,
+                 (tsc % kd_hz) * 1000000 / kd_hz, text, where);
+    else
+        snprintf(out, n, "[tsc %" PRIu64 "] %s%s", tsc, text, where);
+    return 1;
+}
+
+#ifndef KLOGDUMP_NO_MAIN
+
+static unsigned char *image;
+static size_t image_size;
+static Elf64_Shdr *shdr;
+static int shnum;
+
+/* Kernel virtual address -> bytes in the file, via the section holding it */
+static const char *elf_str(uint64_t addr) {
+    for (int i = 0; i < shnum; i++) {
+        const Elf64_Shdr *s = &shdr[i];
+        if (!(s->sh_flags & SHF_ALLOC) || s->sh_type == SHT_NOBITS) continue;
+        if (addr >= s->sh_addr && addr < s->sh_addr + s->sh_size) {
+            uint64_t off = s->sh_offset + (addr - s->sh_addr);
+            return off < image_size ? (const char *)image + off : NULL;
+        }
+    }
+    return NULL;
+}
+
+static int load_sites(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    image_size = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    image = malloc(image_size);
+    if (!image || fread(image, 1, image_size, f) != image_size) {
+        fprintf(stderr, "klogdump: cannot read %s\n", path);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+
+    const Elf64_Ehdr *eh = (const Elf64_Ehdr *)image;
+    if (image_size < sizeof(*eh) || memcmp(eh->e_ident, ELFMAG, SELFMAG) ||
+        eh->e_ident[EI_CLASS] != ELFCLASS64 ||
+        eh->e_shoff + (uint64_t)eh->e_shnum * sizeof(Elf64_Shdr) > image_size) {
+        fprintf(stderr, "klogdump: %s is not a 64-bit ELF\n", path);
+        return -1;
+    }
+    shdr = (Elf64_Shdr *)(image + eh->e_shoff);
+    shnum = eh->e_shnum;
+    const char *names = (const char *)image + shdr[eh->e_shstrndx].sh_offset;
+
+    for (int i = 0; i < shnum; i++) {
+        if (strcmp(names + shdr[i].sh_name, "__klog_sites")) continue;
+        const unsigned char *p = image + shdr[i].sh_offset;
+        kd_nsites = (int)(shdr[i].sh_size / 16);
+        kd_sites = calloc((size_t)kd_nsites + 1, sizeof(*kd_sites));
+        for (int k = 0; k < kd_nsites; k++, p += 16) {
+            uint64_t fmt;
+            uint16_t level, nargs;
+            uint32_t line;
+            memcpy(&fmt, p, 8);
+            memcpy(&level, p + 8, 2);
+            memcpy(&nargs, p + 10, 2);
+            memcpy(&line, p + 12, 4);
+            kd_sites[k].fmt = elf_str(fmt);
+            if (!kd_sites[k].fmt) kd_sites[k].fmt = "<format not in image>";
+            kd_sites[k].level = level;
+            kd_sites[k].nargs = nargs;
+            kd_sites[k].line = (int)line;
+        }
+        kd_str = elf_str;
+        return 0;
+    }
+    fprintf(stderr, "klogdump: %s has no __klog_sites section\n", path);
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: klogdump kernel.elf [serial.log]\n");
+        return 1;
+    }
+    if (load_sites(argv[1]) < 0) return 1;
+    FILE *in = stdin;
+    if (argc > 2 && !(in = fopen(argv[2], "r"))) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    char line[1024], out[1024];
+    long records = 0;
+    while (fgets(line, sizeof(line), in)) {
+        char *p = strstr(line, "[klog] ");
+        if (!p) {
+            fputs(line, stdout);
+            continue;
+        }
+        int r = kd_decode(p + 7, out, sizeof(out));
+        if (r < 0) {
+            fputs(line, stdout);
+            continue;
+        }
+        if (r == 0) continue;
+        /* whatever shared the line before the record (a torn write) */
+        fwrite(line, 1, (size_t)(p - line), stdout);
+        puts(out);
+        records++;
+    }
+
+    fprintf(stderr, "klogdump: %ld records, %d sites, %" PRIu64 " lost in the kernel\n",
+            records, kd_nsites, kd_dropped);
+    if (in != stdin) fclose(in);
+    return 0;
+}
+
+#endif /* KLOGDUMP_NO_MAIN */
@@ -0,0 +1,134 @@
+/* tools/schedtrace2json.c
+ * Convert a scheduler trace dump (the "[trace] ..." lines written by
+ * trace_dump_serial, usually inside a captured serial log) into Chrome
+ * trace event JSON, viewable in chrome://tracing or ui.perfetto.dev.
+ *
+ * Each CPU becomes a process row and each task a thread row: the time a
+ * task spends on a CPU between two switch events is drawn as a slice, the
+ * other events (wakeup, block, migrate, fork, exit) as instant markers.
+ *
+ * Build: gcc -O2 -o schedtrace2json tools/schedtrace2json.c
+ * Usage: schedtrace2json [serial.log] > trace.json   (stdin if no file)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#define TRACE_SWITCH   1
+#define TRACE_WAKEUP   2
+#define TRACE_BLOCK    3
+#define TRACE_MIGRATE  4
+#define TRACE_FORK     5
+#define TRACE_EXIT     6
+
+#define MAX_CPUS 8
+
+static const char *type_names[] = {
+    "?", "switch", "wakeup", "block", "migrate", "fork", "exit"
+};
+
+static uint64_t tsc_hz = 0;
+static uint64_t tsc_base = 0;
+static int have_base = 0;
+static int first = 1;
+
+/* Task currently on each CPU and since when (from the last switch) */
+static uint32_t on_cpu[MAX_CPUS];
+static uint64_t since[MAX_CPUS];
+static int known[MAX_CPUS];
+
+static double to_us(uint64_t tsc) {
+    return (double)(tsc - tsc_base) * 1e6 / (double)tsc_hz;
+}
+
+static void sep(void) {
+    if (!first) fputs(",\n", stdout);
+    first = 0;
+}
+
+static void slice(int cpu, uint32_t pid, uint64_t start, uint64_t end) {
+    char name[32];
+    if (pid) snprintf(name, sizeof(name), "task %u", pid);
+    else snprintf(name, sizeof(name), "idle");
+    sep();
+    printf("  {\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,"
+           "\"ts\":%.3f,\"dur\":%.3f}",
+           name, cpu, pid, to_us(start), to_us(end) - to_us(start));
+}
+
+static void instant(int cpu, uint32_t pid, int type, uint64_t tsc, uint32_t arg) {
+    sep();
+    printf("  {\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%u,"
+           "\"ts\":%.3f,\"args\":{\"arg\":%u}}",
+           type_names[type], cpu, pid, to_us(tsc), arg);
+}
+
+static void event(uint64_t tsc, int cpu, int type, uint32_t pid, uint32_t arg) {
+    if (cpu < 0 || cpu >= MAX_CPUS || type < TRACE_SWITCH || type > TRACE_EXIT)
+        return;
+    if (!have_base) { tsc_base = tsc; have_base = 1; }
+
+    if (type != TRACE_SWITCH) {
+        instant(cpu, pid, type, tsc, arg);
+        return;
+    }
+    /* The first switch seen on a CPU only tells us who runs next */
+    if (known[cpu])
+        slice(cpu, on_cpu[cpu], since[cpu], tsc);
+    on_cpu[cpu] = arg;
+    since[cpu] = tsc;
+    known[cpu] = 1;
+}
+
+int main(int argc, char **argv) {
+    FILE *in = stdin;
+    if (argc > 1 && !(in = fopen(argv[1], "r"))) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    char line[256];
+    uint64_t last = 0, dropped = 0;
+    long nevents = 0;
+    puts("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    while (fgets(line, sizeof(line), in)) {
+        char *p = strstr(line, "[trace] ");
+        if (!p) continue;
+        p += 8;
+
+        uint64_t tsc;
+        int cpu, type;
+        uint32_t pid, arg;
+        if (sscanf(p, "begin tsc_hz=%" SCNu64 " dropped=%" SCNu64, &tsc_hz, &dropped) == 2)
+            continue;
+        if (!strncmp(p, "end", 3)) continue;
+        if (sscanf(p, "%" SCNu64 " %d %d %u %u", &tsc, &cpu, &type, &pid, &arg) != 5)
+            continue;
+        if (!tsc_hz) {
+            fprintf(stderr, "schedtrace2json: event before the begin line\n");
+            return 1;
+        }
+        event(tsc, cpu, type, pid, arg);
+        if (tsc > last) last = tsc;
+        nevents++;
+    }
+
+    /* Close the slices still running at the end of the dump */
+    for (int c = 0; c < MAX_CPUS; c++)
+        if (known[c]) slice(c, on_cpu[c], since[c], last);
+
+    for (int c = 0; c < MAX_CPUS; c++) {
+        if (!known[c]) continue;
+        sep();
+        printf("  {\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+               "\"args\":{\"name\":\"cpu%d\"}}", c, c);
+    }
+    puts("\n]}");
+
+    fprintf(stderr, "schedtrace2json: %ld events, %" PRIu64 " dropped in the kernel\n",
+            nevents, dropped);
+    if (in != stdin) fclose(in);
+    return 0;
+}
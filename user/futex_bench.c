@@ -0,0 +1,174 @@
+/* user/futex_bench.c - futex-based mutex and condition variable under
+   contention. For 1, 2, 4, 8 and 16 threads: every thread increments a
+   shared counter ITERS times under one mutex, then the threads pass a
+   token round-robin through a condition variable. Logs cycles per
+   operation and how many SYS_FUTEX calls the kernel saw (zero for the
+   single thread), and exits 0 if every count came out right. */
+
+#include "libc/syscall.h"
+#include "libc/futex.h"
+#include "libc/thread.h"
+#include "../kernel/syscall.h"
+
+#define MAX_THREADS 16
+#define STACK_SIZE  16384
+#define ITERS       20000
+#define HANDOFFS    2000
+
+static char stacks[MAX_THREADS][STACK_SIZE] __attribute__((aligned(16)));
+
+static mutex_t lock = MUTEX_INIT;
+static cond_t turn_cond = COND_INIT;
+static unsigned long counter;
+static unsigned int turn;
+static int nthreads;
+
+/* start gate and completion count, both slept on with FUTEX_WAIT */
+static volatile unsigned int go;
+static volatile unsigned int done;
+
+static inline unsigned long rdtsc(void) {
+    unsigned int lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((unsigned long)hi << 32) | lo;
+}
+
+static char *put_dec(char *p, unsigned long v) {
+    char tmp[24];
+    int n = 0;
+    do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+static char *put_str(char *p, const char *s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+static void log_run(const char *phase, int threads, unsigned long cycles, unsigned long futex_calls) {
+    char line[128];
+    char *p = put_str(line, "futex_bench ");
+    p = put_str(p, phase);
+    p = put_str(p, " threads=");
+    p = put_dec(p, (unsigned long)threads);
+    p = put_str(p, " cycles_per_op=");
+    p = put_dec(p, cycles);
+    p = put_str(p, " futex_calls=");
+    p = put_dec(p, futex_calls);
+    *p = 0;
+    user_syscall(SYS_LOG, (long)line, 0, 0);
+}
+
+/* SYS_FUTEX calls so far, from the kernel's per-syscall counters */
+static unsigned long futex_calls(void) {
+    static syscall_stat_t stats[NR_SYSCALLS];
+    long n = user_syscall(SYS_SYSCALL_STATS, (long)stats, NR_SYSCALLS, 0);
+    for (long i = 0; i < n; i++)
+        if (stats[i].nr == SYS_FUTEX) return stats[i].count;
+    return 0;
+}
+
+static void wait_for_go(void) {
+    while (!__atomic_load_n(&go, __ATOMIC_ACQUIRE))
+        futex_wait(&go, 0, 0);
+}
+
+static void finish(void) {
+    __atomic_fetch_add(&done, 1, __ATOMIC_RELEASE);
+    futex_wake(&done, 1);
+}
+
+static int mutex_worker(void *arg) {
+    (void)arg;
+    wait_for_go();
+    for (int i = 0; i < ITERS; i++) {
+        mutex_lock(&lock);
+        counter++;
+        for (volatile int w = 0; w < 20; w++) ;   /* critical section */
+        mutex_unlock(&lock);
+        for (volatile int w = 0; w < 20; w++) ;
+    }
+    finish();
+    return 0;
+}
+
+static int handoff_worker(void *arg) {
+    unsigned int me = (unsigned int)(unsigned long)arg;
+    wait_for_go();
+    mutex_lock(&lock);
+    for (;;) {
+        while (turn < HANDOFFS && turn % (unsigned int)nthreads != me)
+            cond_wait(&turn_cond, &lock);
+        if (turn >= HANDOFFS) break;
+        turn++;
+        counter++;
+        cond_broadcast(&turn_cond);
+    }
+    mutex_unlock(&lock);
+    finish();
+    return 0;
+}
+
+/* Start n threads of fn behind the gate, open it and time until all are
+   done. Returns cycles per op and the SYS_FUTEX calls it took. */
+static unsigned long run(thread_fn_t fn, int n, unsigned long ops, unsigned long *calls) {
+    long tids[MAX_THREADS];
+    nthreads = n;
+    counter = 0;
+    turn = 0;
+    go = 0;
+    done = 0;
+    for (int i = 0; i < n; i++)
+        tids[i] = thread_create(fn, (void *)(unsigned long)i, stacks[i], STACK_SIZE);
+
+    unsigned long f0 = futex_calls();
+    unsigned long t0 = rdtsc();
+    __atomic_store_n(&go, 1, __ATOMIC_RELEASE);
+    futex_wake(&go, MAX_THREADS);
+    unsigned long own = 1;
+    unsigned int d;
+    while ((d = __atomic_load_n(&done, __ATOMIC_ACQUIRE)) < (unsigned int)n) {
+        futex_wait(&done, d, 0);
+        own++;
+    }
+    unsigned long cycles = rdtsc() - t0;
+    *calls = futex_calls() - f0 - own;   /* the workers' calls only */
+
+    for (int i = 0; i < n; i++)
+        if (tids[i] > 0) thread_join(tids[i]);
+    return cycles / ops;
+}
+
+void _start(void) {
+    static const int counts[] = { 1, 2, 4, 8, 16 };
+    int bad = 0;
+    unsigned long calls;
+
+    /* uncontended fast path: must not enter the kernel at all */
+    unsigned long f0 = futex_calls();
+    unsigned long t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++) {
+        mutex_lock(&lock);
+        mutex_unlock(&lock);
+    }
+    unsigned long cycles = (rdtsc() - t0) / ITERS;
+    calls = futex_calls() - f0;
+    log_run("uncontended", 1, cycles, calls);
+    if (calls) bad = 1;
+
+    for (unsigned i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        int n = counts[i];
+        cycles = run(mutex_worker, n, (unsigned long)n * ITERS, &calls);
+        log_run("mutex", n, cycles, calls);
+        if (counter != (unsigned long)n * ITERS) bad = 1;
+
+        cycles = run(handoff_worker, n, HANDOFFS, &calls);
+        log_run("condvar_handoff", n, cycles, calls);
+        if (counter != HANDOFFS) bad = 1;
+    }
+
+    user_syscall(SYS_LOG, (long)(bad ? "futex_bench FAILED" : "futex_bench ok"), 0, 0);
+    user_syscall(SYS_EXIT, bad, 0, 0);
+    for (;;) ;
+}
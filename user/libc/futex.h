@@ -0,0 +1,102 @@
+/* user/libc/futex.h - mutex and condition variable on SYS_FUTEX
+ *
+ * Both types are a single 32-bit word changed with atomic instructions;
+ * the kernel is only entered to sleep on a word whose value says the
+ * object is contended, or to wake sleepers (kernel/futex.h). Locking and
+ * unlocking a free mutex, and signalling a condition nobody waits on,
+ * never makes a syscall. Works between threads and between processes
+ * sharing the page.
+ */
+#ifndef USER_FUTEX_H
+#define USER_FUTEX_H
+
+#include "syscall.h"
+
+/* Must match kernel/futex.h */
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+#define FUTEX_EAGAIN    (-11)
+#define FUTEX_ETIMEDOUT (-110)
+#define FUTEX_ENOMEM    (-12)
+
+static inline long futex_wait(volatile unsigned int *uaddr, unsigned int val,
+                              unsigned long timeout_ns) {
+    return user_syscall4(SYS_FUTEX, (long)uaddr, FUTEX_WAIT, val, (long)timeout_ns);
+}
+
+static inline long futex_wake(volatile unsigned int *uaddr, unsigned int n) {
+    return user_syscall4(SYS_FUTEX, (long)uaddr, FUTEX_WAKE, n, 0);
+}
+
+/* Mutex: 0 = free, 1 = locked, 2 = locked and somebody may sleep on it.
+   Only an unlock that finds 2 issues FUTEX_WAKE. */
+typedef struct mutex {
+    volatile unsigned int state;
+} mutex_t;
+
+#define MUTEX_INIT { 0 }
+
+static inline int mutex_trylock(mutex_t *m) {
+    unsigned int c = 0;
+    return __atomic_compare_exchange_n(&m->state, &c, 1, 0,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+/* Slow path: mark the mutex contended, then sleep until an exchange
+   finds it free. Whoever gets it this way leaves it at 2, so its unlock
+   wakes the next sleeper. */
+static inline void mutex_lock_contended(mutex_t *m, unsigned int c) {
+    if (c != 2) c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    while (c != 0) {
+        futex_wait(&m->state, 2, 0);
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    }
+}
+
+static inline void mutex_lock(mutex_t *m) {
+    unsigned int c = 0;
+    if (!__atomic_compare_exchange_n(&m->state, &c, 1, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        mutex_lock_contended(m, c);
+}
+
+static inline void mutex_unlock(mutex_t *m) {
+    if (__atomic_fetch_sub(&m->state, 1, __ATOMIC_RELEASE) != 1) {
+        __atomic_store_n(&m->state, 0, __ATOMIC_RELEASE);
+        futex_wake(&m->state, 1);
+    }
+}
+
+/* Condition variable: waiters sleep on a sequence number that every
+   signal bumps, so a signal between dropping the mutex and sleeping
+   makes FUTEX_WAIT return at once instead of being lost. */
+typedef struct cond {
+    volatile unsigned int seq;
+    volatile unsigned int waiters;
+} cond_t;
+
+#define COND_INIT { 0, 0 }
+
+static inline void cond_wait(cond_t *c, mutex_t *m) {
+    __atomic_fetch_add(&c->waiters, 1, __ATOMIC_SEQ_CST);
+    unsigned int seq = __atomic_load_n(&c->seq, __ATOMIC_SEQ_CST);
+    mutex_unlock(m);
+    futex_wait(&c->seq, seq, 0);
+    /* other waiters may be queued behind us: take the mutex contended */
+    mutex_lock_contended(m, 1);
+    __atomic_fetch_sub(&c->waiters, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline void cond_signal(cond_t *c) {
+    __atomic_fetch_add(&c->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&c->waiters, __ATOMIC_SEQ_CST))
+        futex_wake(&c->seq, 1);
+}
+
+static inline void cond_broadcast(cond_t *c) {
+    __atomic_fetch_add(&c->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&c->waiters, __ATOMIC_SEQ_CST))
+        futex_wake(&c->seq, 0x7FFFFFFF);
+}
+
+#endif /* USER_FUTEX_H */
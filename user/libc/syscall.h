@@ -0,0 +1,61 @@
+/* user/libc/syscall.h - system call stubs for user programs
+ *
+ * Register convention (kernel/syscall.h): number in RDI, arguments in
+ * RSI, RDX, then R10 for the SYSCALL instruction (which overwrites RCX
+ * and R11) or RCX for the int 0x80 compatibility gate, and R8. The
+ * result comes back in RAX. The kernel side is C code, so every
+ * caller-saved register may come back changed.
+ */
+#ifndef USER_SYSCALL_H
+#define USER_SYSCALL_H
+
+/* Syscall numbers must match kernel/syscall.h */
+#define SYS_EXIT   1
+#define SYS_YIELD  2
+#define SYS_LOG    3
+#define SYS_FORK   5
+#define SYS_WAIT   7
+#define SYS_WRITE  9
+#define SYS_OPEN   10
+#define SYS_CLOSE  11
+#define SYS_SLEEP  13
+#define SYS_CLONE  14
+#define SYS_GETPID 22
+#define SYS_SYSCALL_STATS 26
+#define SYS_FUTEX  27
+
+/* Fast path: SYSCALL/SYSRET */
+static inline long user_syscall(long num, long a1, long a2, long a3) {
+    register long r10 asm("r10") = a3;
+    long ret;
+    asm volatile ("syscall"
+                  : "=a"(ret), "+D"(num), "+S"(a1), "+d"(a2), "+r"(r10)
+                  :
+                  : "rcx", "r8", "r9", "r11", "memory");
+    return ret;
+}
+
+/* Fast path with a fourth argument in R8 */
+static inline long user_syscall4(long num, long a1, long a2, long a3, long a4) {
+    register long r10 asm("r10") = a3;
+    register long r8 asm("r8") = a4;
+    long ret;
+    asm volatile ("syscall"
+                  : "=a"(ret), "+D"(num), "+S"(a1), "+d"(a2), "+r"(r10), "+r"(r8)
+                  :
+                  : "rcx", "r9", "r11", "memory");
+    return ret;
+}
+
+/* Compatibility path: int 0x80 / iretq */
+static inline long user_syscall_int80(long num, long a1, long a2, long a3) {
+    register long rcx asm("rcx") = a3;
+    long ret;
+    asm volatile ("int $0x80"
+                  : "=a"(ret), "+D"(num), "+S"(a1), "+d"(a2), "+c"(rcx)
+                  :
+                  : "r8", "r9", "r10", "r11", "memory");
+    return ret;
+}
+
+#endif /* USER_SYSCALL_H */
@@ -0,0 +1,42 @@
+/* user/libc/thread.h - threads on SYS_CLONE(CLONE_VM)
+ *
+ * The kernel starts a clone at its entry point with RSP = stack_top and
+ * no arguments. thread_create stores the function and its argument at
+ * the top of the new stack for a small trampoline, which calls it and
+ * passes the return value to SYS_EXIT. Join with thread_join (SYS_WAIT),
+ * which also releases the thread.
+ */
+#ifndef USER_THREAD_H
+#define USER_THREAD_H
+
+#include "syscall.h"
+
+#define CLONE_VM 0x00000100
+
+typedef int (*thread_fn_t)(void *arg);
+
+__attribute__((naked, used)) static void thread_trampoline(void) {
+    asm volatile ("movq (%rsp), %rax\n\t"
+                  "movq 8(%rsp), %rdi\n\t"
+                  "call *%rax\n\t"
+                  "movl %eax, %esi\n\t"
+                  "movl $1, %edi\n\t"          /* SYS_EXIT */
+                  "syscall\n\t"
+                  "ud2");
+}
+
+/* Start fn(arg) on the stack [stack, stack + size). Returns the thread
+   id, or -1. */
+static inline long thread_create(thread_fn_t fn, void *arg, void *stack, unsigned long size) {
+    unsigned long *top = (unsigned long *)(((unsigned long)stack + size) & ~0xFUL) - 2;
+    top[0] = (unsigned long)fn;
+    top[1] = (unsigned long)arg;
+    return user_syscall4(SYS_CLONE, CLONE_VM, (long)thread_trampoline, (long)top, 0);
+}
+
+/* Wait for the thread to exit; returns fn's return value */
+static inline int thread_join(long tid) {
+    return (int)user_syscall(SYS_WAIT, tid, 0, 0);
+}
+
+#endif /* USER_THREAD_H */
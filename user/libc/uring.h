@@ -0,0 +1,80 @@
+/* user/libc/uring.h - user side of the batched syscall rings
+ *
+ * The shared layout and opcodes come from kernel/uring.h. Typical use:
+ *     uring_t r;
+ *     uring_init(&r, 64, 0);
+ *     uring_sqe_t *e = uring_get_sqe(&r);      (fill it in)
+ *     uring_submit(&r);                        (one syscall per batch)
+ *     while (uring_peek_cqe(&r, &c)) ...       (then uring_cqe_seen)
+ */
+#ifndef USER_URING_H
+#define USER_URING_H
+
+#include "syscall.h"
+#include "../../kernel/uring.h"
+
+#define SYS_URING_SETUP 23
+#define SYS_URING_ENTER 24
+
+typedef struct {
+    uring_shm_t *shm;
+    uring_sqe_t *sqes;
+    uring_cqe_t *cqes;
+    unsigned sq_mask, cq_mask;
+    unsigned sq_tail;          /* local tail, published by uring_submit */
+    int sqpoll;
+} uring_t;
+
+static inline int uring_init(uring_t *r, unsigned entries, unsigned flags) {
+    long base = user_syscall(SYS_URING_SETUP, entries, flags, 0);
+    if (base <= 0) return -1;
+    r->shm = (uring_shm_t *)base;
+    r->sqes = (uring_sqe_t *)(base + r->shm->sqes_off);
+    r->cqes = (uring_cqe_t *)(base + r->shm->cqes_off);
+    r->sq_mask = r->shm->sq_entries - 1;
+    r->cq_mask = r->shm->cq_entries - 1;
+    r->sq_tail = r->shm->sq_tail;
+    r->sqpoll = (flags & URING_SETUP_SQPOLL) != 0;
+    return 0;
+}
+
+/* Next free SQ slot, or 0 if the SQ is full */
+static inline uring_sqe_t *uring_get_sqe(uring_t *r) {
+    unsigned head = __atomic_load_n(&r->shm->sq_head, __ATOMIC_ACQUIRE);
+    if (r->sq_tail - head > r->sq_mask) return 0;
+    return &r->sqes[r->sq_tail++ & r->sq_mask];
+}
+
+/* Publish the queued entries. Without SQPOLL this is the one syscall per
+   batch; with SQPOLL it only enters the kernel to wake a sleeping poller.
+   Returns entries consumed by this call (always 0 with SQPOLL). */
+static inline long uring_submit(uring_t *r) {
+    __atomic_store_n(&r->shm->sq_tail, r->sq_tail, __ATOMIC_SEQ_CST);
+    if (r->sqpoll) {
+        if (__atomic_load_n(&r->shm->sq_flags, __ATOMIC_SEQ_CST) & URING_SQ_NEED_WAKEUP)
+            user_syscall(SYS_URING_ENTER, 0, 0, URING_ENTER_SQ_WAKEUP);
+        return 0;
+    }
+    /* everything not consumed yet, including leftovers of a full CQ */
+    unsigned head = __atomic_load_n(&r->shm->sq_head, __ATOMIC_ACQUIRE);
+    return user_syscall(SYS_URING_ENTER, r->sq_tail - head, 0, 0);
+}
+
+/* Tear the ring down (the kernel also does it at exit) */
+static inline void uring_exit(uring_t *r) {
+    user_syscall(SYS_URING_SETUP, 0, 0, 0);
+    r->shm = 0;
+}
+
+static inline int uring_peek_cqe(uring_t *r, uring_cqe_t *out) {
+    unsigned head = r->shm->cq_head;
+    if (head == __atomic_load_n(&r->shm->cq_tail, __ATOMIC_ACQUIRE)) return 0;
+    *out = r->cqes[head & r->cq_mask];
+    return 1;
+}
+
+static inline void uring_cqe_seen(uring_t *r) {
+    __atomic_store_n(&r->shm->cq_head, r->shm->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+#endif /* USER_URING_H */
@@ -0,0 +1,50 @@
+/* user/libc/vdso.h - clock and CPU number without entering the kernel
+ *
+ * The kernel maps its vDSO at VDSO_BASE in every process: a data page
+ * (layout in kernel/vdso.h) whose entry-point offsets locate the code
+ * that follows it. These wrappers call through those offsets and fall
+ * back to SYS_CLOCK_GETTIME while the clock is not calibrated.
+ */
+#ifndef USER_VDSO_H
+#define USER_VDSO_H
+
+#include "syscall.h"
+#include "../../kernel/vdso.h"
+
+#define SYS_CLOCK_GETTIME 25
+
+static inline const vdso_data_t *vdso_data(void) {
+    return (const vdso_data_t *)VDSO_BASE;
+}
+
+static inline int clock_gettime(int clk, vdso_timespec_t *ts) {
+    const vdso_data_t *d = vdso_data();
+    if (d->clock_gettime_off) {
+        int (*fn)(int, vdso_timespec_t *) =
+            (int (*)(int, vdso_timespec_t *))(VDSO_BASE + d->clock_gettime_off);
+        if (fn(clk, ts) == 0) return 0;
+    }
+    return (int)user_syscall(SYS_CLOCK_GETTIME, clk, (long)ts, 0);
+}
+
+/* Same clock as a single nanosecond count */
+static inline unsigned long clock_ns(int clk) {
+    const vdso_data_t *d = vdso_data();
+    if (d->time_ns_off) {
+        unsigned long (*fn)(int) = (unsigned long (*)(int))(VDSO_BASE + d->time_ns_off);
+        unsigned long ns = fn(clk);
+        if (ns) return ns;
+    }
+    vdso_timespec_t ts;
+    if (user_syscall(SYS_CLOCK_GETTIME, clk, (long)&ts, 0) < 0) return 0;
+    return (unsigned long)ts.tv_sec * 1000000000UL + (unsigned long)ts.tv_nsec;
+}
+
+static inline int getcpu(unsigned *cpu, unsigned *node) {
+    const vdso_data_t *d = vdso_data();
+    int (*fn)(uint32_t *, uint32_t *) =
+        (int (*)(uint32_t *, uint32_t *))(VDSO_BASE + d->getcpu_off);
+    return fn(cpu, node);
+}
+
+#endif /* USER_VDSO_H */
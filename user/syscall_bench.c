@@ -0,0 +1,80 @@
+/* user/syscall_bench.c - null-syscall round trip from ring 3 through both
+   entry paths (SYSCALL/SYSRET and int 0x80/iretq). Logs TSC cycles per
+   call and hands both numbers back in the exit code (syscall in the low
+   16 bits, int 0x80 above) for kernel/syscall_bench.c to convert to ns.
+   Also logs the kernel's own view of those calls from SYS_SYSCALL_STATS. */
+
+#include "libc/syscall.h"
+#include "../kernel/syscall.h"
+
+#define ITERS 100000
+
+static inline unsigned long rdtsc(void) {
+    unsigned int lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((unsigned long)hi << 32) | lo;
+}
+
+static char *put_dec(char *p, unsigned long v) {
+    char tmp[24];
+    int n = 0;
+    do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+static char *put_str(char *p, const char *s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+static unsigned long report(const char *name, unsigned long cycles) {
+    char line[96];
+    char *p = put_str(line, "syscall_bench ");
+    p = put_str(p, name);
+    p = put_str(p, " cycles=");
+    p = put_dec(p, cycles / ITERS);
+    *p = 0;
+    user_syscall(SYS_LOG, (long)line, 0, 0);
+    cycles /= ITERS;
+    return cycles < 0xFFFF ? cycles : 0xFFFF;
+}
+
+void _start(void) {
+    /* warm up both paths */
+    for (int i = 0; i < 1000; i++) {
+        user_syscall(SYS_GETPID, 0, 0, 0);
+        user_syscall_int80(SYS_GETPID, 0, 0, 0);
+    }
+
+    unsigned long t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++)
+        user_syscall(SYS_GETPID, 0, 0, 0);
+    unsigned long fast = report("syscall", rdtsc() - t0);
+
+    t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++)
+        user_syscall_int80(SYS_GETPID, 0, 0, 0);
+    unsigned long compat = report("int80", rdtsc() - t0);
+
+    /* in-kernel handler time for getpid: count and median log2 bucket */
+    static syscall_stat_t stats[NR_SYSCALLS];
+    long n = user_syscall(SYS_SYSCALL_STATS, (long)stats, NR_SYSCALLS, 0);
+    for (long i = 0; i < n; i++) {
+        if (stats[i].nr != SYS_GETPID) continue;
+        unsigned long seen = 0;
+        int b = 0;
+        while (b < SYSCALL_HIST_BUCKETS - 1 && (seen += stats[i].hist[b]) * 2 < stats[i].count)
+            b++;
+        char line[96];
+        char *p = put_str(line, "syscall_bench kernel getpid calls=");
+        p = put_dec(p, stats[i].count);
+        p = put_str(p, " median_cycles<");
+        p = put_dec(p, 2UL << b);
+        *p = 0;
+        user_syscall(SYS_LOG, (long)line, 0, 0);
+    }
+
+    user_syscall(SYS_EXIT, (long)(fast | compat << 16), 0, 0);
+    for (;;) ;
+}
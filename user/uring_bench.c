@@ -0,0 +1,117 @@
+/* user/uring_bench.c - 1-byte writes to an open file: one syscall each,
+   batched through the ring with one enter per batch, and through an
+   SQPOLL ring. Reports ops/sec and syscalls made per mode via SYS_LOG. */
+
+#include "libc/syscall.h"
+#include "libc/uring.h"
+
+#define OPS   20000
+#define BATCH 32
+
+static unsigned long tsc_hz;
+static char byte = 'x';
+
+static inline unsigned long rdtsc(void) {
+    unsigned int lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((unsigned long)hi << 32) | lo;
+}
+
+static char *put_dec(char *p, unsigned long v) {
+    char tmp[24];
+    int n = 0;
+    do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+static char *put_str(char *p, const char *s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+static void report(const char *name, unsigned long cycles, unsigned long syscalls, long errors) {
+    char line[128];
+    char *p = put_str(line, "[uring_bench] ");
+    p = put_str(p, name);
+    p = put_str(p, ": ops_per_sec=");
+    p = put_dec(p, tsc_hz / (cycles / OPS ? cycles / OPS : 1));
+    p = put_str(p, " cycles_per_op=");
+    p = put_dec(p, cycles / OPS);
+    p = put_str(p, " syscalls=");
+    p = put_dec(p, syscalls);
+    if (errors) {
+        p = put_str(p, " errors=");
+        p = put_dec(p, (unsigned long)errors);
+    }
+    *p = 0;
+    user_syscall(SYS_LOG, (long)line, 0, 0);
+}
+
+/* Queue OPS writes through r, waiting for completions with reap() */
+static void ring_run(const char *name, uring_t *r, int fd) {
+    unsigned long syscalls = 0;
+    long errors = 0;
+    int queued = 0, done = 0;
+    uring_cqe_t c;
+
+    unsigned long t0 = rdtsc();
+    while (done < OPS) {
+        int q = 0;
+        uring_sqe_t *e;
+        while (q < BATCH && queued < OPS && (e = uring_get_sqe(r))) {
+            e->opcode = URING_OP_WRITE;
+            e->fd = fd;
+            e->addr = (unsigned long)&byte;
+            e->len = 1;
+            e->user_data = (unsigned long)queued;
+            queued++;
+            q++;
+        }
+        if (!r->sqpoll || (r->shm->sq_flags & URING_SQ_NEED_WAKEUP)) syscalls++;
+        uring_submit(r);
+
+        int got = 0;
+        while (uring_peek_cqe(r, &c)) {
+            if (c.res != 1) errors++;
+            uring_cqe_seen(r);
+            done++;
+            got++;
+        }
+        /* One CPU: the poller only runs if we step aside */
+        if (r->sqpoll && !got && !q) {
+            user_syscall(SYS_YIELD, 0, 0, 0);
+            syscalls++;
+        }
+    }
+    report(name, rdtsc() - t0, syscalls, errors);
+}
+
+void _start(void) {
+    /* TSC frequency from a 50 ms sleep */
+    unsigned long t0 = rdtsc();
+    user_syscall(SYS_SLEEP, 50000000, 0, 0);
+    tsc_hz = (rdtsc() - t0) * 20;
+
+    int fd = (int)user_syscall(SYS_OPEN, (long)"/bench", 0, 0);
+    long errors = 0;
+
+    t0 = rdtsc();
+    for (int i = 0; i < OPS; i++)
+        if (user_syscall(SYS_WRITE, fd, (long)&byte, 1) != 1) errors++;
+    report("syscall", rdtsc() - t0, OPS, errors);
+
+    uring_t r;
+    if (uring_init(&r, 256, 0) == 0) {
+        ring_run("ring_enter", &r, fd);
+        uring_exit(&r);
+    }
+    if (uring_init(&r, 256, URING_SETUP_SQPOLL) == 0) {
+        ring_run("ring_sqpoll", &r, fd);
+        uring_exit(&r);
+    }
+
+    user_syscall(SYS_CLOSE, fd, 0, 0);
+    user_syscall(SYS_EXIT, 0, 0, 0);
+    for (;;) ;
+}
@@ -0,0 +1,95 @@
+/* user/vdso_bench.c - clock_gettime through the vDSO against the
+   SYS_CLOCK_GETTIME syscall, plus vDSO getcpu. Checks that the vDSO clock
+   never goes backwards and agrees with the kernel's, logs TSC cycles per
+   call and returns vDSO and syscall cycles in the exit code (vDSO in the
+   low 16 bits, syscall above) for kernel/vdso_bench.c. */
+
+#include "libc/vdso.h"
+
+#define ITERS 100000
+
+static inline unsigned long rdtsc(void) {
+    unsigned int lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((unsigned long)hi << 32) | lo;
+}
+
+static char *put_dec(char *p, unsigned long v) {
+    char tmp[24];
+    int n = 0;
+    do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+static char *put_str(char *p, const char *s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+static void log_kv(const char *name, const char *key, unsigned long v) {
+    char line[96];
+    char *p = put_str(line, "vdso_bench ");
+    p = put_str(p, name);
+    p = put_str(p, " ");
+    p = put_str(p, key);
+    p = put_str(p, "=");
+    p = put_dec(p, v);
+    *p = 0;
+    user_syscall(SYS_LOG, (long)line, 0, 0);
+}
+
+static unsigned long report(const char *name, unsigned long cycles) {
+    cycles /= ITERS;
+    log_kv(name, "cycles", cycles);
+    return cycles < 0xFFFF ? cycles : 0xFFFF;
+}
+
+static unsigned long ts_ns(const vdso_timespec_t *ts) {
+    return (unsigned long)ts->tv_sec * 1000000000UL + (unsigned long)ts->tv_nsec;
+}
+
+void _start(void) {
+    vdso_timespec_t ts;
+
+    /* monotonicity and agreement with the kernel clock */
+    unsigned long prev = 0, backwards = 0, max_skew = 0;
+    for (int i = 0; i < 10000; i++) {
+        unsigned long a = clock_ns(CLOCK_MONOTONIC);
+        user_syscall(SYS_CLOCK_GETTIME, CLOCK_MONOTONIC, (long)&ts, 0);
+        unsigned long k = ts_ns(&ts);
+        unsigned long b = clock_ns(CLOCK_MONOTONIC);
+        if (a < prev || b < a) backwards++;
+        /* the kernel read happened between a and b */
+        if (k < a && a - k > max_skew) max_skew = a - k;
+        if (k > b && k - b > max_skew) max_skew = k - b;
+        prev = b;
+    }
+    log_kv("check", "backwards", backwards);
+    log_kv("check", "max_skew_ns", max_skew);
+
+    for (int i = 0; i < 1000; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        user_syscall(SYS_CLOCK_GETTIME, CLOCK_MONOTONIC, (long)&ts, 0);
+    }
+
+    unsigned long t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    unsigned long vdso = report("vdso_clock_gettime", rdtsc() - t0);
+
+    t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++)
+        user_syscall(SYS_CLOCK_GETTIME, CLOCK_MONOTONIC, (long)&ts, 0);
+    unsigned long sys = report("syscall_clock_gettime", rdtsc() - t0);
+
+    unsigned cpu = 0, node = 0;
+    t0 = rdtsc();
+    for (int i = 0; i < ITERS; i++)
+        getcpu(&cpu, &node);
+    report("vdso_getcpu", rdtsc() - t0);
+    log_kv("vdso_getcpu", "cpu", cpu);
+
+    user_syscall(SYS_EXIT, (long)(vdso | sys << 16), 0, 0);
+    for (;;) ;
+}